@@ -0,0 +1,60 @@
+# Copyright (c) 2012-2023 by the GalSim developers team on GitHub
+# https://github.com/GalSim-developers
+#
+# This file is part of GalSim: The modular galaxy image simulation toolkit.
+# https://github.com/GalSim-developers/GalSim
+#
+# GalSim is free software: redistribution and use in source and binary forms,
+# with or without modification, are permitted provided that the following
+# conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions, and the disclaimer given in the accompanying LICENSE
+#    file.
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions, and the disclaimer given in the documentation
+#    and/or other materials provided with the distribution.
+#
+
+"""Time the per-Fourier-mode least-squares solve used to construct a ChromaticRealGalaxy.
+
+This calls _galsim.ComputeCRGCoefficients directly on random inputs with the same shapes
+that ChromaticRealGalaxy uses for a typical COSMOS postage stamp: two HST bands
+(F606W and F814W), one to three SEDs, and k grids of a few hundred pixels on a side.
+
+Set OMP_NUM_THREADS to see how it scales with the number of threads.
+"""
+
+import time
+import numpy as np
+
+import galsim
+from galsim import _galsim
+
+n_iter = 5
+
+def time_crg(nsed, nband, nk):
+    rng = np.random.default_rng(1234)
+    kimgs = rng.normal(size=(nband, nk, nk)) + 1j * rng.normal(size=(nband, nk, nk))
+    psf = rng.normal(size=(nsed, nband, nk, nk)) + 1j * rng.normal(size=(nsed, nband, nk, nk))
+    w = 1. + np.abs(rng.normal(size=(nband, nk, nk)))
+    coef = np.zeros((nk, nk, nsed), dtype=np.complex128)
+    Sigma = np.empty((nk, nk, nsed, nsed), dtype=np.complex128)
+
+    _coef = coef.__array_interface__['data'][0]
+    _Sigma = Sigma.__array_interface__['data'][0]
+    _w = w.__array_interface__['data'][0]
+    _kimgs = kimgs.__array_interface__['data'][0]
+    _psf = psf.__array_interface__['data'][0]
+
+    t0 = time.time()
+    for i in range(n_iter):
+        _galsim.ComputeCRGCoefficients(_coef, _Sigma, _w, _kimgs, _psf, nsed, nband, nk, nk)
+    t1 = time.time()
+    print('nsed = %d, nband = %d, nk = %4d: time per call = %.4f s'%(
+          nsed, nband, nk, (t1-t0)/n_iter))
+
+if __name__ == '__main__':
+    for nk in [128, 256, 512]:
+        for nsed, nband in [(1,2), (2,2), (2,3), (3,3), (3,4)]:
+            time_crg(nsed, nband, nk)
@@ -16,7 +16,86 @@
 #    and/or other materials provided with the distribution.
 #
 
-from ._galsim import j0, j1, jv, kv, yv, iv, j0_root, jv_root
+import numpy as np
+
+from . import _galsim
+from ._galsim import j0_root, jv_root
+
+def _call_many(fn, x, *args):
+    # Call one of the C++ array functions on a numpy array x of any shape.
+    x = np.asarray(x, dtype=float)
+    xx = np.ascontiguousarray(x.ravel())
+    y = np.empty_like(xx)
+    _x = xx.__array_interface__['data'][0]
+    _y = y.__array_interface__['data'][0]
+    fn(*args, _x, _y, len(xx))
+    return y.reshape(x.shape)
+
+def _call_nu(scalar_fn, many_fn, v, x):
+    if np.ndim(v) == 0:
+        if np.ndim(x) == 0:
+            return scalar_fn(v, x)
+        else:
+            return _call_many(many_fn, x, float(v))
+    else:
+        # The C++ array functions take a single value of nu, so do each distinct value
+        # of v separately.
+        v, x = np.broadcast_arrays(np.asarray(v, dtype=float), np.asarray(x, dtype=float))
+        y = np.empty(v.shape)
+        for vi in np.unique(v):
+            use = (v == vi)
+            y[use] = _call_many(many_fn, x[use], float(vi))
+        return y
+
+def j0(x):
+    """The Bessel function of the first kind of order 0, equivalent to scipy.special.j0.
+
+    x may be either a scalar or a numpy array.
+    """
+    if np.ndim(x) == 0:
+        return _galsim.j0(x)
+    else:
+        return _call_many(_galsim.j0Many, x)
+
+def j1(x):
+    """The Bessel function of the first kind of order 1, equivalent to scipy.special.j1.
+
+    x may be either a scalar or a numpy array.
+    """
+    if np.ndim(x) == 0:
+        return _galsim.j1(x)
+    else:
+        return _call_many(_galsim.j1Many, x)
+
+def jv(v, x):
+    """The Bessel function of the first kind of order v, equivalent to scipy.special.jv.
+
+    v and x may be either scalars or numpy arrays.
+    """
+    return _call_nu(_galsim.jv, _galsim.jvMany, v, x)
+
+def yv(v, x):
+    """The Bessel function of the second kind of order v, equivalent to scipy.special.yv.
+
+    v and x may be either scalars or numpy arrays.
+    """
+    return _call_nu(_galsim.yv, _galsim.yvMany, v, x)
+
+def iv(v, x):
+    """The modified Bessel function of the first kind of order v, equivalent to
+    scipy.special.iv.
+
+    v and x may be either scalars or numpy arrays.
+    """
+    return _call_nu(_galsim.iv, _galsim.ivMany, v, x)
+
+def kv(v, x):
+    """The modified Bessel function of the second kind of order v, equivalent to
+    scipy.special.kv.
+
+    v and x may be either scalars or numpy arrays.
+    """
+    return _call_nu(_galsim.kv, _galsim.kvMany, v, x)
 
 # Alias the "n" names, which don't get any advantage from being implemented differently,
 # so we only have the generic nu implementation.  But to match scipy.special, we also
@@ -28,4 +107,11 @@ yn = yv
 # These aren't Bessel related, but they are similarly useful math functions that we have
 # implemented in C++.  Exposing them primarily helps for testing that they give essentially
 # equivalent answers as scipy.special.
-from ._galsim import gammainc, sinc, si, ci
+from ._galsim import sinc, si, ci
+
+def gammainc(a, x):
+    """The regularized lower incomplete gamma function, equivalent to scipy.special.gammainc.
+
+    a and x may be either scalars or numpy arrays.
+    """
+    return _call_nu(_galsim.gammainc, _galsim.gammaincMany, a, x)
@@ -887,6 +887,8 @@ class GSFitsWCS(CelestialWCS):
         self._color = None
         self._tag = None # Write something useful here (see below). This is just used for the str.
         self._doiter = _doiter
+        self._ab_table = None  # Optional tables of the inverse distortions.
+        self._pv_table = None  # See withInverseTable.
 
         # If _data is given, copy the data and we're done.
         if _data is not None:
@@ -1339,13 +1341,14 @@ class GSFitsWCS(CelestialWCS):
             assert x.shape == y.shape
             return ra, dec
 
-    def _invert_ab(self, u, v, ab, abp=None):
+    def _invert_ab(self, u, v, ab, abp=None, table=None):
         # This is used both for inverting (u,v) = PV (u',v')
         # and for inverting (x,y) = AB (x',y')
         # Here (and in C++) the notation is (u,v) = AB(x,y), even though both (u,v) and (x,y)
         # in this context are either in CCD coordinates (normally called x,y) or tangent plane
         # coordinates (normally called u,v).
         # abp is an optional set of coefficients to make a good guess for x,y
+        # table is an optional table of the inverse made by _make_inverse_table.
 
         uu = np.ascontiguousarray(u)  # Don't overwrite the given u,v, since we need it at the end
         vv = np.ascontiguousarray(v)  # to check it we were provided scalars or arrays.
@@ -1363,7 +1366,14 @@ class GSFitsWCS(CelestialWCS):
         _ab = ab.__array_interface__['data'][0]
         _abp = 0 if abp is None else abp.__array_interface__['data'][0]
         with convert_cpp_errors():
-            _galsim.InvertAB(nx, nab, _uu, _vv, _ab, _x, _y, self._doiter, nabp, _abp)
+            if table is not None and self._doiter:
+                nu, nv, u0, v0, du, dv, xgrid, ygrid = table
+                _xgrid = xgrid.__array_interface__['data'][0]
+                _ygrid = ygrid.__array_interface__['data'][0]
+                _galsim.InvertABTable(nx, nab, _uu, _vv, _ab, _x, _y, nabp, _abp,
+                                      nu, nv, u0, v0, du, dv, _xgrid, _ygrid)
+            else:
+                _galsim.InvertAB(nx, nab, _uu, _vv, _ab, _x, _y, self._doiter, nabp, _abp)
 
         # Return the right type for u,v
         try:
@@ -1373,6 +1383,114 @@ class GSFitsWCS(CelestialWCS):
         else:
             return x, y
 
+    def _make_inverse_table(self, u, v, ab, abp=None):
+        # Make a table of the inverse of (u,v) = AB(x,y) covering the range of the given u,v.
+        nabp = abp.shape[1] if abp is not None else 0
+        umin = np.min(u)
+        umax = np.max(u)
+        vmin = np.min(v)
+        vmax = np.max(v)
+        # Pad the range a bit, so points just outside the given region still use the table.
+        upad = 0.05 * (umax-umin)
+        vpad = 0.05 * (vmax-vmin)
+        if upad <= 0. or vpad <= 0.:
+            return None
+        umin -= upad
+        umax += upad
+        vmin -= vpad
+        vmax += vpad
+
+        # Refine the table until a bilinear interpolation followed by a single Newton step
+        # is as accurate as the full iteration.  Check this at the centers of the cells,
+        # where the interpolation error is largest.  InvertABTable checks the residual after
+        # the Newton step for each point and returns the number that needed more iterations.
+        n = 32
+        while n <= 1024:
+            ugrid = np.linspace(umin, umax, n+1)
+            vgrid = np.linspace(vmin, vmax, n+1)
+            du = ugrid[1] - ugrid[0]
+            dv = vgrid[1] - vgrid[0]
+            gu, gv = np.meshgrid(ugrid, vgrid, indexing='ij')
+            xgrid, ygrid = self._invert_ab(gu.ravel(), gv.ravel(), ab, abp)
+            table = (n+1, n+1, umin, vmin, du, dv, xgrid, ygrid)
+
+            cu, cv = np.meshgrid(ugrid[:-1] + du/2., vgrid[:-1] + dv/2., indexing='ij')
+            cu = np.ascontiguousarray(cu.ravel())
+            cv = np.ascontiguousarray(cv.ravel())
+            cx = cu.copy()
+            cy = cv.copy()
+            _cu = cu.__array_interface__['data'][0]
+            _cv = cv.__array_interface__['data'][0]
+            _cx = cx.__array_interface__['data'][0]
+            _cy = cy.__array_interface__['data'][0]
+            _ab = ab.__array_interface__['data'][0]
+            _abp = 0 if abp is None else abp.__array_interface__['data'][0]
+            _xgrid = xgrid.__array_interface__['data'][0]
+            _ygrid = ygrid.__array_interface__['data'][0]
+            with convert_cpp_errors():
+                nbad = _galsim.InvertABTable(len(cu), ab.shape[1], _cu, _cv, _ab, _cx, _cy,
+                                             nabp, _abp, n+1, n+1, umin, vmin, du, dv,
+                                             _xgrid, _ygrid)
+            if nbad == 0:
+                return table
+            n *= 2
+        # If we get here, the table would need to be too large to be worthwhile.
+        return None
+
+    def withInverseTable(self, bounds):
+        """Return a copy of this WCS with precomputed tables of the inverse of the distortion
+        polynomials for faster conversions from world coordinates to image coordinates.
+
+        For TPV, SIP and TNX WCS types, `toImage` normally needs to solve for the position by
+        Newton's method, since the distortion polynomials do not have a closed form inverse.
+        If you will be converting many positions that fall within some region of the image,
+        the returned WCS has tables of the inverse over that region.  Then its calls to
+        `toImage` start from an interpolated value in the table, which is normally accurate
+        enough that a single Newton step gives the same accuracy as the full iteration.
+        Any positions for which it isn't, and any positions outside the region, use the
+        regular iteration.
+
+        The tables are checked when they are built to confirm that they usually achieve this
+        accuracy.  If they would need to be too large to do so, no table is used.
+
+        The returned WCS is equal to this one; the tables only affect the speed of `toImage`.
+
+        Parameters:
+            bounds:     The `Bounds` of the region of the image to cover.
+
+        Returns:
+            a new `GSFitsWCS` with the inverse tables.
+        """
+        ret = self.copy()
+        ret._ab_table = None
+        ret._pv_table = None
+        if self.ab is None and self.pv is None:
+            return ret
+
+        # Map the edges of the bounds through each step of the distortion to find the region
+        # that each table needs to cover.
+        t = np.linspace(0., 1., 101)
+        xmin = bounds.xmin
+        xmax = bounds.xmax
+        ymin = bounds.ymin
+        ymax = bounds.ymax
+        x = np.concatenate([xmin + (xmax-xmin) * t, np.full_like(t, xmax),
+                            xmax - (xmax-xmin) * t, np.full_like(t, xmin)])
+        y = np.concatenate([np.full_like(t, ymin), ymin + (ymax-ymin) * t,
+                            np.full_like(t, ymax), ymax - (ymax-ymin) * t])
+        x -= self.crpix[0]
+        y -= self.crpix[1]
+
+        if self.ab is not None:
+            x, y = self._apply_ab(x, y, self.ab)
+            ret._ab_table = self._make_inverse_table(x, y, self.ab, self.abp)
+
+        if self.pv is not None:
+            u, v = self._apply_cd(x.copy(), y.copy())
+            u, v = self._apply_ab(u, v, self.pv)
+            ret._pv_table = self._make_inverse_table(u, v, self.pv)
+
+        return ret
 
     def _xy(self, ra, dec, color=None):
         u, v = self.center.project_rad(ra, dec, projection=self.projection)
@@ -1383,7 +1501,7 @@ class GSFitsWCS(CelestialWCS):
         v *= factor
 
         if self.pv is not None:
-            u, v = self._invert_ab(u, v, self.pv)
+            u, v = self._invert_ab(u, v, self.pv, table=self._pv_table)
 
         if not hasattr(self, 'cdinv'):
             self.cdinv = np.linalg.inv(self.cd)
@@ -1392,7 +1510,7 @@ class GSFitsWCS(CelestialWCS):
         y = self.cdinv[1,0] * u + self.cdinv[1,1] * v
 
         if self.ab is not None:
-            x, y = self._invert_ab(x, y, self.ab, abp=self.abp)
+            x, y = self._invert_ab(x, y, self.ab, abp=self.abp, table=self._ab_table)
 
         x += self.crpix[0]
         y += self.crpix[1]
@@ -755,6 +755,74 @@ class GSObject:
         """
         raise NotImplementedError("%s does not implement kValue"%self.__class__.__name__)
 
+    def _check_value_arrays(self, x, y, xname, yname):
+        # Convert the coordinate arrays for xValueArray or kValueArray into contiguous
+        # float64 arrays of the same shape.
+        x = np.asarray(x)
+        y = np.asarray(y)
+        for name, a in ((xname, x), (yname, y)):
+            if a.dtype.kind not in 'biuf':
+                raise GalSimValueError("%s must be an array of real numbers"%name, a.dtype)
+        if x.shape != y.shape:
+            raise GalSimIncompatibleValuesError(
+                "%s and %s must have the same shape"%(xname, yname),
+                **{xname: x.shape, yname: y.shape})
+        x = np.ascontiguousarray(x, dtype=float)
+        y = np.ascontiguousarray(y, dtype=float)
+        return x, y
+
+    def xValueArray(self, x, y):
+        """Returns the values of the object at many 2D positions in real space.
+
+        This is equivalent to calling ``obj.xValue(x[i], y[i])`` for each element of the arrays,
+        but the whole calculation is done in C++, so it is much faster for large arrays.
+
+        As with `xValue`, this is only available if ``obj.is_analytic_x == True``.  Otherwise a
+        GalSimError will be raised.
+
+        Parameters:
+            x:          A numpy array of x positions (in world coordinates).
+            y:          A numpy array of y positions with the same shape as ``x``.
+
+        Returns:
+            a numpy array with the same shape as ``x`` with the surface brightness at each position.
+        """
+        x, y = self._check_value_arrays(x, y, 'x', 'y')
+        if not self.is_analytic_x:
+            raise GalSimError("%s does not implement xValue"%self.__class__.__name__)
+        val = np.empty(x.shape, dtype=float)
+        _x = x.__array_interface__['data'][0]
+        _y = y.__array_interface__['data'][0]
+        _val = val.__array_interface__['data'][0]
+        with convert_cpp_errors():
+            self._sbp.xValueMany(_x, _y, _val, x.size)
+        return val
+
+    def kValueArray(self, kx, ky):
+        """Returns the values of the object at many 2D positions in k space.
+
+        This is equivalent to calling ``obj.kValue(kx[i], ky[i])`` for each element of the
+        arrays, but the whole calculation is done in C++, so it is much faster for large arrays.
+
+        Parameters:
+            kx:         A numpy array of kx positions.
+            ky:         A numpy array of ky positions with the same shape as ``kx``.
+
+        Returns:
+            a complex numpy array with the same shape as ``kx`` with the fourier amplitude at each
+            position.
+        """
+        kx, ky = self._check_value_arrays(kx, ky, 'kx', 'ky')
+        if not self.is_analytic_k:  # pragma: no cover  (all our classes are analytic in k)
+            raise GalSimError("%s does not implement kValue"%self.__class__.__name__)
+        kval = np.empty(kx.shape, dtype=np.complex128)
+        _kx = kx.__array_interface__['data'][0]
+        _ky = ky.__array_interface__['data'][0]
+        _kval = kval.__array_interface__['data'][0]
+        with convert_cpp_errors():
+            self._sbp.kValueMany(_kx, _ky, _kval, kx.size)
+        return kval
+
     def withGSParams(self, gsparams=None, **kwargs):
         """Create a version of the current object with the given `GSParams`.
 
@@ -1914,18 +1914,19 @@ class Image:
 
         .. warning::
 
-            This function is fairly expensive, both in memory and CPU time, so it should
-            only be called on fairly small images (~100x100 or smaller typically).
-            The memory requirement scales as Npix^2, and the execution time scales as Npix^3.
+            The linear system being solved is separable in x and y, so the work involves
+            factoring an nx x nx and an ny x ny matrix.  The memory requirement scales as
+            nx^2 + ny^2, and the execution time scales as nx^3 + ny^3 + Npix (nx + ny).
+            This is quite fast for typical stamp sizes, but can become slow for very large
+            images.
 
-            However, the expensive part of the calculation is independent of the image values.
-            It only depends on the size of the image and interpolant being used.  So this part
-            of the calculation is cached and reused if possible.  If you make repeated calls
-            to depixelize using the same image size and interpolant, it will be much faster
-            after the first call.
+            The factorizations are independent of the image values.  They only depend on the
+            size of the image and interpolant being used.  So they are cached and reused if
+            possible.  Several sizes are kept at once (up to about 64 MB in total), so
+            alternating between a few stamp sizes doesn't need to recompute them.
 
-            If you need to release the cache (since it can be a non-trivial amount of memory),
-            you may do so using `Image.clear_depixelize_cache`.
+            If you need to release the cache, you may do so using
+            `Image.clear_depixelize_cache`.
 
         Parameters:
             x_interpolant:  The `Interpolant` to use in the `InterpolatedImage` to describe
@@ -1948,7 +1949,7 @@ class Image:
 
     @staticmethod
     def clear_depixelize_cache():
-        """Release the cached solver used by depixelize to make repeated calls more efficient.
+        """Release the cached solvers used by depixelize to make repeated calls more efficient.
         """
         _galsim.ClearDepixelizeCache()
 
@@ -19,7 +19,8 @@
 import numpy as np
 
 from . import _galsim
-from .errors import GalSimError, GalSimValueError, convert_cpp_errors
+from .errors import GalSimError, GalSimValueError, GalSimIncompatibleValuesError
+from .errors import convert_cpp_errors
 from ._utilities import LRU_Cache
 
 
@@ -68,7 +69,7 @@ def int1d(func, min, max, rel_err=1.e-6, abs_err=1.e-12):
     else:
         raise GalSimError(result)
 
-def hankel(func, k, nu=0, rmax=None, rel_err=1.e-6, abs_err=1.e-12):
+def hankel(func, k, nu=0, rmax=None, rel_err=1.e-6, abs_err=1.e-12, dlogr=None):
     r"""Perform an order nu Hankel transform of the given function f(r) at a specific k value.
 
     .. math::
@@ -83,6 +84,12 @@ def hankel(func, k, nu=0, rmax=None, rel_err=1.e-6, abs_err=1.e-12):
         For truncated integrals (and k=0), it uses the same adaptive Gauss-Kronrod-Patterson
         method used for `int1d`.
 
+        If ``dlogr`` is given for a non-truncated integral, f(r) is tabulated at spacing
+        ``dlogr`` in log(r), and the transforms for all the k values are done using cubic
+        interpolation of this single table.  This is much faster when f(r) is expensive and
+        there are many k values, but it adds an interpolation error of order
+        dlogr^4 max(d^4f/dlogr^4).
+
     Parameters:
 
         func:       The function f(r)
@@ -91,6 +98,8 @@ def hankel(func, k, nu=0, rmax=None, rel_err=1.e-6, abs_err=1.e-12):
         rmax:       An optional truncation radius at which to have f(r) drop to 0. [default: None]
         rel_err:    The desired relative accuracy [default: 1.e-6]
         abs_err:    The desired absolute accuracy [default: 1.e-12]
+        dlogr:      An optional spacing in log(r) at which to tabulate f(r), shared by all
+                    the k values. [default: None]
 
     Returns:
 
@@ -99,7 +108,13 @@ def hankel(func, k, nu=0, rmax=None, rel_err=1.e-6, abs_err=1.e-12):
     rel_err = float(rel_err)
     abs_err = float(abs_err)
     nu = float(nu)
+    if dlogr is not None and rmax is not None:
+        raise GalSimIncompatibleValuesError("dlogr is not allowed with rmax",
+                                            dlogr=dlogr, rmax=rmax)
+    if dlogr is not None and dlogr <= 0:
+        raise GalSimValueError("dlogr must be > 0",dlogr)
     rmax = float(rmax) if rmax is not None else 0.
+    dlogr = float(dlogr) if dlogr is not None else 0.
 
     k = np.ascontiguousarray(k, dtype=float)
     res = np.empty_like(k, dtype=float)
@@ -112,7 +127,7 @@ def hankel(func, k, nu=0, rmax=None, rel_err=1.e-6, abs_err=1.e-12):
     _k = k.__array_interface__['data'][0]
     _res = res.__array_interface__['data'][0]
     with convert_cpp_errors():
-        _galsim.PyHankel(func, _k, _res, N, nu, rmax, rel_err, abs_err)
+        _galsim.PyHankel(func, _k, _res, N, nu, rmax, dlogr, rel_err, abs_err)
     return res
 
 class IntegrationRule:
@@ -26,6 +26,7 @@ from .gsparams import GSParams
 from .utilities import lazy_property, doc_inherit
 from .angle import arcsec, AngleUnit, radians
 from .deltafunction import DeltaFunction
+from .errors import convert_cpp_errors
 
 class SecondKick(GSObject):
     """Class describing the expectation value of the high-k turbulence portion of an atmospheric
@@ -243,3 +244,49 @@ class SecondKick(GSObject):
         return SecondKick(lam=self.lam, r0=self.r0, diam=self.diam, obscuration=self.obscuration,
                           kcrit=self.kcrit, flux=flux, scale_unit=self.scale_unit,
                           gsparams=self.gsparams)
+
+    @staticmethod
+    def write_table(file_name, gsparams=None, build_all=False):
+        """Write the universal SecondKick table nodes for the given GSParams to a file.
+
+        SecondKick profiles use a table of the dimensionless profile at a grid of values of
+        kcrit, which includes the default kcrit=0.2.  Values of kcrit between the grid points
+        are only interpolated from the table if ``gsparams.xvalue_accuracy >= 3.e-3`` and
+        ``gsparams.kvalue_accuracy >= 3.e-6``.  The grid points are built as they are needed,
+        which involves a lot of numerical integrals.  Writing them to a file and reading them
+        back in with `SecondKick.read_table` lets other runs skip that step.
+
+        Parameters:
+            file_name:  The name of the file to write.
+            gsparams:   The `GSParams` of the profiles whose table should be written.
+                        [default: None, which means the default GSParams]
+            build_all:  Whether to build all the grid points first (in parallel if OpenMP is
+                        available), rather than only writing the ones built so far.
+                        [default: False]
+        """
+        gsparams = GSParams.check(gsparams)
+        with convert_cpp_errors():
+            _galsim.WriteSecondKickTable(file_name, gsparams._gsp, bool(build_all))
+
+    @staticmethod
+    def read_table(file_name, gsparams=None):
+        """Read universal SecondKick table nodes that were written with
+        `SecondKick.write_table`.
+
+        The file must have been written with the same GSParams and version of GalSim's table
+        format.  Otherwise a `GalSimError` is raised.
+
+        Parameters:
+            file_name:  The name of the file to read.
+            gsparams:   The `GSParams` of the profiles that will use the table.
+                        [default: None, which means the default GSParams]
+        """
+        gsparams = GSParams.check(gsparams)
+        with convert_cpp_errors():
+            _galsim.ReadSecondKickTable(file_name, gsparams._gsp)
+
+    @staticmethod
+    def clear_table():
+        """Release the universal SecondKick tables for all GSParams.
+        """
+        _galsim.ClearSecondKickTables()
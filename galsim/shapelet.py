@@ -262,6 +262,10 @@ class Shapelet(GSObject):
         natural scale size of the image.  However, it should be noted that some images are not well
         fit by a shapelet for any (reasonable) order.
 
+        The QR decompositions of the design matrices for a few small stamp geometries are cached,
+        so repeated fits with the same image size, center, order and image.scale/sigma only need
+        to do the solve.  Use `Shapelet.clear_fit_cache` to release this memory.
+
         Parameters:
             sigma:          The scale size in the standard units (usually arcsec).
             order:          The order of the shapelet decomposition.  This is the maximum
@@ -303,3 +307,10 @@ class Shapelet(GSObject):
             ret._bvec /= image.scale**2
 
         return ret
+
+    @staticmethod
+    def clear_fit_cache():
+        """Release the cached design matrices used by `Shapelet.fit` to make repeated fits
+        more efficient.
+        """
+        _galsim.ClearShapeletFitCache()
@@ -317,3 +317,44 @@ class VonKarman(GSObject):
                          scale_unit=self.scale_unit,
                          force_stepk=self.force_stepk, do_delta=self.do_delta,
                          suppress_warning=self._suppress, gsparams=self.gsparams)
+
+    @staticmethod
+    def write_table(file_name, gsparams=None):
+        """Write the universal VonKarman table nodes that have been built so far to a file.
+
+        For 25 <= L0/r0 <= 1.e5, the radial profile is interpolated from a table of the
+        dimensionless profile at a grid of values of L0/r0, as long as
+        ``gsparams.xvalue_accuracy >= 3.e-6``.  The grid points are built as they are needed,
+        which involves a lot of Hankel transforms.  Writing them to a file and reading them back
+        in with `VonKarman.read_table` lets other runs skip that step.
+
+        Parameters:
+            file_name:  The name of the file to write.
+            gsparams:   The `GSParams` of the profiles whose table should be written.
+                        [default: None, which means the default GSParams]
+        """
+        gsparams = GSParams.check(gsparams)
+        with convert_cpp_errors():
+            _galsim.WriteVonKarmanTable(file_name, gsparams._gsp)
+
+    @staticmethod
+    def read_table(file_name, gsparams=None):
+        """Read universal VonKarman table nodes that were written with `VonKarman.write_table`.
+
+        The file must have been written with the same GSParams and version of GalSim's table
+        format.  Otherwise a `GalSimError` is raised.
+
+        Parameters:
+            file_name:  The name of the file to read.
+            gsparams:   The `GSParams` of the profiles that will use the table.
+                        [default: None, which means the default GSParams]
+        """
+        gsparams = GSParams.check(gsparams)
+        with convert_cpp_errors():
+            _galsim.ReadVonKarmanTable(file_name, gsparams._gsp)
+
+    @staticmethod
+    def clear_table():
+        """Release the universal VonKarman tables for all GSParams.
+        """
+        _galsim.ClearVonKarmanTables()
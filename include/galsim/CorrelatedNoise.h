@@ -45,5 +45,21 @@ namespace galsim {
         ImageView<double>& cov, const SBProfile& sbp,
         const Bounds<int>& bounds, double dx);
 
+    /**
+     * @brief Return, as an Image, the correlation function at each distinct pixel separation
+     * that appears in the covariance matrix calculated by calculateCovarianceMatrix.
+     *
+     * This is a compact (block-Toeplitz) representation of the covariance matrix, which can be
+     * much smaller than the full matrix for large images.  For an image with dimensions
+     * idim x jdim, `lags` must have bounds [1-jdim, idim-1] x [1-idim, jdim-1], and the
+     * element cov(i,j) of the full matrix is lags(k,l), where
+     *
+     *     k = (j-1)/jdim - (i-1)/idim
+     *     l = (j-1)%jdim - (i-1)%idim
+     */
+    PUBLIC_API void calculateCovarianceLags(
+        ImageView<double>& lags, const SBProfile& sbp,
+        const Bounds<int>& bounds, double dx);
+
 }
 #endif
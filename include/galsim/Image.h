@@ -896,6 +896,36 @@ namespace galsim {
      */
     PUBLIC_API void ClearDepixelizeCache();
 
+    /**
+     *  @brief Total number of bytes requested from the scratch memory pool (used for all
+     *  C++-allocated images and temporary photon arrays) since the last reset.
+     */
+    PUBLIC_API size_t GetScratchBytesRequested();
+
+    /**
+     *  @brief Total number of bytes that the scratch memory pool actually had to allocate
+     *  from the heap since the last reset.  i.e. requests that could not reuse a freed block.
+     */
+    PUBLIC_API size_t GetScratchBytesAllocated();
+
+    /**
+     *  @brief Reset the two scratch pool counters to zero.
+     */
+    PUBLIC_API void ResetScratchCounters();
+
+    /**
+     *  @brief Number of bytes currently held on the scratch pool free lists of all threads.
+     */
+    PUBLIC_API size_t GetScratchBytesPooled();
+
+    /**
+     *  @brief Release the memory held in the scratch pool free lists of all threads.
+     *
+     *  Blocks that are still in use are not affected.  They go back onto a free list (or are
+     *  deleted) as usual when they are freed.
+     */
+    PUBLIC_API void ClearScratchPool();
+
 } // namespace galsim
 
 #include "ImageArith.h"
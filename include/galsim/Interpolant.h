@@ -22,6 +22,8 @@
 
 #include <cmath>
 #include <map>
+#include <algorithm>
+#include <limits>
 
 #include "Std.h"
 #include "Table.h"
@@ -113,6 +115,86 @@ namespace galsim {
          */
         void xvalMany(double* x, int N) const;
 
+        /**
+         * @brief The number of samples (taps) that contribute to an interpolated value at a
+         * non-integer position.
+         *
+         * This is 2*ceil(xrange()), but always at least 1.
+         */
+        int nTaps() const { return std::max(2*int(std::ceil(xrange())), 1); }
+
+        /**
+         * @brief Calculate the weights of a range of taps for a given fractional offset.
+         *
+         * For 0 <= f < 1, this sets wts[k-k1] = xval(k + kmin - f) for k = k1..k2, where
+         * kmin = 1 - nTaps()/2.  With k1 = 0 and k2 = nTaps()-1, these are the weights to apply
+         * to the samples at positions p0+kmin .. p0+kmin+nTaps()-1 in order to interpolate at
+         * x = p0 + f.  A smaller range is useful when some of the samples are off the edge of
+         * the data.
+         *
+         * The default implementation just calls xval for each tap.  Subclasses may override
+         * this with something more efficient.
+         *
+         * @param[in]  f    The fractional offset of the position being interpolated.
+         * @param[in]  k1   The first tap to calculate.
+         * @param[in]  k2   The last tap to calculate.
+         * @param[out] wts  The weights for each tap.  Must have room for k2-k1+1 values.
+         */
+        virtual void xvalTaps(double f, int k1, int k2, double* wts) const;
+
+        /**
+         * @brief Calculate the range and weights of the samples needed to interpolate at x.
+         *
+         * On output, the samples p1..p2 (inclusive) contribute to the value at x with weights
+         * wts[0..p2-p1].  If the interpolant is exact at nodes and x is (very nearly) an
+         * integer, only that one sample is used.
+         *
+         * Only samples in the range pmin..pmax are used, and only their weights are calculated,
+         * so the number of weights is at most min(nTaps(), pmax-pmin+1).  If none of the
+         * samples are in this range, then p2 < p1 on output.
+         *
+         * @param[in]  x    The position at which to interpolate (in pixels).
+         * @param[in]  pmin The first sample that is available.
+         * @param[in]  pmax The last sample that is available.
+         * @param[out] p1   The first sample that contributes.
+         * @param[out] p2   The last sample that contributes.
+         * @param[out] wts  The weights for each sample.
+         */
+        void getTaps(double x, int pmin, int pmax, int& p1, int& p2, double* wts) const;
+
+        /**
+         * @brief Calculate the range and weights of the samples needed to interpolate at x,
+         * with no limit on which samples are available.
+         *
+         * @param[in]  x    The position at which to interpolate (in pixels).
+         * @param[out] p1   The first sample that contributes.
+         * @param[out] p2   The last sample that contributes.
+         * @param[out] wts  The weights for each sample.  Must have room for nTaps() values.
+         */
+        void getTaps(double x, int& p1, int& p2, double* wts) const
+        {
+            getTaps(x, std::numeric_limits<int>::min(), std::numeric_limits<int>::max(),
+                    p1, p2, wts);
+        }
+
+        /**
+         * @brief Interpolate a 2-d grid of samples at the position (x,y).
+         *
+         * The interpolation is done separably, so there are only 2*nTaps() kernel evaluations,
+         * done by xvalTaps, rather than one for each sample used.
+         *
+         * @param[in] data    Pointer to the sample at (0,0).  Samples in the same row are
+         *                    contiguous in memory.
+         * @param[in] nx      The number of samples in each row.
+         * @param[in] ny      The number of rows.
+         * @param[in] stride  The number of elements between the start of successive rows.
+         * @param[in] x       The x position at which to interpolate, relative to the first sample.
+         * @param[in] y       The y position at which to interpolate, relative to the first row.
+         * @returns the interpolated value, taking samples outside of the grid to be zero.
+         */
+        double interpolate2d(const double* data, int nx, int ny, int stride,
+                             double x, double y) const;
+
         /**
          * @brief Value of interpolant in frequency space
          * @param[in] u Frequency for evaluation (cycles per pixel)
@@ -183,6 +265,13 @@ namespace galsim {
         virtual void shoot(PhotonArray& photons, UniformDeviate ud) const
         { checkSampler(); _sampler->shoot(photons, ud, true); }
 
+        /**
+         * @brief Build the photon sampler (if any) now rather than on the first call to shoot.
+         *
+         * After this, shoot may be called from multiple threads at once.
+         */
+        virtual void prepareForShoot() const { checkSampler(); }
+
         virtual std::string makeStr() const =0;
 
     protected:
@@ -247,6 +336,7 @@ namespace galsim {
         double getPositiveFlux() const { return 1.; }
         double getNegativeFlux() const { return 0.; }
         void shoot(PhotonArray& photons, UniformDeviate ud) const;
+        void prepareForShoot() const {}
 
         std::string makeStr() const;
     };
@@ -284,6 +374,7 @@ namespace galsim {
         double getPositiveFlux() const { return 1.; }
         double getNegativeFlux() const { return 0.; }
         void shoot(PhotonArray& photons, UniformDeviate ud) const;
+        void prepareForShoot() const {}
 
         std::string makeStr() const;
     };
@@ -348,12 +439,14 @@ namespace galsim {
 
         double xval(double x) const;
         double uval(double u) const;
+        void xvalTaps(double f, int k1, int k2, double* wts) const;
 
         // Override the default numerical photon-shooting method
         double getPositiveFlux() const { return 1.; }
         double getNegativeFlux() const { return 0.; }
         // Linear interpolant has fast photon-shooting by adding two uniform deviates per
         void shoot(PhotonArray& photons, UniformDeviate ud) const;
+        void prepareForShoot() const {}
 
         std::string makeStr() const;
     };
@@ -384,6 +477,7 @@ namespace galsim {
 
         double xval(double x) const;
         double uval(double u) const;
+        void xvalTaps(double f, int k1, int k2, double* wts) const;
 
         // Override numerical calculation with known analytic integral
         double getPositiveFlux() const { return 13./12.; }
@@ -429,6 +523,7 @@ namespace galsim {
 
         double xval(double x) const;
         double uval(double u) const;
+        void xvalTaps(double f, int k1, int k2, double* wts) const;
 
         // Override numerical calculation with known analytic integral
         // Not as simple as the Cubic one, but still a straightforward integral for Maple.
@@ -492,6 +587,16 @@ namespace galsim {
         double xval(double x) const;
         double uval(double u) const;
 
+        /**
+         * @brief Calculate the weights of all the taps for a given fractional offset.
+         *
+         * This uses a table of the tap weights at a fixed set of sub-pixel phases, which is
+         * interpolated (with 4-point Lagrange interpolation) in the phase direction.  The number
+         * of phases is chosen so that the error in each weight is less than
+         * 1.e-4 * xvalue_accuracy.
+         */
+        void xvalTaps(double f, int k1, int k2, double* wts) const;
+
         std::string makeStr() const;
 
     private:
@@ -504,8 +609,11 @@ namespace galsim {
         std::vector<double> _C; // coefficients for flux correction in uval
         shared_ptr<TableBuilder> _xtab; // Table for x values
         shared_ptr<TableBuilder> _utab; // Table for Fourier transform
+        shared_ptr<std::vector<double> > _taptab; // Table of tap weights at sub-pixel phases
+        int _nphase; // Number of phase intervals in _taptab
 
         double xCalc(double x) const;
+        void buildTapTable();
         double uCalc(double u) const;
         double uCalcRaw(double u) const; // uCalc without any flux conservation.
 
@@ -514,6 +622,7 @@ namespace galsim {
         static std::map<KeyType,shared_ptr<TableBuilder> > _cache_xtab;
         static std::map<KeyType,shared_ptr<TableBuilder> > _cache_utab;
         static std::map<KeyType,double> _cache_umax;
+        static std::map<KeyType,shared_ptr<std::vector<double> > > _cache_taptab;
     };
 
 }
@@ -217,6 +217,15 @@ namespace galsim {
             }
         }
 
+        /**
+         * @brief Remove all items from the cache.
+         */
+        void clear()
+        {
+            _entries.clear();
+            _cache.clear();
+        }
+
     private:
 
         size_t _nmax;
@@ -285,12 +285,10 @@ namespace galsim {
 
         // Most of the time the arrays are constructed in Python and passed in, so we don't
         // do any memory management of them.  However, for some use cases, we need to make a
-        // temporary PhotonArray with arrays allocated in the C++ layer.  The easiest way
-        // to do this safely is to make these vectors and let the standard library handle
-        // the memory allocation and deletion.
-        std::vector<double> _vx;
-        std::vector<double> _vy;
-        std::vector<double> _vflux;
+        // temporary PhotonArray with arrays allocated in the C++ layer.  These come from the
+        // same scratch pool as ImageAlloc (cf. allocateAlignedMemory), so repeated temporaries
+        // of similar sizes don't need to go back to the heap.
+        shared_ptr<double> _mem;
     };
 
 } // end namespace galsim
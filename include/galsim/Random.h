@@ -313,6 +313,18 @@ namespace galsim {
          */
         double generate1();
 
+        /**
+         * @brief Draw N new random numbers into an array in a single serial loop.
+         *
+         * The values are the same as N successive calls to operator(), but without a virtual
+         * function call for each one.  Unlike generate, this never uses multiple threads, so it
+         * is appropriate for filling modest buffers, possibly from within a parallel region.
+         *
+         * @param N     The number of values to draw
+         * @param data  The array into which to write the values
+         */
+        void generateSerial(long long N, double* data);
+
         /**
          * @brief Clear the internal cache
          */
@@ -37,6 +37,9 @@ namespace galsim {
 
         double xValue(const Position<double>& p) const;
         std::complex<double> kValue(const Position<double>& k) const;
+        void xValueMany(const double* x, const double* y, double* val, int n) const;
+        void kValueMany(const double* kx, const double* ky, std::complex<double>* kval,
+                        int n) const;
 
         double maxK() const { return _maxMaxK; }
         double stepK() const { return _minStepK; }
@@ -166,6 +169,9 @@ namespace galsim {
 
         void initialize();  ///< Sets all private book-keeping variables to starting state.
 
+        /// @brief Whether to draw the components one strip of rows at a time.
+        bool useStrips(int jzero) const;
+
         void doFillXImage(ImageView<double> im,
                           double x0, double dx, int izero,
                           double y0, double dy, int jzero) const
@@ -35,6 +35,7 @@ namespace galsim {
         std::complex<double> kValue(const Position<double>& k) const;
 
         bool isAxisymmetric() const { return false; }
+        bool isQuadrantSymmetric() const { return true; }
         bool hasHardEdges() const { return true; }
         bool isAnalyticX() const { return true; }
         bool isAnalyticK() const { return true; }
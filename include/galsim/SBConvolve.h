@@ -32,6 +32,16 @@ namespace galsim {
         const SBProfile& p1, const SBProfile& p2, const Position<double>& pos, double flux,
         const GSParams& gsparams);
 
+    // Fill an image with the real-space convolution of p1 and p2.  The position of pixel
+    // (i,j) is x = x0 + i dx + j dxy, y = y0 + i dyx + j dy.  This is much faster than calling
+    // RealSpaceConvolve for each pixel, since the parts of the calculation that don't depend
+    // on the position are only done once, and the pixels are done in parallel.
+    template <typename T>
+    void RealSpaceConvolveImage(
+        const SBProfile& p1, const SBProfile& p2, ImageView<T> im,
+        double x0, double dx, double dxy, double y0, double dy, double dyx,
+        double flux, const GSParams& gsparams);
+
     /**
      * @brief Convolve SBProfiles.
      *
@@ -44,6 +44,7 @@ namespace galsim {
         std::complex<double> kValue(const Position<double>& k) const;
 
         bool isAxisymmetric() const { return _isStillAxisymmetric; }
+        bool isQuadrantSymmetric() const;
         bool hasHardEdges() const { return false; }
         bool isAnalyticX() const { return _real_space; }
         bool isAnalyticK() const { return true; }    // convolvees must all meet this
@@ -116,6 +117,14 @@ namespace galsim {
 
         // Overrides for better efficiency
         template <typename T>
+        void fillXImage(ImageView<T> im,
+                        double x0, double dx, int izero,
+                        double y0, double dy, int jzero) const;
+        template <typename T>
+        void fillXImage(ImageView<T> im,
+                        double x0, double dx, double dxy,
+                        double y0, double dy, double dyx) const;
+        template <typename T>
         void fillKImage(ImageView<std::complex<T> > im,
                         double kx0, double dkx, int izero,
                         double ky0, double dky, int jzero) const;
@@ -135,9 +144,28 @@ namespace galsim {
         bool _isStillAxisymmetric; ///< Is output SBProfile shape still circular?
         double _fluxProduct; ///< Flux of the product.
 
+        /// @brief Whether to draw the components one strip of rows at a time.
+        bool useStrips(int jzero) const;
+
         mutable double _maxk; ///< Minimum maxK() of the convolved SBProfiles.
         mutable double _stepk; ///< Minimum stepK() of the convolved SBProfiles.
 
+        void doFillXImage(ImageView<double> im,
+                          double x0, double dx, int izero,
+                          double y0, double dy, int jzero) const
+        { fillXImage(im,x0,dx,izero,y0,dy,jzero); }
+        void doFillXImage(ImageView<double> im,
+                          double x0, double dx, double dxy,
+                          double y0, double dy, double dyx) const
+        { fillXImage(im,x0,dx,dxy,y0,dy,dyx); }
+        void doFillXImage(ImageView<float> im,
+                          double x0, double dx, int izero,
+                          double y0, double dy, int jzero) const
+        { fillXImage(im,x0,dx,izero,y0,dy,jzero); }
+        void doFillXImage(ImageView<float> im,
+                          double x0, double dx, double dxy,
+                          double y0, double dy, double dyx) const
+        { fillXImage(im,x0,dx,dxy,y0,dy,dyx); }
         void doFillKImage(ImageView<std::complex<double> > im,
                           double kx0, double dkx, int izero,
                           double ky0, double dky, int jzero) const
@@ -177,6 +205,7 @@ namespace galsim {
         { return SQR(_adaptee.kValue(k)); }
 
         bool isAxisymmetric() const { return _adaptee.isAxisymmetric(); }
+        bool isQuadrantSymmetric() const { return GetImpl(_adaptee)->isQuadrantSymmetric(); }
         bool hasHardEdges() const { return false; }
         bool isAnalyticX() const { return _real_space; }
         bool isAnalyticK() const { return true; }
@@ -195,6 +224,14 @@ namespace galsim {
 
         // Overrides for better efficiency
         template <typename T>
+        void fillXImage(ImageView<T> im,
+                        double x0, double dx, int izero,
+                        double y0, double dy, int jzero) const;
+        template <typename T>
+        void fillXImage(ImageView<T> im,
+                        double x0, double dx, double dxy,
+                        double y0, double dy, double dyx) const;
+        template <typename T>
         void fillKImage(ImageView<std::complex<T> > im,
                         double kx0, double dkx, int izero,
                         double ky0, double dky, int jzero) const;
@@ -214,6 +251,22 @@ namespace galsim {
         template <typename T>
         static T SQR(T x) { return x*x; }
 
+        void doFillXImage(ImageView<double> im,
+                          double x0, double dx, int izero,
+                          double y0, double dy, int jzero) const
+        { fillXImage(im,x0,dx,izero,y0,dy,jzero); }
+        void doFillXImage(ImageView<double> im,
+                          double x0, double dx, double dxy,
+                          double y0, double dy, double dyx) const
+        { fillXImage(im,x0,dx,dxy,y0,dy,dyx); }
+        void doFillXImage(ImageView<float> im,
+                          double x0, double dx, int izero,
+                          double y0, double dy, int jzero) const
+        { fillXImage(im,x0,dx,izero,y0,dy,jzero); }
+        void doFillXImage(ImageView<float> im,
+                          double x0, double dx, double dxy,
+                          double y0, double dy, double dyx) const
+        { fillXImage(im,x0,dx,dxy,y0,dy,dyx); }
         void doFillKImage(ImageView<std::complex<double> > im,
                           double kx0, double dkx, int izero,
                           double ky0, double dky, int jzero) const
@@ -253,6 +306,7 @@ namespace galsim {
         { return NORM(_adaptee.kValue(k)); }
 
         bool isAxisymmetric() const { return _adaptee.isAxisymmetric(); }
+        bool isQuadrantSymmetric() const { return GetImpl(_adaptee)->isQuadrantSymmetric(); }
         bool hasHardEdges() const { return false; }
         bool isAnalyticX() const { return _real_space; }
         bool isAnalyticK() const { return true; }
@@ -271,6 +325,14 @@ namespace galsim {
 
         // Overrides for better efficiency
         template <typename T>
+        void fillXImage(ImageView<T> im,
+                        double x0, double dx, int izero,
+                        double y0, double dy, int jzero) const;
+        template <typename T>
+        void fillXImage(ImageView<T> im,
+                        double x0, double dx, double dxy,
+                        double y0, double dy, double dyx) const;
+        template <typename T>
         void fillKImage(ImageView<std::complex<T> > im,
                         double kx0, double dkx, int izero,
                         double ky0, double dky, int jzero) const;
@@ -292,6 +354,22 @@ namespace galsim {
         template <typename T>
         static T NORM(std::complex<T> x) { return std::norm(x); }
 
+        void doFillXImage(ImageView<double> im,
+                          double x0, double dx, int izero,
+                          double y0, double dy, int jzero) const
+        { fillXImage(im,x0,dx,izero,y0,dy,jzero); }
+        void doFillXImage(ImageView<double> im,
+                          double x0, double dx, double dxy,
+                          double y0, double dy, double dyx) const
+        { fillXImage(im,x0,dx,dxy,y0,dy,dyx); }
+        void doFillXImage(ImageView<float> im,
+                          double x0, double dx, int izero,
+                          double y0, double dy, int jzero) const
+        { fillXImage(im,x0,dx,izero,y0,dy,jzero); }
+        void doFillXImage(ImageView<float> im,
+                          double x0, double dx, double dxy,
+                          double y0, double dy, double dyx) const
+        { fillXImage(im,x0,dx,dxy,y0,dy,dyx); }
         void doFillKImage(ImageView<std::complex<double> > im,
                           double kx0, double dkx, int izero,
                           double ky0, double dky, int jzero) const
@@ -98,6 +98,8 @@ namespace galsim {
 
         double xValue(const Position<double>& p) const;
         std::complex<double> kValue(const Position<double>& k) const;
+        void xValueMany(const double* x, const double* y, double* val, int n) const;
+        void kValueRadialMany(const double* ksq, double* val, int n) const;
 
         void getXRange(double& xmin, double& xmax, std::vector<double>& splits) const
         { xmin = -integ::MOCK_INF; xmax = integ::MOCK_INF; splits.push_back(0.); }
@@ -34,6 +34,8 @@ namespace galsim {
 
         double xValue(const Position<double>& p) const;
         std::complex<double> kValue(const Position<double>& k) const;
+        void xValueMany(const double* x, const double* y, double* val, int n) const;
+        void kValueRadialMany(const double* ksq, double* val, int n) const;
 
         bool isAxisymmetric() const { return true; }
         bool hasHardEdges() const { return false; }
@@ -134,6 +134,9 @@ namespace galsim {
         // Helper function to get k values
         double kValueHelper(double kx, double ky) const;
 
+        // Helper function to get the factor from the vertical profile, which only depends on ky
+        double convFactor(double ky) const;
+
         // Helper functor to solve for the proper _maxk
         class SBInclinedSersicKValueFunctor;
 
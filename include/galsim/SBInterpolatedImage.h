@@ -28,9 +28,47 @@
 
 namespace galsim {
 
+    namespace sbp {
+
+        // Default maximum memory (in bytes) to use for caching the k images and other derived
+        // quantities of SBInterpolatedImages, so identical input images can share them.
+        // This may be changed with SetInterpolatedImageCacheMaxBytes.
+        const size_t max_interpolated_image_cache = 256 * 1024 * 1024;
+
+    }
+
     PUBLIC_API double CalculateSizeContainingFlux(
         const BaseImage<double>& im, double target_flux);
 
+    /**
+     * @brief Release the cached data that SBInterpolatedImages made from identical images share.
+     *
+     * SBInterpolatedImages that are already using some of the data keep it alive, but new
+     * ones will need to recompute it.
+     */
+    PUBLIC_API void ClearInterpolatedImageCache();
+
+    /**
+     * @brief The number of distinct images that currently have data in the SBInterpolatedImage
+     * cache.
+     */
+    PUBLIC_API int GetInterpolatedImageCacheSize();
+
+    /**
+     * @brief The approximate number of bytes currently used by the SBInterpolatedImage cache.
+     */
+    PUBLIC_API size_t GetInterpolatedImageCacheBytes();
+
+    /**
+     * @brief Set the maximum number of bytes to use for the SBInterpolatedImage cache,
+     * removing the least recently used images if it is currently larger than this.
+     *
+     * The most recently used image is always kept, even if it is larger than this by itself.
+     *
+     * @returns the previous maximum.
+     */
+    PUBLIC_API size_t SetInterpolatedImageCacheMaxBytes(size_t nbytes);
+
     /**
      * @brief Surface Brightness Profile represented by interpolation over one or more data
      * tables/images.
@@ -121,6 +159,11 @@ namespace galsim {
 
         class SBInterpolatedImageImpl;
 
+        friend void ClearInterpolatedImageCache();
+        friend int GetInterpolatedImageCacheSize();
+        friend size_t GetInterpolatedImageCacheBytes();
+        friend size_t SetInterpolatedImageCacheMaxBytes(size_t nbytes);
+
     private:
         // op= is undefined
         void operator=(const SBInterpolatedImage& rhs);
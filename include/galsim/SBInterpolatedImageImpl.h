@@ -20,9 +20,12 @@
 #ifndef GalSim_SBInterpolatedImageImpl_H
 #define GalSim_SBInterpolatedImageImpl_H
 
+#include <atomic>
+
 #include "SBProfileImpl.h"
 #include "SBInterpolatedImage.h"
 #include "ProbabilityTree.h"
+#include "LRUCache.h"
 
 namespace galsim {
 
@@ -43,6 +46,11 @@ namespace galsim {
 
         double xValue(const Position<double>& p) const;
         std::complex<double> kValue(const Position<double>& p) const;
+        // The interpolation weights are reused between consecutive points with the same kx or
+        // ky (as happens when the positions come from a grid), and the points are split among
+        // threads if OpenMP is available.
+        void kValueMany(const double* kx, const double* ky, std::complex<double>* kval,
+                        int n) const;
 
         template <typename T>
         void fillXImage(ImageView<T> im,
@@ -120,6 +128,12 @@ namespace galsim {
 
         double calculateFlux() const;
 
+        // Access to the cache of SharedData for the functions declared in SBInterpolatedImage.h.
+        static void ClearCache();
+        static int GetCacheSize();
+        static size_t GetCacheBytes();
+        static size_t SetCacheMaxBytes(size_t nbytes);
+
     private:
 
         int _Nk;
@@ -131,6 +145,9 @@ namespace galsim {
         const Interpolant& _xInterp; ///< Interpolant used in real space.
         const Interpolant& _kInterp; ///< Interpolant used in k space.
         mutable shared_ptr<ImageAlloc<std::complex<double> > > _kimage;
+        // Set (with release ordering) once _kimage is ready to use, so checkK can test it
+        // without taking the lock.
+        mutable std::atomic<bool> _kready;
         mutable double _stepk;
         mutable double _maxk;
         mutable double _flux;
@@ -140,7 +157,7 @@ namespace galsim {
         double _maxk1; ///< maxk based just on the xInterp urange
         double _uscale; ///< conversion from k to u for xInterpolant
 
-        /// @brief Make kimage if necessary.
+        /// @brief Make kimage if necessary.  This is safe to call from multiple threads.
         void checkK() const;
 
         /// @brief Set true if the data structures for photon-shooting are valid
@@ -165,7 +182,67 @@ namespace galsim {
         };
         mutable double _positiveFlux;    ///< Sum of all positive pixels' flux
         mutable double _negativeFlux;    ///< Sum of all negative pixels' flux
-        mutable ProbabilityTree<Pixel> _pt; ///< Binary tree of pixels, for photon-shooting
+
+        /**
+         * @brief The pixels of the nonzero region arranged for photon shooting.
+         *
+         * The fluxes here are the raw sums over the pixels, before convolving by the
+         * interpolant.
+         */
+        struct ShootData
+        {
+            double positiveFlux;
+            double negativeFlux;
+            ProbabilityTree<Pixel> pt;  ///< Binary tree of pixels, for photon-shooting
+        };
+        mutable shared_ptr<const ShootData> _shootdata;
+
+        /**
+         * @brief Quantities derived from the padded image that are expensive to compute.
+         *
+         * These only depend on the pixel values of the padded image, plus a few parameters that
+         * are included in the map keys, so they are shared among all SBInterpolatedImages made
+         * from identical images.  e.g. the same galaxy or PSF image used many times in a
+         * simulation only needs to be Fourier transformed once.
+         *
+         * All access to the contents after construction must be done in the critical section
+         * named galsim_interpolatedimage_cache.
+         */
+        struct SharedData
+        {
+            SharedData() : nbytes(0), cached(true) {}
+
+            shared_ptr<ImageAlloc<std::complex<double> > > kimage;
+            /// (max_ix, thresh) -> maxk_ix found by calculateMaxK
+            std::map<Tuple<int,double>, double> maxk;
+            /// (init_bounds, thresh) -> R found by calculateStepK
+            std::map<Tuple<int,int,int,int,double>, double> size;
+            /// (nonzero_bounds, abs flux of interpolant) -> photon shooting tree
+            std::map<Tuple<int,int,int,int,double>, shared_ptr<const ShootData> > shoot;
+
+            size_t nbytes;  ///< Approximate memory used by the above.
+            bool cached;    ///< Whether this is still in the cache.
+        };
+        shared_ptr<SharedData> _shared;
+
+        /// @brief Find (or make) the SharedData for a given padded image.
+        static shared_ptr<SharedData> getSharedData(const BaseImage<double>& image);
+
+        /// @brief Record nbytes more memory used by data, and trim the cache if necessary.
+        /// Must be called in the critical section galsim_interpolatedimage_cache.
+        static void addSharedBytes(SharedData& data, size_t nbytes);
+
+        /// @brief Remove the least recently used items until the cache is under its maximum size.
+        /// Must be called in the critical section galsim_interpolatedimage_cache.
+        static void trimSharedData();
+
+        // The cache of SharedData, in order of most recently used, and a map to find them.
+        typedef Tuple<uint64_t,uint64_t> SharedKey;
+        typedef std::list<std::pair<SharedKey,shared_ptr<SharedData> > > SharedList;
+        static SharedList _shared_list;
+        static std::map<SharedKey,SharedList::iterator> _shared_map;
+        static size_t _shared_nbytes;
+        static size_t _shared_max_nbytes;
 
     private:
 
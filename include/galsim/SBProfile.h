@@ -153,6 +153,33 @@ namespace galsim {
          */
         std::complex<double> kValue(const Position<double>& k) const;
 
+        /**
+         * @brief Evaluate the SBProfile at many positions in real space at once.
+         *
+         * This is equivalent to calling xValue for each position, but it avoids the per-point
+         * virtual dispatch, and many profiles have specialized implementations that work on
+         * the whole array at once.
+         *
+         * @param[in] x         Array of x values.
+         * @param[in] y         Array of y values.
+         * @param[out] val      Array in which to write the results.
+         * @param[in] n         The number of positions.
+         */
+        void xValueMany(const double* x, const double* y, double* val, int n) const;
+
+        /**
+         * @brief Evaluate the SBProfile at many positions in k space at once.
+         *
+         * This is equivalent to calling kValue for each position.  See xValueMany.
+         *
+         * @param[in] kx        Array of kx values.
+         * @param[in] ky        Array of ky values.
+         * @param[out] kval     Array in which to write the results.
+         * @param[in] n         The number of positions.
+         */
+        void kValueMany(const double* kx, const double* ky, std::complex<double>* kval,
+                        int n) const;
+
         //@{
         /**
          *  @brief Define the range over which the profile is not trivially zero.
@@ -299,6 +326,27 @@ namespace galsim {
          */
         void shoot(PhotonArray& photons, BaseDeviate rng) const;
 
+        /**
+         * @brief Shoot photons through this SBProfile, using multiple threads if available.
+         *
+         * The photon array is split into chunks of chunk_size photons.  Each chunk is shot
+         * through the whole profile with its own UniformDeviate, seeded from a value drawn from
+         * rng.  The chunks are independent, so they are done in parallel when OpenMP is
+         * available.  The output only depends on rng and chunk_size, not on the number of
+         * threads.  However, it is not the same realization that shoot() would produce.
+         *
+         * Each photon's flux is scaled so the total flux is the same as if the whole array
+         * had been shot at once.
+         *
+         * This is not (yet) used by the python drawImage(method='phot') path, which always
+         * uses shoot().
+         *
+         * @param[in] photons     PhotonArray in which to write the photon information
+         * @param[in] rng         BaseDeviate used to seed the random numbers for each chunk.
+         * @param[in] chunk_size  The number of photons per chunk. [default: 100000]
+         */
+        void shootChunks(PhotonArray& photons, BaseDeviate rng, int chunk_size=100000) const;
+
         /**
          * @brief Return expectation value of flux in positive photons when shoot() is called
          *
@@ -362,6 +410,28 @@ namespace galsim {
         template <typename T>
         void drawK(ImageView<std::complex<T> > image, double dk, double* jac) const;
 
+        /**
+         * @brief Draw several axisymmetric profiles in k space at once.
+         *
+         * This is intended for chromatic drawing, where the same kind of profile (e.g. a
+         * Kolmogorov, VonKarman or Airy) is drawn for a list of wavelengths.  The k grid is
+         * only computed once, and each profile's radial k profile is evaluated only once for
+         * each distinct |k| on that grid, rather than once per pixel.
+         *
+         * If images has the same length as profs, then images[i] is set to weights[i] times
+         * the k image of profs[i].  If there is only a single image, it is set to the weighted
+         * sum of all the profiles.  All images must have the same bounds.
+         *
+         * @param[in]        profs, the profiles to draw (must all be axisymmetric)
+         * @param[in]        weights, the weight to apply to each profile
+         * @param[in,out]    images in k space (must be ImageViewC)
+         * @param[in]        dk, the step size in k space
+         */
+        template <typename T>
+        static void drawKMany(const std::vector<SBProfile>& profs,
+                              const std::vector<double>& weights,
+                              std::vector<ImageView<std::complex<T> > > images, double dk);
+
     protected:
 
         class SBProfileImpl;
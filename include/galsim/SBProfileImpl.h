@@ -118,6 +118,23 @@ namespace galsim {
             double /*x*/, double& ymin, double& ymax, std::vector<double>& splits) const
         { getYRange(ymin,ymax,splits); }
 
+        // Whether f(x,y) = f(|x|,|y|).  This is true for any axisymmetric profile, but also
+        // for a few others (e.g. Box).  Real-space convolutions use this to only integrate
+        // over one quadrant of a centered image.
+        virtual bool isQuadrantSymmetric() const { return isAxisymmetric(); }
+
+        // Evaluate the profile at n positions.  The default implementations just call xValue
+        // or kValue for each one, except that kValueMany uses kValueRadialMany for
+        // axisymmetric profiles.  Profiles can override these with faster versions.
+        virtual void xValueMany(const double* x, const double* y, double* val, int n) const;
+        virtual void kValueMany(const double* kx, const double* ky, std::complex<double>* kval,
+                                int n) const;
+
+        // For axisymmetric profiles, calculate the (real) k values at n values of
+        // ksq = kx^2 + ky^2.  SBProfile::drawKMany uses this to evaluate the radial profile
+        // once per distinct |k| rather than once per pixel.  The default just calls kValue.
+        virtual void kValueRadialMany(const double* ksq, double* val, int n) const;
+
         virtual double getPositiveFlux() const { return getFlux()>0. ? getFlux() : 0.; }
 
         virtual double getNegativeFlux() const { return getFlux()>0. ? 0. : -getFlux(); }
@@ -193,6 +210,43 @@ namespace galsim {
     void GetKValueRange2d(int& i1, int& i2, int m, double kmax, double ksqmax,
                           double kx0, double dkx, double ky0, double dky);
 
+    // Fill x, y with N points uniformly distributed in the unit circle, using the polar
+    // rejection method: xu = 2u-1, yu = 2u-1, repeated until rsq = xu^2 + yu^2 < 1.
+    // rsq is set to the final value of xu^2 + yu^2 for each point.  If exclude_zero is true,
+    // then rsq == 0 is rejected as well.
+    // The uniform deviates are drawn in blocks with UniformDeviate::generateSerial, but they are
+    // used in exactly the same order as the one-photon-at-a-time loop would use them, so the
+    // profiles that shoot this way (Gaussian, Moffat, TopHat) produce the same photons.
+    void ShootUnitCircle(UniformDeviate ud, int N, double* x, double* y, double* rsq,
+                         bool exclude_zero);
+
+    // SBAdd and SBConvolve combine the images of their components.  Rather than drawing each
+    // component onto a full-size temporary image and then combining them, they work on a strip
+    // of rows at a time.  This keeps the temporary image small, and each strip is combined
+    // while it is still in cache.  Any SBTransforms in the tree likewise apply their flux
+    // scaling or phases to the strip while it is in cache.
+    //
+    // Get the number of rows to use for each strip of an image with ncol columns.
+    int GetStripRows(int ncol, int elem_size);
+
+    // Call fill(strip, j1, jzero1) for each strip of rows of im, where strip is a view of rows
+    // j1 <= j < j1 + strip.getNRow(), and jzero1 is the value of jzero to use for that strip.
+    template <typename T, typename F>
+    void ForEachStrip(ImageView<T> im, int jzero, F fill)
+    {
+        const Bounds<int>& b = im.getBounds();
+        const int n = im.getNRow();
+        const int nrows = GetStripRows(im.getNCol(), sizeof(T));
+        for (int j1=0; j1<n; j1+=nrows) {
+            int j2 = std::min(j1+nrows, n);
+            ImageView<T> strip = im[Bounds<int>(b.getXMin(), b.getXMax(),
+                                                b.getYMin()+j1, b.getYMin()+j2-1)];
+            // Only use jzero if that row is in this strip.
+            int jzero1 = (jzero >= j1 && jzero < j2) ? jzero-j1 : 0;
+            fill(strip, j1, jzero1);
+        }
+    }
+
 }
 
 #endif
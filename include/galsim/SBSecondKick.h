@@ -30,6 +30,8 @@ namespace galsim {
     namespace sbp {
         // How many SecondKick profiles to save in the cache
         const int max_SK_cache = 100;
+        // How many universal SecondKick tables (one per GSParams) to save in the cache
+        const int max_SK_table_cache = 10;
     }
 
     class PUBLIC_API SBSecondKick : public SBProfile
@@ -72,6 +74,41 @@ namespace galsim {
         // op= is undefined
         void operator=(const SBSecondKick& rhs);
     };
+
+    /**
+     * @brief Write the universal SecondKick tables for the given GSParams to a file.
+     *
+     * SecondKick profiles can use a table of the dimensionless profile at a grid of values of
+     * kcrit, which includes the default kcrit=0.2.  Values of kcrit between the grid points are
+     * only interpolated from the table if xvalue_accuracy >= 3.e-3 and kvalue_accuracy >= 3.e-6.
+     * Building the grid points involves a lot of numerical integrals.
+     * Saving them to a file with this function and reading them back in with
+     * ReadSecondKickTable lets other runs skip that step.
+     *
+     * If build_all is true, then all the grid points are built first (in parallel if OpenMP
+     * is available).  Otherwise, only the ones that have been built so far are written.
+     */
+    PUBLIC_API void WriteSecondKickTable(const std::string& file, const GSParams& gsparams,
+                                         bool build_all);
+
+    /**
+     * @brief Read universal SecondKick tables that were written with WriteSecondKickTable.
+     *
+     * The file must have been written with the same GSParams and version of GalSim's table
+     * format.  Otherwise an SBError is thrown.
+     */
+    PUBLIC_API void ReadSecondKickTable(const std::string& file, const GSParams& gsparams);
+
+    /**
+     * @brief Release the universal SecondKick tables for all GSParams.
+     */
+    PUBLIC_API void ClearSecondKickTables();
+
+    /**
+     * @brief The number of universal SecondKick table nodes that have been built for the given
+     * GSParams, not counting any that were read in with ReadSecondKickTable.
+     */
+    PUBLIC_API int GetSecondKickTableNBuilt(const GSParams& gsparams);
 }
 
 #endif
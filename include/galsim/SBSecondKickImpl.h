@@ -26,9 +26,79 @@
 #include "OneDimensionalDeviate.h"
 #include "Table.h"
 #include "SBAiryImpl.h"
+#include "UniversalTable.h"
 
 namespace galsim {
 
+    //
+    //
+    //
+    //SKUniversalTable
+    //
+    //
+    //
+
+    // SKInfo is dimensionless (k in units of k0 = 2pi/lam_over_r0), so it depends only on kcrit.
+    // This table stores E(k) = exp(-sf(k)/2) and the radial profile f(r) at a grid of kcrit
+    // values, spaced by 0.025 in log10(kcrit) over 0.0095 < kcrit < 10.  The grid includes
+    // the default kcrit = 0.2 exactly.  A new SKInfo takes its tables from 4-point Lagrange
+    // interpolation in log(kcrit) between these, rather than doing the structure function
+    // integrals and Hankel transforms itself.  The grid points are built as they are needed,
+    // or they can be read in from a file written by WriteSecondKickTable.
+    // The interpolated f(r) is only accurate to about 3.e-3 of f(0), and E(k) to about 3.e-6,
+    // so values of kcrit between the grid points only use the table if xvalue_accuracy and
+    // kvalue_accuracy are at least this large.
+    class SKUniversalTable
+    {
+    public:
+        SKUniversalTable(const GSParamsPtr& gsparams);
+
+        ~SKUniversalTable() {}
+
+        // The tabulated functions at one grid point.  All nodes use the same k and r values
+        // (cf. SKUniversalTable constructor), but f stops once it is negligible.
+        struct Node
+        {
+            std::vector<double> E;
+            std::vector<double> f;
+        };
+
+        // Get tables of E(k) and f(r) for this value of kcrit, building any nodes that are
+        // needed.  Returns false if kcrit is outside the range of the grid or if the table
+        // isn't accurate enough for the GSParams.
+        bool getTables(double kcrit, shared_ptr<TableBuilder>& etab,
+                       shared_ptr<TableBuilder>& ftab) const;
+
+        // Build all the nodes that are not built yet.
+        void buildAll() const;
+
+        // Write all the nodes that have been built so far, or read them back in.
+        void write(std::ostream& os) const;
+        void read(std::istream& is);
+
+        // The number of nodes that have been built (rather than read in).
+        int getNBuilt() const { return _grid.nbuilt(); }
+
+        // Get the table to use for a given GSParams.
+        static shared_ptr<SKUniversalTable> Get(const GSParamsPtr& gsparams);
+
+        // Release the tables for all GSParams.
+        static void Clear();
+
+    private:
+        SKUniversalTable(const SKUniversalTable& rhs); ///<Hide the copy constructor
+        void operator=(const SKUniversalTable& rhs); ///<Hide the assignment operator
+
+        shared_ptr<const Node> buildNode(int i) const;
+
+        GSParamsPtr _gsparams;
+        std::vector<double> _k;
+        std::vector<double> _r;
+        mutable UniversalTableGrid<Node> _grid;
+
+        static LRUCache<GSParamsPtr,SKUniversalTable> cache;
+    };
+
     //
     //
     //
@@ -40,7 +110,9 @@ namespace galsim {
     class SKInfo
     {
     public:
-        SKInfo(double kcrit, const GSParamsPtr& gsparams);
+        // If use_table is false, then don't use SKUniversalTable.  (This is used to build the
+        // table nodes.)
+        SKInfo(double kcrit, const GSParamsPtr& gsparams, bool use_table=true);
         ~SKInfo() {}
 
         double stepK() const { return _stepk; }
@@ -70,8 +142,10 @@ namespace galsim {
         TableBuilder _kvLUT;
         shared_ptr<OneDimensionalDeviate> _sampler;
 
-        void _buildRadial();
-        void _buildKVLUT();
+        // etab and ftab are the tables from SKUniversalTable to use if not null.
+        void _buildRadial(const Table* ftab);
+        void _buildKVLUT(const Table* etab);
+        void _kvValue(double k, const Table* etab, double& sf, double& kv) const;
     };
 
     //
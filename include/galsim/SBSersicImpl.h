@@ -55,6 +55,13 @@ namespace galsim {
          */
         double kValue(double ksq) const;
 
+        /**
+         * @brief Calculate kValue for n values of ksq at once.
+         *
+         * This lets the lookup table values be interpolated in a single batch.
+         */
+        void kValueMany(const double* ksq, double* val, int n) const;
+
         double maxK() const;
         double stepK() const;
 
@@ -138,6 +145,8 @@ namespace galsim {
 
         double xValue(const Position<double>& p) const;
         std::complex<double> kValue(const Position<double>& k) const;
+        void xValueMany(const double* x, const double* y, double* val, int n) const;
+        void kValueRadialMany(const double* ksq, double* val, int n) const;
 
         double maxK() const;
         double stepK() const;
@@ -65,6 +65,11 @@ namespace galsim {
     PUBLIC_API void ShapeletFitImage(
         double sigma, LVector& bvec, const BaseImage<T>& image,
         double image_scale, const Position<double>& center);
+
+    /**
+     *  @brief Clear the cached design matrices used by ShapeletFitImage
+     */
+    PUBLIC_API void ClearShapeletFitCache();
 }
 
 #endif
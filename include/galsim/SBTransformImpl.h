@@ -42,6 +42,12 @@ namespace galsim {
                 && (_mB==-_mC) && (_mA==_mD)
                 && (_cen.x==0.) && (_cen.y==0.); // Need pure rotation
         }
+        bool isQuadrantSymmetric() const {
+            return isAxisymmetric() || (
+                GetImpl(_adaptee)->isQuadrantSymmetric()
+                && ((_mB==0. && _mC==0.) || (_mA==0. && _mD==0.))
+                && (_cen.x==0.) && (_cen.y==0.)); // Need no rotation (other than x<->y)
+        }
         bool hasHardEdges() const { return _adaptee.hasHardEdges(); }
         bool isAnalyticX() const { return _adaptee.isAnalyticX(); }
         bool isAnalyticK() const { return _adaptee.isAnalyticK(); }
@@ -55,6 +61,10 @@ namespace galsim {
 
         void getYRangeX(double x, double& ymin, double& ymax, std::vector<double>& splits) const;
 
+        void xValueMany(const double* x, const double* y, double* val, int n) const;
+        void kValueMany(const double* kx, const double* ky, std::complex<double>* kval,
+                        int n) const;
+
         Position<double> centroid() const { return _cen + fwd(_adaptee.centroid()); }
 
         double getFlux() const { return _adaptee.getFlux() * _fluxScaling; }
@@ -30,6 +30,8 @@ namespace galsim {
     namespace sbp {
         // How many VonKarman profiles to save in the cache
         const int max_vonKarman_cache = 100;
+        // How many universal VonKarman tables (one per GSParams) to save in the cache
+        const int max_vonKarman_table_cache = 10;
     }
 
     class PUBLIC_API SBVonKarman : public SBProfile
@@ -78,6 +80,37 @@ namespace galsim {
         // op= is undefined
         void operator=(const SBVonKarman& rhs);
     };
+
+    /**
+     * @brief Write the universal VonKarman tables that have been built so far for the given
+     * GSParams to a file.
+     *
+     * The radial profiles of VonKarman profiles with 25 <= L0/r0 <= 1.e5 are interpolated
+     * from a table of the dimensionless profile at a grid of values of L0/r0, as long as
+     * xvalue_accuracy >= 3.e-6.  The grid points are built as they are needed, which involves
+     * a lot of Hankel transforms.  Saving them to a file with this function and reading them
+     * back in with ReadVonKarmanTable lets other runs skip that step.
+     */
+    PUBLIC_API void WriteVonKarmanTable(const std::string& file, const GSParams& gsparams);
+
+    /**
+     * @brief Read universal VonKarman tables that were written with WriteVonKarmanTable.
+     *
+     * The file must have been written with the same GSParams and version of GalSim's table
+     * format.  Otherwise an SBError is thrown.
+     */
+    PUBLIC_API void ReadVonKarmanTable(const std::string& file, const GSParams& gsparams);
+
+    /**
+     * @brief Release the universal VonKarman tables for all GSParams.
+     */
+    PUBLIC_API void ClearVonKarmanTables();
+
+    /**
+     * @brief The number of universal VonKarman table nodes that have been built for the given
+     * GSParams, not counting any that were read in with ReadVonKarmanTable.
+     */
+    PUBLIC_API int GetVonKarmanTableNBuilt(const GSParams& gsparams);
 }
 
 #endif
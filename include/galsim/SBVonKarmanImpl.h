@@ -20,14 +20,80 @@
 #ifndef GalSim_SBVonKarmanImpl_H
 #define GalSim_SBVonKarmanImpl_H
 
+#include <atomic>
+
 #include "SBProfileImpl.h"
 #include "SBVonKarman.h"
 #include "LRUCache.h"
 #include "OneDimensionalDeviate.h"
 #include "Table.h"
+#include "UniversalTable.h"
 
 namespace galsim {
 
+    //
+    //
+    //
+    //VonKarmanUniversalTable
+    //
+    //
+    //
+
+    // The radial profile of a VonKarman depends on lam only through its scale size:
+    //     f(r; lam, L0) = h(r/lam_arcsec; L0) / lam_arcsec^2
+    // (with lam and L0 in units of r0), so a table of the dimensionless profile h(u; L0) at a
+    // grid of values of L0 can be used to get the profile for any lam and L0 without doing any
+    // Hankel transforms.  Values between grid points use 4-point Lagrange interpolation in
+    // log(L0).  The grid points are spaced by 0.025 in log10(L0) over 25 <= L0 <= 1.e5 and are
+    // built as they are needed.  The interpolation error is < 3.e-6 of f(0), so the table is
+    // always used if xvalue_accuracy is at least this large.  Otherwise, or outside of this
+    // range of L0, the Hankel transforms are done directly as before.
+    class VonKarmanUniversalTable
+    {
+    public:
+        VonKarmanUniversalTable(const GSParamsPtr& gsparams);
+
+        ~VonKarmanUniversalTable() {}
+
+        // The tabulated profile at one grid point, in units of its own scale size.
+        // cf. buildNode for details.
+        struct Node
+        {
+            double scale;
+            std::vector<double> u;
+            std::vector<double> h;
+            shared_ptr<Table> table;
+        };
+
+        // Get the nodes and weights to use for this value of L0.  Returns the number of nodes
+        // (up to 4), or 0 if the table should not be used for this L0.
+        int getNodes(double L0, shared_ptr<const Node>* nodes, double* w) const;
+
+        // Write all the nodes that have been built so far, or read them back in.
+        void write(std::ostream& os) const;
+        void read(std::istream& is);
+
+        // The number of nodes that have been built (rather than read in).
+        int getNBuilt() const { return _grid.nbuilt(); }
+
+        // Get the table to use for a given GSParams.
+        static shared_ptr<VonKarmanUniversalTable> Get(const GSParamsPtr& gsparams);
+
+        // Release the tables for all GSParams.
+        static void Clear();
+
+    private:
+        VonKarmanUniversalTable(const VonKarmanUniversalTable& rhs); ///<Hide the copy constructor
+        void operator=(const VonKarmanUniversalTable& rhs); ///<Hide the assignment operator
+
+        shared_ptr<const Node> buildNode(int i) const;
+
+        GSParamsPtr _gsparams;
+        mutable UniversalTableGrid<Node> _grid;
+
+        static LRUCache<GSParamsPtr,VonKarmanUniversalTable> cache;
+    };
+
     //
     //
     //
@@ -45,13 +111,14 @@ namespace galsim {
         ~VonKarmanInfo() {}
 
         double stepK() const {
-            if(_stepk == 0.0) _buildRadialFunc();
+            // Unless force_stepk was given, stepk is computed along with the radial function.
+            if (!_force_stepk) checkRadialFunc();
             return _stepk;
         }
         double maxK() const { return _maxk; }
         double getDelta() const { return _delta; }
         double getHalfLightRadius() const {
-            if (!_radial.finalized()) _buildRadialFunc();
+            checkRadialFunc();
             return _hlr;
         }
 
@@ -62,6 +129,9 @@ namespace galsim {
 
         double kValueNoTrunc(double) const;
         double rawXValue(double) const;
+        void rawXValueMany(const double* r, double* val, int n) const;
+        double tableXValue(const shared_ptr<const VonKarmanUniversalTable::Node>* nodes,
+                           const double* w, int nn, double r) const;
 
     private:
         VonKarmanInfo(const VonKarmanInfo& rhs); ///<Hide the copy constructor
@@ -72,6 +142,7 @@ namespace galsim {
         double _L0_invcuberoot;  // (r0/L0)^(1/3)
         double _L053; // (r0/L0)^(-5/3)
         mutable double _stepk;
+        bool _force_stepk;
         double _maxk;
         double _delta;
         double _deltaScale;  // 1/(1-_delta)
@@ -83,7 +154,9 @@ namespace galsim {
 
         mutable TableBuilder _radial;
         mutable shared_ptr<OneDimensionalDeviate> _sampler;
+        mutable std::atomic<bool> _radial_ready;
 
+        void checkRadialFunc() const;
         void _buildRadialFunc() const;
     };
 
@@ -136,6 +209,7 @@ namespace galsim {
         double xValue(double r) const;
         std::complex<double> kValue(const Position<double>& p) const;
         double kValue(double k) const;
+        void kValueRadialMany(const double* ksq, double* val, int n) const;
 
         double structureFunction(double rho) const;
 
@@ -168,6 +242,23 @@ namespace galsim {
 
         shared_ptr<VonKarmanInfo> _info;
 
+        void doFillKImage(ImageView<std::complex<double> > im,
+                          double kx0, double dkx, int izero,
+                          double ky0, double dky, int jzero) const
+        { fillKImage(im,kx0,dkx,izero,ky0,dky,jzero); }
+        void doFillKImage(ImageView<std::complex<double> > im,
+                          double kx0, double dkx, double dkxy,
+                          double ky0, double dky, double dkyx) const
+        { fillKImage(im,kx0,dkx,dkxy,ky0,dky,dkyx); }
+        void doFillKImage(ImageView<std::complex<float> > im,
+                          double kx0, double dkx, int izero,
+                          double ky0, double dky, int jzero) const
+        { fillKImage(im,kx0,dkx,izero,ky0,dky,jzero); }
+        void doFillKImage(ImageView<std::complex<float> > im,
+                          double kx0, double dkx, double dkxy,
+                          double ky0, double dky, double dkyx) const
+        { fillKImage(im,kx0,dkx,dkxy,ky0,dky,dkyx); }
+
         // Copy constructor and op= are undefined.
         SBVonKarmanImpl(const SBVonKarmanImpl& rhs);
         void operator=(const SBVonKarmanImpl& rhs);
@@ -0,0 +1,202 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2023 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+#ifndef GalSim_UniversalTable_H
+#define GalSim_UniversalTable_H
+
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <cmath>
+#include "Std.h"
+#include "GSParams.h"
+#include "SBProfile.h"
+
+namespace galsim {
+
+    // The universal tables in SBVonKarman and SBSecondKick tabulate a dimensionless profile at
+    // a grid of values of one parameter (L0 or kcrit) and interpolate between these nodes.
+    // This class holds the nodes and does the parts that are the same for both: the
+    // interpolation weights, building the nodes as they are needed, and keeping track of how
+    // many nodes have been built.
+    template <typename Node>
+    class UniversalTableGrid
+    {
+    public:
+        // n is the number of grid points.
+        UniversalTableGrid(int n) : _nodes(n), _nbuilt(0) {}
+
+        int size() const { return int(_nodes.size()); }
+
+        // Get the interpolation weights for a fractional grid index t.  If t is a grid point,
+        // that node is used by itself.  Otherwise, use 4-point Lagrange interpolation.
+        // Returns the number of nodes to use (1 or 4), starting at i0, or 0 if t is outside
+        // the grid.
+        int getWeights(double t, int& i0, double* w) const
+        {
+            const int n = size();
+            if (!(t >= 0. && t <= n-1)) return 0;
+            if (std::abs(t - std::floor(t+0.5)) < 1.e-8) {
+                i0 = int(std::floor(t+0.5));
+                w[0] = 1.;
+                return 1;
+            } else {
+                i0 = std::min(std::max(int(t)-1, 0), n-4);
+                double s = t - i0;
+                w[0] = -(s-1.)*(s-2.)*(s-3.)/6.;
+                w[1] = s*(s-2.)*(s-3.)/2.;
+                w[2] = -s*(s-1.)*(s-3.)/2.;
+                w[3] = s*(s-1.)*(s-2.)/6.;
+                return 4;
+            }
+        }
+
+        // Get nodes i0..i0+nn-1, building any that are missing by calling build(i).
+        // The missing nodes are built outside of the critical section, so other threads
+        // don't have to wait for them.  If two threads build the same node, the first
+        // one to finish is kept.  Either way, the node values are the same, so the result
+        // doesn't depend on which profiles were made before this one.
+        template <typename F>
+        void getNodes(int i0, int nn, F build, shared_ptr<const Node>* nodes)
+        {
+            std::vector<int> todo;
+#ifdef _OPENMP
+#pragma omp critical (galsim_universal_table)
+#endif
+            {
+                for (int k=0; k<nn; ++k)
+                    if (!_nodes[i0+k]) todo.push_back(i0+k);
+            }
+            for (size_t n=0; n<todo.size(); ++n) setIfMissing(todo[n], build(todo[n]));
+#ifdef _OPENMP
+#pragma omp critical (galsim_universal_table)
+#endif
+            {
+                for (int k=0; k<nn; ++k) nodes[k] = _nodes[i0+k];
+            }
+        }
+
+        // The number of nodes that were built here.  (Nodes that were read in from a file
+        // with set are not included.)
+        int nbuilt() const
+        {
+            int nbuilt;
+#ifdef _OPENMP
+#pragma omp critical (galsim_universal_table)
+#endif
+            {
+                nbuilt = _nbuilt;
+            }
+            return nbuilt;
+        }
+
+        // The indices of the nodes that are not built yet.
+        std::vector<int> missing() const
+        {
+            std::vector<int> todo;
+#ifdef _OPENMP
+#pragma omp critical (galsim_universal_table)
+#endif
+            {
+                for (int i=0; i<size(); ++i)
+                    if (!_nodes[i]) todo.push_back(i);
+            }
+            return todo;
+        }
+
+        // A copy of all the nodes, with null pointers for the ones not built yet.
+        std::vector<shared_ptr<const Node> > getAll() const
+        {
+            std::vector<shared_ptr<const Node> > nodes;
+#ifdef _OPENMP
+#pragma omp critical (galsim_universal_table)
+#endif
+            {
+                nodes = _nodes;
+            }
+            return nodes;
+        }
+
+        void set(int i, const shared_ptr<const Node>& node)
+        {
+#ifdef _OPENMP
+#pragma omp critical (galsim_universal_table)
+#endif
+            {
+                _nodes[i] = node;
+            }
+        }
+
+        // Set a node that was built here, unless another thread already did so.
+        void setIfMissing(int i, const shared_ptr<const Node>& node)
+        {
+#ifdef _OPENMP
+#pragma omp critical (galsim_universal_table)
+#endif
+            {
+                if (!_nodes[i]) {
+                    _nodes[i] = node;
+                    ++_nbuilt;
+                }
+            }
+        }
+
+    private:
+        std::vector<shared_ptr<const Node> > _nodes;
+        int _nbuilt;
+    };
+
+    // The universal table files start with the name of the table, a format version, and the
+    // GSParams that were used to build it.  Files from a different version or GSParams are
+    // rejected, since their nodes would not match the ones that would be built here.
+    inline std::string UniversalTableGSParams(const GSParams& gsparams)
+    {
+        std::ostringstream oss;
+        oss.precision(17);
+        oss << gsparams;
+        return oss.str();
+    }
+
+    inline void WriteUniversalTableHeader(
+        std::ostream& os, const std::string& name, int version, const GSParams& gsparams)
+    {
+        os << "# GalSim " << name << " table\n";
+        os << "# version " << version << "\n";
+        os << "# gsparams " << UniversalTableGSParams(gsparams) << "\n";
+    }
+
+    inline void ReadUniversalTableHeader(
+        std::istream& is, const std::string& name, int version, const GSParams& gsparams)
+    {
+        std::ostringstream v;
+        v << "# version " << version;
+        std::string line1, line2, line3;
+        std::getline(is, line1);
+        std::getline(is, line2);
+        std::getline(is, line3);
+        if (!is || line1 != "# GalSim " + name + " table" || line2 != v.str())
+            throw SBError("Invalid " + name + " table file");
+        if (line3 != "# gsparams " + UniversalTableGSParams(gsparams))
+            throw SBError(name + " table file was built with different GSParams");
+    }
+
+}
+
+#endif
@@ -29,6 +29,18 @@ namespace galsim {
         int n, int nab, const double* u, const double* v, const double* ab,
         double* x, double* y, bool doiter, int nabp, const double* abp);
 
+    // Like InvertAB, but use a precomputed table of the inverse to get a starting guess
+    // that usually only needs a single Newton step.  Points whose residual after that step
+    // is too large continue with the full iteration; the number of these is returned.
+    // The table has values xgrid[i*nv+j], ygrid[i*nv+j] at (u0 + i*du, v0 + j*dv) for
+    // 0 <= i < nu, 0 <= j < nv.  Points outside of this range are done with InvertAB,
+    // using abp (if provided) for the initial guess.
+    PUBLIC_API int InvertABTable(
+        int n, int nab, const double* u, const double* v, const double* ab,
+        double* x, double* y, int nabp, const double* abp,
+        int nu, int nv, double u0, double v0, double du, double dv,
+        const double* xgrid, const double* ygrid);
+
 }
 
 #endif
@@ -0,0 +1,59 @@
+/* -*- c++ -*-
+ * Copyright (c) 2012-2023 by the GalSim developers team on GitHub
+ * https://github.com/GalSim-developers
+ *
+ * This file is part of GalSim: The modular galaxy image simulation toolkit.
+ * https://github.com/GalSim-developers/GalSim
+ *
+ * GalSim is free software: redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided that the following
+ * conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions, and the disclaimer given in the accompanying LICENSE
+ *    file.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions, and the disclaimer given in the documentation
+ *    and/or other materials provided with the distribution.
+ */
+
+#ifndef GalSim_ApplyMany_H
+#define GalSim_ApplyMany_H
+/**
+ * @file math/ApplyMany.h
+ * @brief A helper to evaluate a scalar function over an array, using OpenMP when available.
+ */
+
+#include <exception>
+
+namespace galsim {
+namespace math {
+
+    // Apply f to each of n values of x, storing the results in y.  Large arrays are split
+    // across threads.  An exception can't propagate out of an OpenMP parallel region, so the
+    // first one thrown is saved and rethrown after the loop.
+    template <typename F>
+    inline void ApplyMany(F f, const double* x, double* y, int n)
+    {
+        std::exception_ptr eptr;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (n >= 1024)
+#endif
+        for (int i=0; i<n; ++i) {
+            try {
+                y[i] = f(x[i]);
+            } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical (galsim_apply_many)
+#endif
+                {
+                    if (!eptr) eptr = std::current_exception();
+                }
+            }
+        }
+        if (eptr) std::rethrow_exception(eptr);
+    }
+
+} }
+
+#endif
@@ -39,6 +39,15 @@ namespace math {
     PUBLIC_API double j0(double x);
     PUBLIC_API double j1(double x);
 
+    // Array versions of the above, which evaluate the function at n values of x for
+    // a single value of nu.
+    PUBLIC_API void cyl_bessel_j_many(double nu, const double* x, double* y, int n);
+    PUBLIC_API void cyl_bessel_y_many(double nu, const double* x, double* y, int n);
+    PUBLIC_API void cyl_bessel_k_many(double nu, const double* x, double* y, int n);
+    PUBLIC_API void cyl_bessel_i_many(double nu, const double* x, double* y, int n);
+    PUBLIC_API void j0_many(const double* x, double* y, int n);
+    PUBLIC_API void j1_many(const double* x, double* y, int n);
+
     PUBLIC_API double getBesselRoot0(int s);
     PUBLIC_API double getBesselRoot(double nu, int s);
 
@@ -37,6 +37,9 @@ namespace math {
     // cf. http://mathworld.wolfram.com/RegularizedGammaFunction.html
     PUBLIC_API double gamma_p(double a, double x);
 
+    // Evaluate gamma_p(a, x) at n values of x.
+    PUBLIC_API void gamma_p_many(double a, const double* x, double* y, int n);
+
 
 } }
 
@@ -33,6 +33,14 @@ namespace math {
         const std::function<double(double)> f, double k, double nu,
         double relerr=1.e-6, double abserr=1.e-12, int nzeros=10);
 
+    // Compute hankel_inf at n values of k at once.  Rather than calling f separately for
+    // each k, f is tabulated on a grid in log(r) with spacing dlogr, which is shared by all the
+    // transforms.  The interpolation error in f is O(dlogr^4 d^4f/dlogr^4), so dlogr should be
+    // chosen such that this is small compared to abserr.
+    PUBLIC_API void hankel_inf_many(
+        const std::function<double(double)> f, const double* k, double* result, int n,
+        double nu, double dlogr, double relerr=1.e-6, double abserr=1.e-12, int nzeros=10);
+
 }
 }
 
@@ -25,6 +25,23 @@
 namespace galsim {
 namespace math {
 
+    // Helpers for the array versions, which take the numpy data pointers as size_t.
+    template <void (*fn)(double, const double*, double*, int)>
+    static void CallMany(double nu, size_t ix, size_t iy, int n)
+    {
+        const double* x = reinterpret_cast<const double*>(ix);
+        double* y = reinterpret_cast<double*>(iy);
+        fn(nu, x, y, n);
+    }
+
+    template <void (*fn)(const double*, double*, int)>
+    static void CallMany0(size_t ix, size_t iy, int n)
+    {
+        const double* x = reinterpret_cast<const double*>(ix);
+        double* y = reinterpret_cast<double*>(iy);
+        fn(x, y, n);
+    }
+
     void pyExportBessel(py::module& _galsim)
     {
         _galsim.def("j0_root", &getBesselRoot0);
@@ -36,6 +53,14 @@ namespace math {
         _galsim.def("iv", &cyl_bessel_i);
         _galsim.def("kv", &cyl_bessel_k);
 
+        _galsim.def("j0Many", &CallMany0<j0_many>);
+        _galsim.def("j1Many", &CallMany0<j1_many>);
+        _galsim.def("jvMany", &CallMany<cyl_bessel_j_many>);
+        _galsim.def("yvMany", &CallMany<cyl_bessel_y_many>);
+        _galsim.def("ivMany", &CallMany<cyl_bessel_i_many>);
+        _galsim.def("kvMany", &CallMany<cyl_bessel_k_many>);
+        _galsim.def("gammaincMany", &CallMany<gamma_p_many>);
+
         // Include a few other (non-Bessel) math items of similar utility.
         _galsim.def("gammainc", &gamma_p);
         _galsim.def("sinc", &sinc);
@@ -85,6 +85,11 @@ namespace galsim {
 
         _galsim.def("goodFFTSize", &goodFFTSize);
         _galsim.def("ClearDepixelizeCache", &ClearDepixelizeCache);
+        _galsim.def("GetScratchBytesRequested", &GetScratchBytesRequested);
+        _galsim.def("GetScratchBytesAllocated", &GetScratchBytesAllocated);
+        _galsim.def("ResetScratchCounters", &ResetScratchCounters);
+        _galsim.def("GetScratchBytesPooled", &GetScratchBytesPooled);
+        _galsim.def("ClearScratchPool", &ClearScratchPool);
     }
 
 } // namespace galsim
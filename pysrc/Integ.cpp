@@ -59,13 +59,15 @@ namespace integ {
 
     // Integrate a python function using int1d.
     void PyHankel(const py::function& func, size_t ik, size_t ires, int N,
-                  double nu, double rmax,
+                  double nu, double rmax, double dlogr,
                   double rel_err=DEFRELERR, double abs_err=DEFABSERR)
     {
         const double* k = reinterpret_cast<const double*>(ik);
         double* res = reinterpret_cast<double*>(ires);
         PyFunc pyfunc(func);
-        if (rmax == 0.) {
+        if (rmax == 0. && dlogr > 0.) {
+            math::hankel_inf_many(pyfunc, k, res, N, nu, dlogr, rel_err, abs_err);
+        } else if (rmax == 0.) {
             for (int i=0; i<N; ++i) {
                 res[i] = math::hankel_inf(pyfunc, k[i], nu, rel_err, abs_err);
             }
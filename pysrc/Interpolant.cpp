@@ -35,6 +35,19 @@ namespace galsim {
         interp.uvalMany(vals, N);
     }
 
+    static void XvalTaps(const Interpolant& interp, double f, int k1, int k2, size_t iwts)
+    {
+        double* wts = reinterpret_cast<double*>(iwts);
+        interp.xvalTaps(f, k1, k2, wts);
+    }
+
+    static double Interpolate2d(const Interpolant& interp, size_t idata, int nx, int ny,
+                                int stride, double x, double y)
+    {
+        const double* data = reinterpret_cast<const double*>(idata);
+        return interp.interpolate2d(data, nx, ny, stride, x, y);
+    }
+
     void pyExportInterpolant(py::module& _galsim)
     {
         py::class_<Interpolant >(_galsim, "Interpolant")
@@ -42,6 +55,9 @@ namespace galsim {
             .def("uval", &Interpolant::uval)
             .def("xvalMany", &XvalMany)
             .def("uvalMany", &UvalMany)
+            .def("nTaps", &Interpolant::nTaps)
+            .def("xvalTaps", &XvalTaps)
+            .def("interpolate2d", &Interpolate2d)
             .def("getPositiveFlux", &Interpolant::getPositiveFlux)
             .def("getNegativeFlux", &Interpolant::getNegativeFlux)
             .def("urange", &Interpolant::urange);
@@ -34,6 +34,10 @@ namespace galsim {
                  double, const Interpolant&, GSParams>());
 
         _galsim.def("CalculateSizeContainingFlux", &CalculateSizeContainingFlux);
+        _galsim.def("ClearInterpolatedImageCache", &ClearInterpolatedImageCache);
+        _galsim.def("GetInterpolatedImageCacheSize", &GetInterpolatedImageCacheSize);
+        _galsim.def("GetInterpolatedImageCacheBytes", &GetInterpolatedImageCacheBytes);
+        _galsim.def("SetInterpolatedImageCacheMaxBytes", &SetInterpolatedImageCacheMaxBytes);
     }
 
 } // namespace galsim
@@ -39,6 +39,22 @@ namespace galsim {
         prof.drawK(image, dx, jac);
     }
 
+    static void XValueMany(const SBProfile& prof, size_t ix, size_t iy, size_t ival, int N)
+    {
+        const double* x = reinterpret_cast<const double*>(ix);
+        const double* y = reinterpret_cast<const double*>(iy);
+        double* val = reinterpret_cast<double*>(ival);
+        prof.xValueMany(x, y, val, N);
+    }
+
+    static void KValueMany(const SBProfile& prof, size_t ikx, size_t iky, size_t ikval, int N)
+    {
+        const double* kx = reinterpret_cast<const double*>(ikx);
+        const double* ky = reinterpret_cast<const double*>(iky);
+        std::complex<double>* kval = reinterpret_cast<std::complex<double>*>(ikval);
+        prof.kValueMany(kx, ky, kval, N);
+    }
+
     template <typename T, typename W>
     static void WrapTemplates(W& wrapper)
     {
@@ -47,6 +63,9 @@ namespace galsim {
         typedef void (*drawK_func)(const SBProfile&, ImageView<std::complex<T> >, double, size_t);
         wrapper.def("draw", (draw_func)&SBPdraw);
         wrapper.def("drawK", (drawK_func)&SBPdrawK);
+        typedef void (*drawKMany_func)(const std::vector<SBProfile>&, const std::vector<double>&,
+                                       std::vector<ImageView<std::complex<T> > >, double);
+        wrapper.def_static("drawKMany", (drawKMany_func)&SBProfile::drawKMany);
     }
 
     void pyExportSBProfile(py::module& _galsim)
@@ -60,6 +79,8 @@ namespace galsim {
         pySBProfile
             .def("xValue", &SBProfile::xValue)
             .def("kValue", &SBProfile::kValue)
+            .def("xValueMany", &XValueMany)
+            .def("kValueMany", &KValueMany)
             .def("maxK", &SBProfile::maxK)
             .def("stepK", &SBProfile::stepK)
             .def("centroid", &SBProfile::centroid)
@@ -67,7 +88,8 @@ namespace galsim {
             .def("getPositiveFlux", &SBProfile::getPositiveFlux)
             .def("getNegativeFlux", &SBProfile::getNegativeFlux)
             .def("maxSB", &SBProfile::maxSB)
-            .def("shoot", &SBProfile::shoot);
+            .def("shoot", &SBProfile::shoot)
+            .def("shootChunks", &SBProfile::shootChunks);
         WrapTemplates<float>(pySBProfile);
         WrapTemplates<double>(pySBProfile);
     }
@@ -28,6 +28,11 @@ namespace galsim {
             .def(py::init<double,double,double,GSParams>())
             .def("getDelta", &SBSecondKick::getDelta)
             .def("structureFunction", &SBSecondKick::structureFunction);
+
+        _galsim.def("WriteSecondKickTable", &WriteSecondKickTable);
+        _galsim.def("ReadSecondKickTable", &ReadSecondKickTable);
+        _galsim.def("ClearSecondKickTables", &ClearSecondKickTables);
+        _galsim.def("GetSecondKickTableNBuilt", &GetSecondKickTableNBuilt);
     }
 
 } // namespace galsim
@@ -51,6 +51,7 @@ namespace galsim {
             .def(py::init(&construct));
 
         _galsim.def("ShapeletFitImage", &fit);
+        _galsim.def("ClearShapeletFitCache", &ClearShapeletFitCache);
     }
 
 } // namespace galsim
@@ -29,6 +29,11 @@ namespace galsim {
             .def("getDelta", &SBVonKarman::getDelta)
             .def("getHalfLightRadius", &SBVonKarman::getHalfLightRadius)
             .def("structureFunction", &SBVonKarman::structureFunction);
+
+        _galsim.def("WriteVonKarmanTable", &WriteVonKarmanTable);
+        _galsim.def("ReadVonKarmanTable", &ReadVonKarmanTable);
+        _galsim.def("ClearVonKarmanTables", &ClearVonKarmanTables);
+        _galsim.def("GetVonKarmanTableNBuilt", &GetVonKarmanTableNBuilt);
     }
 
 } // namespace galsim
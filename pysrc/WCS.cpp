@@ -43,10 +43,28 @@ namespace galsim {
         InvertAB(n, nab, u, v, ab, x, y, doiter, nabp, abp);
     }
 
+    int CallInvertABTable(int n, int nab, size_t u_data, size_t v_data, size_t ab_data,
+                          size_t x_data, size_t y_data, int nabp, size_t abp_data,
+                          int nu, int nv, double u0, double v0, double du, double dv,
+                          size_t xgrid_data, size_t ygrid_data)
+    {
+        const double* u = reinterpret_cast<const double*>(u_data);
+        const double* v = reinterpret_cast<const double*>(v_data);
+        const double* ab = reinterpret_cast<const double*>(ab_data);
+        const double* abp = reinterpret_cast<const double*>(abp_data);
+        const double* xgrid = reinterpret_cast<const double*>(xgrid_data);
+        const double* ygrid = reinterpret_cast<const double*>(ygrid_data);
+        double* x = reinterpret_cast<double*>(x_data);
+        double* y = reinterpret_cast<double*>(y_data);
+        return InvertABTable(n, nab, u, v, ab, x, y, nabp, abp, nu, nv, u0, v0, du, dv,
+                             xgrid, ygrid);
+    }
+
     void pyExportWCS(py::module& _galsim)
     {
         _galsim.def("ApplyCD", &CallApplyCD);
         _galsim.def("InvertAB", &CallInvertAB);
+        _galsim.def("InvertABTable", &CallInvertABTable);
     }
 
 } // namespace galsim
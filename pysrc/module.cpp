@@ -49,6 +49,7 @@ namespace galsim {
     void pyExportTable(py::module&);
     void pyExportInterpolant(py::module&);
     void pyExportCDModel(py::module&);
+    void pyExportCorrelatedNoise(py::module&);
     void pyExportSilicon(py::module&);
     void pyExportRealGalaxy(py::module&);
     void pyExportWCS(py::module&);
@@ -99,6 +100,7 @@ PYBIND11_MODULE(_galsim, _galsim)
     galsim::pyExportTable(_galsim);
     galsim::pyExportInterpolant(_galsim);
     galsim::pyExportCDModel(_galsim);
+    galsim::pyExportCorrelatedNoise(_galsim);
     galsim::pyExportSilicon(_galsim);
     galsim::pyExportRealGalaxy(_galsim);
     galsim::pyExportWCS(_galsim);
@@ -17,10 +17,37 @@
  *    and/or other materials provided with the distribution.
  */
 
+#include <vector>
+#include <algorithm>
+
 #include "CDModel.h"
 
 namespace galsim {
 
+    // The number of pixels along a row to process at a time.  The inner loops read 2dmax+1
+    // rows of the input image over this many columns, which should stay in cache.
+    const int cd_tile_size = 256;
+
+    // The inner loop of ApplyCDModel for the pixels where all the neighboring pixels exist.
+    // useT and useB are template parameters, so the compiler can make a separate, branch-free
+    // loop for each case.
+    template <bool useT, bool useB, typename T>
+    static inline void CDInnerLoop(double* f, const double* fT, const double* fB,
+                                   const double* fL, const double* fR,
+                                   const T* q, int step, int k1, int k2, double gain_ratio,
+                                   double cT, double cB, double cL, double cR)
+    {
+        for(int k=k1; k<=k2; k++){
+            double qkl = q[k*step] * gain_ratio;
+            double fk = f[k];
+            if (useT) fk += qkl * fT[k] * cT;
+            if (useB) fk += qkl * fB[k] * cB;
+            fk += qkl * fL[k] * cL;
+            fk += qkl * fR[k] * cR;
+            f[k] = fk;
+        }
+    }
+
     template <typename T>
     void ApplyCDModel(ImageView<T>& output, const BaseImage<T>& input,
                       const BaseImage<double>& aL, const BaseImage<double>& aR,
@@ -40,48 +67,133 @@ namespace galsim {
         //        (1)   input +
         //        (2)   interpolated version of image at pixel borders *
         //        (3)   image convolved with shift coefficients
+        //
+        // The image is processed a row at a time, in tiles of cd_tile_size pixels along the
+        // row.  For each tile, we loop over the shift coefficients on the outside and the pixels
+        // on the inside, so the inner loops run along rows of the input image.  Each output
+        // pixel still accumulates the terms in the same order as a direct double loop over the
+        // coefficients would, so the result is identical.
+
+        const int xmin = input.getXMin();
+        const int xmax = input.getXMax();
+        const int ymin = input.getYMin();
+        const int ymax = input.getYMax();
+        const int instep = input.getStep();
+        const int instride = input.getStride();
+        const int outstep = output.getStep();
+        const int outstride = output.getStride();
+        const T* indata = input.getData();
+        T* outdata = output.getData() + (xmin-output.getXMin()) * outstep
+            + (ymin-output.getYMin()) * outstride;
+
+        // Copy the coefficients into plain arrays, indexed by (iy+dmax)*nd + (ix+dmax).
+        const int nd = 2*dmax+1;
+        std::vector<double> cL(nd*nd), cR(nd*nd), cB(nd*nd), cT(nd*nd);
+        for(int iy=-dmax; iy<=dmax; iy++){
+            for(int ix=-dmax; ix<=dmax; ix++){
+                int k = (iy+dmax)*nd + ix+dmax;
+                cL[k] = aL(ix+dmax+1, iy+dmax+1);
+                cR[k] = aR(ix+dmax+1, iy+dmax+1);
+                cB[k] = aB(ix+dmax+1, iy+dmax+1);
+                cT[k] = aT(ix+dmax+1, iy+dmax+1);
+            }
+        }
 
-        for(int x=input.getXMin(); x<=input.getXMax(); x++){
-            for(int y=input.getYMin(); y<=input.getYMax(); y++){
-
-                // (1) input image
-                double f = input(x, y);
-
-                // (2) interpolated version of image at pixel borders
-                double fT = 0.; if(y < input.getYMax()) fT = (f + input(x, y + 1)) / 2.;
-                double fB = 0.; if(y > input.getYMin()) fB = (f + input(x, y - 1)) / 2.;
-                double fR = 0.; if(x < input.getXMax()) fR = (f + input(x + 1, y)) / 2.;
-                double fL = 0.; if(x > input.getXMin()) fL = (f + input(x - 1, y)) / 2.;
+        const int ntile = (xmax-xmin) / cd_tile_size + 1;
+        const int nrow = ymax-ymin+1;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<double> f(cd_tile_size), fT(cd_tile_size), fB(cd_tile_size),
+                fL(cd_tile_size), fR(cd_tile_size);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+            for(int itile=0; itile<ntile*nrow; itile++){
+                const int y = ymin + itile / ntile;
+                const int x1 = xmin + (itile % ntile) * cd_tile_size;
+                const int x2 = std::min(x1 + cd_tile_size - 1, xmax);
+                const int n = x2-x1+1;
+                // Pointers to input(x1,y), so that in[k*instep] is input(x1+k,y).
+                const T* in = indata + (x1-xmin) * instep + (y-ymin) * instride;
+                T* out = outdata + (x1-xmin) * outstep + (y-ymin) * outstride;
+
+                for(int k=0; k<n; k++){
+                    const int x = x1+k;
+
+                    // (1) input image
+                    f[k] = in[k*instep];
+
+                    // (2) interpolated version of image at pixel borders
+                    fT[k] = 0.; if(y < ymax) fT[k] = (f[k] + in[k*instep + instride]) / 2.;
+                    fB[k] = 0.; if(y > ymin) fB[k] = (f[k] + in[k*instep - instride]) / 2.;
+                    fR[k] = 0.; if(x < xmax) fR[k] = (f[k] + in[(k+1)*instep]) / 2.;
+                    fL[k] = 0.; if(x > xmin) fL[k] = (f[k] + in[(k-1)*instep]) / 2.;
+                }
 
                 // (3) convolution of image with shift coefficient matrix
-                for(int iy=-dmax; iy<=dmax; iy++){
-                    for(int ix=-dmax; ix<=dmax; ix++){
+                // Rows that don't exist are not going to move us.
+                for(int iy=std::max(-dmax, ymin-y); iy<=std::min(dmax, ymax-y); iy++){
+                    // don't apply shift if pixel mirrored at t or b border non-existent
+                    const bool useT = (y + 1 - iy >= ymin && y + 1 - iy <= ymax);
+                    const bool useB = (y - 1 - iy >= ymin && y - 1 - iy <= ymax);
 
-                        if(x+ix<input.getXMin() || x+ix>input.getXMax() ||
-                           y+iy<input.getYMin() || y+iy>input.getYMax()) {
-                            continue; // a non-existent pixel is not going to move us
+                    for(int ix=-dmax; ix<=dmax; ix++){
+                        const int kc = (iy+dmax)*nd + ix+dmax;
+                        const double cTk = cT[kc];
+                        const double cBk = cB[kc];
+                        const double cLk = cL[kc];
+                        const double cRk = cR[kc];
+                        const T* q = in + ix * instep + iy * instride;
+
+                        // The range of k for which input(x+ix, y+iy) exists.
+                        const int k1 = std::max(0, xmin-ix-x1);
+                        const int k2 = std::min(n-1, xmax-ix-x1);
+                        // The range within that where the pixels mirrored at both the l and r
+                        // borders exist too.
+                        const int k3 = std::max(k1, xmin+1+ix-x1);
+                        const int k4 = std::min(k2, xmax-1+ix-x1);
+
+                        for(int k=k1; k<=k2; k++){
+                            if (k == k3 && k3 <= k4) {
+                                // The bulk of the row has no bounds checks.
+                                if (useT && useB)
+                                    CDInnerLoop<true,true>(&f[0], &fT[0], &fB[0], &fL[0], &fR[0],
+                                                           q, instep, k3, k4, gain_ratio,
+                                                           cTk, cBk, cLk, cRk);
+                                else if (useT)
+                                    CDInnerLoop<true,false>(&f[0], &fT[0], &fB[0], &fL[0], &fR[0],
+                                                            q, instep, k3, k4, gain_ratio,
+                                                            cTk, cBk, cLk, cRk);
+                                else if (useB)
+                                    CDInnerLoop<false,true>(&f[0], &fT[0], &fB[0], &fL[0], &fR[0],
+                                                            q, instep, k3, k4, gain_ratio,
+                                                            cTk, cBk, cLk, cRk);
+                                else
+                                    CDInnerLoop<false,false>(&f[0], &fT[0], &fB[0], &fL[0], &fR[0],
+                                                             q, instep, k3, k4, gain_ratio,
+                                                             cTk, cBk, cLk, cRk);
+                                k = k4+1;
+                                if (k > k2) break;
+                            }
+                            const int x = x1+k;
+                            double qkl = q[k*instep] * gain_ratio;
+                            if (useT) f[k] += qkl * fT[k] * cTk;
+                            if (useB) f[k] += qkl * fB[k] * cBk;
+                            if(x - 1 - ix >= xmin && x - 1 - ix <= xmax)
+                                // don't apply shift if pixel mirrored at l border non-existent
+                                f[k] += qkl * fL[k] * cLk;
+                            if(x + 1 - ix >= xmin && x + 1 - ix <= xmax)
+                                // don't apply shift if pixel mirrored at r border non-existent
+                                f[k] += qkl * fR[k] * cRk;
                         }
-                        double qkl = input(x + ix, y + iy) * gain_ratio;
-
-                        if(y + 1 - iy >= input.getYMin() && y + 1 - iy <= input.getYMax())
-                            // don't apply shift if pixel mirrored at t border non-existent
-                            f += qkl * fT * aT(ix+dmax+1, iy+dmax+1);
-
-                        if(y - 1 - iy >= input.getYMin() && y - 1 - iy <= input.getYMax())
-                            // don't apply shift if pixel mirrored at b border non-existent
-                            f += qkl * fB * aB(ix+dmax+1, iy+dmax+1);
-
-                        if(x - 1 - ix >= input.getXMin() && x - 1 - ix <= input.getXMax())
-                            // don't apply shift if pixel mirrored at l border non-existent
-                            f += qkl * fL * aL(ix+dmax+1, iy+dmax+1);
-
-                        if(x + 1 - ix >= input.getXMin() && x + 1 - ix <= input.getXMax())
-                            // don't apply shift if pixel mirrored at r border non-existent
-                            f += qkl * fR * aR(ix+dmax+1, iy+dmax+1);
-
                     }
                 }
-                output(x, y) = f;
+
+                for(int k=0; k<n; k++) out[k*outstep] = f[k];
             }
         }
     }
@@ -17,10 +17,44 @@
  *    and/or other materials provided with the distribution.
  */
 
+#include <vector>
+
 #include "CorrelatedNoise.h"
 
 namespace galsim {
 
+    /*
+     * Tabulate the correlation function at each distinct pixel separation that appears in the
+     * covariance matrix for an image with the given bounds.
+     */
+    void calculateCovarianceLags(ImageView<double>& lags,
+        const SBProfile& sbp, const Bounds<int>& bounds, double dx)
+    {
+        int idim = 1 + bounds.getXMax() - bounds.getXMin();
+        int jdim = 1 + bounds.getYMax() - bounds.getYMin();
+
+        Bounds<int> lag_bounds(1-jdim, idim-1, 1-idim, jdim-1);
+        if (!(lags.getBounds() == lag_bounds))
+            throw ImageError("lags image does not have the required bounds");
+
+        // Evaluate all the lags with a single call to xValueMany.
+        const int nk = idim + jdim - 1;
+        const int n = nk * nk;
+        std::vector<double> x(n), y(n), val(n);
+        for (int ell=1-idim, i=0; ell<=jdim-1; ell++) {
+            for (int k=1-jdim; k<=idim-1; k++, i++) {
+                x[i] = double(k) * dx;
+                y[i] = double(ell) * dx;
+            }
+        }
+        sbp.xValueMany(&x[0], &y[0], &val[0], n);
+        for (int ell=1-idim, i=0; ell<=jdim-1; ell++) {
+            for (int k=1-jdim; k<=idim-1; k++, i++) {
+                lags(k, ell) = val[i];
+            }
+        }
+    }
+
     /*
      * Covariance matrix calculation using the input SBProfile, the dimensions of the image for
      * which a covariance matrix is desired (in the form of a Bounds), and a scale dx
@@ -33,20 +67,26 @@ namespace galsim {
         int jdim = 1 + bounds.getYMax() - bounds.getYMin();
         int covdim = idim * jdim;
 
-        int k, ell; // k and l are indices that refer to image pixel separation vectors in the
-                    // correlation func.
-        double x_k, y_ell; // physical vector separations in the correlation func, dx * k etc.
+        if (!cov.getBounds().includes(Bounds<int>(1, covdim, 1, covdim)))
+            throw ImageBoundsError(covdim, covdim, cov.getBounds());
 
+        // The correlation function only depends on the separation of the two pixels, so
+        // evaluate it once for each separation, and then just copy the values into the matrix.
+        ImageAlloc<double> lag_image(Bounds<int>(1-jdim, idim-1, 1-idim, jdim-1));
+        ImageView<double> lags = lag_image.view();
+        calculateCovarianceLags(lags, sbp, bounds, dx);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
         for (int i=1; i<=covdim; i++) {
+            int k, ell; // k and l are indices that refer to image pixel separation vectors in the
+                        // correlation func.
             for (int j=i; j<=covdim; j++) {
                 k = ((j - 1) / jdim) - ((i - 1) / idim);  // using integer division rules here
                 ell = ((j - 1) % jdim) - ((i - 1) % idim);
-                x_k = double(k) * dx;
-                y_ell = double(ell) * dx;
-                Position<double> p = Position<double>(x_k, y_ell);
-                cov.setValue(i, j, sbp.xValue(p));
+                cov(i, j) = lags(k, ell);
             }
-
         }
     }
 
@@ -22,6 +22,10 @@
 #include <sstream>
 #include <numeric>
 #include <cstring>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include <list>
 
 #include "fftw3.h"
 #include "fmath/fmath.hpp"  // Use their compiler checks for the right SSE to include.
@@ -116,28 +120,234 @@ BaseImage<T>::BaseImage(const Bounds<int>& b) :
     // Else _data is left as 0, step,stride = 0.
 }
 
-// A custom deleter that finds the original address of the memory allocation directly
-// before the stored pointer and frees that using delete []
+// Scratch memory pool.
+//
+// Most of the ImageAlloc (and temporary PhotonArray) allocations in the C++ layer are short-lived
+// scratch buffers that are made and destroyed once per component per draw (e.g. in SBAdd,
+// SBConvolve, fast_convolve_image_1).  Rather than going back to the heap each time, freed blocks
+// are kept on a per-thread free list, binned into size classes (4 per factor of 2 in size, so at
+// most 25% wasted space), and handed back out on the next request of the same class.
+//
+// Blocks may be freed on a different thread than they were allocated on.  That's fine; they
+// just go onto the free list of the thread that frees them.
+//
+// The pools are meant for the typical postage stamp sizes, so they are kept small: each thread
+// holds at most scratch_max_pool bytes, and all threads together at most scratch_max_total.
+
+namespace {
+
+    // Alignment of the returned memory.  64 bytes is a cache line, and is sufficient for any
+    // of the SIMD instruction sets that the compiler might use (or that FFTW wants).
+    const size_t scratch_align = 64;
+    // Smallest size class.  Smaller requests are rounded up to this.
+    const size_t scratch_min_bytes = 1024;
+    // The maximum number of bytes to hold on a single thread's free list.  Blocks larger
+    // than this are never pooled.
+    const size_t scratch_max_pool = 4 << 20;
+    // The maximum number of bytes to hold on the free lists of all threads combined.
+    const size_t scratch_max_total = 16 << 20;
+    // Enough classes to cover up to scratch_max_pool.
+    const int scratch_nclass = 4*12+1;
+
+    // This is stored directly before the aligned data pointer.
+    struct ScratchHeader
+    {
+        char* mem;      // The original allocation
+        int cls;        // The size class (or -1 if not pooled)
+    };
+
+    // Counters for diagnostics.  These are global (not per thread) so that the totals over
+    // all OpenMP threads can be read from Python after a draw.
+    std::atomic<size_t> scratch_bytes_requested(0);
+    std::atomic<size_t> scratch_bytes_allocated(0);
+    // The number of bytes currently held on all the free lists.
+    std::atomic<size_t> scratch_bytes_pooled(0);
+
+    // Returns the size class for nbytes, and sets cbytes to the size of that class.
+    int ScratchClass(size_t nbytes, size_t& cbytes)
+    {
+        if (nbytes <= scratch_min_bytes) { cbytes = scratch_min_bytes; return 0; }
+        size_t base = scratch_min_bytes;
+        int e = 0;
+        while (2*base < nbytes) { base *= 2; ++e; }
+        // Now base < nbytes <= 2*base.  Split this octave into 4 classes.
+        size_t q = base/4;
+        int k = int((nbytes - base + q - 1) / q);
+        cbytes = base + k*q;
+        int cls = 1 + 4*e + (k-1);
+        if (cbytes > scratch_max_pool || cls >= scratch_nclass) {
+            cbytes = nbytes;
+            return -1;
+        }
+        return cls;
+    }
+
+    // Whether this thread's pool is currently alive.  This is trivially destructible, so it is
+    // safe to check even after the pool itself has been destroyed at thread exit (e.g. if some
+    // static cache holding an image is destroyed after the main thread's pool).
+    thread_local bool scratch_pool_alive = false;
+
+    struct ScratchPool;
+
+    // All the live pools, so ClearScratchPool can release the free lists of every thread.
+    // These are never deleted, so they are still valid when the pools of threads that outlive
+    // the static destructors (or the main thread's pool) unregister themselves.
+    std::mutex& ScratchRegistryMutex()
+    {
+        static std::mutex* m = new std::mutex();
+        return *m;
+    }
+    std::vector<ScratchPool*>& ScratchRegistry()
+    {
+        static std::vector<ScratchPool*>* pools = new std::vector<ScratchPool*>();
+        return *pools;
+    }
+
+    struct ScratchPool
+    {
+        // The lock is only ever contended when another thread calls ClearScratchPool.
+        ScratchPool() : nbytes(0)
+        {
+            std::lock_guard<std::mutex> lock(ScratchRegistryMutex());
+            ScratchRegistry().push_back(this);
+            scratch_pool_alive = true;
+        }
+
+        ~ScratchPool()
+        {
+            scratch_pool_alive = false;
+            {
+                std::lock_guard<std::mutex> lock(ScratchRegistryMutex());
+                std::vector<ScratchPool*>& pools = ScratchRegistry();
+                pools.erase(std::find(pools.begin(), pools.end(), this));
+            }
+            clear();
+        }
+
+        char* get(int cls)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::vector<char*>& list = free_list[cls];
+            if (list.empty()) return 0;
+            char* data = list.back();
+            list.pop_back();
+            nbytes -= ClassBytes(cls);
+            scratch_bytes_pooled -= ClassBytes(cls);
+            return data;
+        }
+
+        bool put(char* data, int cls)
+        {
+            size_t cbytes = ClassBytes(cls);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (nbytes + cbytes > scratch_max_pool) return false;
+            if (scratch_bytes_pooled.fetch_add(cbytes) + cbytes > scratch_max_total) {
+                scratch_bytes_pooled -= cbytes;
+                return false;
+            }
+            free_list[cls].push_back(data);
+            nbytes += cbytes;
+            return true;
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (int cls=0; cls<scratch_nclass; ++cls) {
+                std::vector<char*>& list = free_list[cls];
+                for (size_t i=0; i<list.size(); ++i)
+                    delete [] reinterpret_cast<ScratchHeader*>(list[i])[-1].mem;
+                list.clear();
+            }
+            scratch_bytes_pooled -= nbytes;
+            nbytes = 0;
+        }
+
+        // The inverse of ScratchClass.
+        static size_t ClassBytes(int cls)
+        {
+            if (cls == 0) return scratch_min_bytes;
+            int e = (cls-1)/4;
+            int k = (cls-1)%4 + 1;
+            size_t base = scratch_min_bytes << e;
+            return base + k*(base/4);
+        }
+
+        std::vector<char*> free_list[scratch_nclass];
+        size_t nbytes;
+        std::mutex mutex;
+    };
+
+    thread_local ScratchPool scratch_pool;
+
+    char* AllocateScratch(size_t nbytes)
+    {
+        scratch_bytes_requested += nbytes;
+        size_t cbytes;
+        int cls = ScratchClass(nbytes, cbytes);
+        if (cls >= 0) {
+            char* data = scratch_pool.get(cls);
+            if (data) return data;
+        }
+        scratch_bytes_allocated += cbytes;
+        char* mem = new char[cbytes + sizeof(ScratchHeader) + scratch_align - 1];
+        char* data = reinterpret_cast<char*>(
+            (uintptr_t)(mem + sizeof(ScratchHeader) + scratch_align - 1) & ~(scratch_align-1));
+        ScratchHeader& header = reinterpret_cast<ScratchHeader*>(data)[-1];
+        header.mem = mem;
+        header.cls = cls;
+        return data;
+    }
+
+    void FreeScratch(char* data)
+    {
+        ScratchHeader& header = reinterpret_cast<ScratchHeader*>(data)[-1];
+        if (header.cls >= 0 && scratch_pool_alive && scratch_pool.put(data, header.cls)) return;
+        delete [] header.mem;
+    }
+
+} // anonymous namespace
+
+// A custom deleter that returns the memory to the scratch pool (or frees it).
 template <typename T>
 struct AlignedDeleter {
-    void operator()(T* p) const { delete [] ((char**)p)[-1]; }
+    void operator()(T* p) const { FreeScratch(reinterpret_cast<char*>(p)); }
 };
 
 template <typename T>
 std::shared_ptr<T> allocateAlignedMemory(int n)
 {
-    // This bit is based on the answers here:
-    // http://stackoverflow.com/questions/227897/how-to-allocate-aligned-memory-only-using-the-standard-library/227900
-    // The point of this is to get the _data pointer aligned to a 16 byte (128 bit) boundary.
-    // Arrays that are so aligned can use SSE operations and so can be much faster than
-    // non-aligned memroy.  FFTW in particular is faster if it gets aligned data.
-    char* mem = new char[n * sizeof(T) + sizeof(char*) + 15];
-    T* data = reinterpret_cast<T*>( (uintptr_t)(mem + sizeof(char*) + 15) & ~(size_t) 0x0F );
-    ((char**)data)[-1] = mem;
+    // The point of this is to get the _data pointer aligned to (at least) a 16 byte (128 bit)
+    // boundary.  Arrays that are so aligned can use SSE operations and so can be much faster
+    // than non-aligned memory.  FFTW in particular is faster if it gets aligned data.
+    // The memory comes from the per-thread scratch pool above.
+    T* data = reinterpret_cast<T*>(AllocateScratch(size_t(n) * sizeof(T)));
     std::shared_ptr<T> owner(data, AlignedDeleter<T>());
     return owner;
 }
 
+size_t GetScratchBytesRequested()
+{ return scratch_bytes_requested; }
+
+size_t GetScratchBytesAllocated()
+{ return scratch_bytes_allocated; }
+
+void ResetScratchCounters()
+{
+    scratch_bytes_requested = 0;
+    scratch_bytes_allocated = 0;
+}
+
+size_t GetScratchBytesPooled()
+{ return scratch_bytes_pooled; }
+
+void ClearScratchPool()
+{
+    std::lock_guard<std::mutex> lock(ScratchRegistryMutex());
+    std::vector<ScratchPool*>& pools = ScratchRegistry();
+    for (size_t i=0; i<pools.size(); ++i) pools[i]->clear();
+}
+
 template <typename T>
 void BaseImage<T>::allocateMem()
 {
@@ -574,6 +784,17 @@ void wrap_hermx_cols(T*& ptr, int m, int mwrap, int step)
     }
 }
 
+// One row to add onto a given target row in wrapImage, possibly with conjugation.
+struct WrapRowOp
+{
+    WrapRowOp(int _j, bool _conj) : j(_j), conj(_conj) {}
+    int j;
+    bool conj;
+};
+
+// Below this many pixels, it's not worth spreading wrapImage over threads.
+const int WRAP_PARALLEL_MIN_PIX = 65536;
+
 template <typename T>
 void wrapImage(ImageView<T> im, const Bounds<int>& b, bool hermx, bool hermy)
 {
@@ -588,12 +809,12 @@ void wrapImage(ImageView<T> im, const Bounds<int>& b, bool hermx, bool hermy)
     xdbg<<"i1,i2,j1,j2 = "<<i1<<','<<i2<<','<<j1<<','<<j2<<std::endl;
     const int mwrap = i2-i1;
     const int nwrap = j2-j1;
-    const int skip = im.getNSkip();
     const int step = im.getStep();
     const int stride = im.getStride();
     const int m = im.getNCol();
     const int n = im.getNRow();
-    T* ptr = im.getData();
+    T* data = im.getData();
+    const bool parallel = m * n >= WRAP_PARALLEL_MIN_PIX;
 
     if (hermx) {
         // In the hermitian x case, we need to wrap the columns first, otherwise the bookkeeping
@@ -601,6 +822,7 @@ void wrapImage(ImageView<T> im, const Bounds<int>& b, bool hermx, bool hermy)
         //
         // Each row has a corresponding row that stores the conjugate information for the
         // negative x values that are not stored.  We do these pairs of rows together.
+        // Each pair only touches its own two rows, so the pairs can be done in parallel.
         //
         // The exception is row 0 (which here is j==(n-1)/2), which is its own conjugate, so
         // it works slightly differently.
@@ -608,25 +830,28 @@ void wrapImage(ImageView<T> im, const Bounds<int>& b, bool hermx, bool hermy)
 
         int mid = (n-1)/2;  // The value of j that corresponds to the j==0 in the normal notation.
 
-        T* ptr1 = im.getData() + (i2-1)*step;
-        T* ptr2 = im.getData() + (n-1)*stride + (i2-1)*step;
-
-        // These skips will take us from the end of one row to the i2-1 element in the next row.
-        int skip1 = skip + (i2-1)*step;
-        int skip2 = skip1 - 2*stride; // This is negative.  We add this value to ptr2.
-
-        for (int j=0; j<mid; ++j, ptr1+=skip1, ptr2+=skip2) {
+#ifdef _OPENMP
+#pragma omp parallel for if (parallel)
+#endif
+        for (int j=0; j<mid; ++j) {
             xdbg<<"Wrap rows "<<j<<","<<n-j-1<<" into columns ["<<i1<<','<<i2<<")\n";
-            xdbg<<"ptrs = "<<ptr1-im.getData()<<"  "<<ptr2-im.getData()<<std::endl;
+            T* ptr1 = data + j*stride + (i2-1)*step;
+            T* ptr2 = data + (n-j-1)*stride + (i2-1)*step;
             wrap_hermx_cols_pair(ptr1, ptr2, m, mwrap, step);
         }
         // Finally, the row that is really j=0 (but here is j=(n-1)/2) also needs to be wrapped
         // singly.
         xdbg<<"Wrap row "<<mid<<" into columns ["<<i1<<','<<i2<<")\n";
-        xdbg<<"ptrs = "<<ptr1-im.getData()<<"  "<<ptr2-im.getData()<<std::endl;
+        T* ptr1 = data + mid*stride + (i2-1)*step;
         wrap_hermx_cols(ptr1, m, mwrap, step);
     }
 
+    // Next figure out which rows get added onto each row jj in [j1,j2), and in what order.
+    // Then each target row can be done independently (and in parallel), adding its source
+    // rows in the same order as they would be added by going through the image in order,
+    // so the results are identical to doing it serially.
+    std::vector<std::vector<WrapRowOp> > ops(nwrap);
+
     // If hermx is false, then we wrap the rows first instead.
     if (hermy) {
         assert(j1 == 0);
@@ -644,82 +869,68 @@ void wrapImage(ImageView<T> im, const Bounds<int>& b, bool hermx, bool hermy)
         // conjugate wrapping onto N/2.
 
         // Start with j == jj = j2-1.
-        int jj = j2-1;
-        ptr += jj * stride;
-        T* ptrwrap = ptr + (m-1) * step;
-
         // Do the first row separately, since we need to do it slightly differently, as
         // we are overwriting the input data as we go, so we would double add it if we did
         // it the normal way.
+        int jj = j2-1;
         xdbg<<"Wrap first row "<<jj<<" onto row = "<<jj<<" using conjugation.\n";
-        xdbg<<"ptrs = "<<ptr-im.getData()<<"  "<<ptrwrap-im.getData()<<std::endl;
+        T* ptr = data + jj*stride;
+        T* ptrwrap = ptr + (m-1) * step;
         wrap_row_selfconj(ptr, ptrwrap, m, step);
 
-        ptr += skip;
-        ptrwrap -= skip;
         --jj;
-        int  j= j2;
+        int j = j2;
         while (1) {
             int k = std::min(n-j,jj);  // How many conjugate rows to do?
-            for (; k; --k, ++j, --jj, ptr+=skip, ptrwrap-=skip) {
-                xdbg<<"Wrap row "<<j<<" onto row = "<<jj<<" using conjugation.\n";
-                xdbg<<"ptrs = "<<ptr-im.getData()<<"  "<<ptrwrap-im.getData()<<std::endl;
-                wrap_row_conj(ptr, ptrwrap, m, step);
-            }
+            for (; k; --k, ++j, --jj) ops[jj].push_back(WrapRowOp(j, true));
             assert(j==n || jj == j1);
             if (j == n) break;
             assert(j < n);
-            // On the last one, don't increment ptrs, since we need to repeat with the non-conj add.
-            wrap_row_conj(ptr, ptrwrap, m, step);
-            ptr -= m*step;
-            ptrwrap += step;
+            // The last one gets repeated with the non-conj add.
+            ops[jj].push_back(WrapRowOp(j, true));
 
             k = std::min(n-j,nwrap-1);  // How many non-conjugate rows to do?
-            for (; k; --k, ++j, ++jj, ptr+=skip, ptrwrap+=skip) {
-                xdbg<<"Wrap row "<<j<<" onto row = "<<jj<<std::endl;
-                xdbg<<"ptrs = "<<ptr-im.getData()<<"  "<<ptrwrap-im.getData()<<std::endl;
-                wrap_row(ptr, ptrwrap, m, step);
-            }
+            for (; k; --k, ++j, ++jj) ops[jj].push_back(WrapRowOp(j, false));
             assert(j==n || jj == j2-1);
             if (j == n) break;
             assert(j < n);
-            wrap_row(ptr, ptrwrap, m, step);
-            ptr -= m*step;
-            ptrwrap -= step;
+            ops[jj].push_back(WrapRowOp(j, false));
         }
     } else {
         // The regular case is mostly simpler (no conjugate stuff to worry about).
-        // However, we don't have the luxury of knowing that j1==0, so we need to start with
-        // the rows j<j1, then skip over [j1,j2) when we get there and continue with j>=j2.
-
-        // Row 0 maps onto j2 - (j2 % nwrap) (although we may need to subtract nwrap).
-        int jj = j2 - (j2 % nwrap);
-        if (jj == j2) jj = j1;
-        T* ptrwrap = ptr + jj * stride;
-        for (int j=0; j<n;) {
-            // When we get here, we can just skip to j2 and keep going.
-            if (j == j1) {
-                assert(ptr == ptrwrap);
-                j = j2;
-                ptr += nwrap * stride;
-            }
-            int k = std::min(n-j,j2-jj);  // How many to do before looping back.
-            for (; k; --k, ++j, ++jj, ptr+=skip, ptrwrap+=skip) {
-                xdbg<<"Wrap row "<<j<<" onto row = "<<jj<<std::endl;
-                xdbg<<"ptrs = "<<ptr-im.getData()<<"  "<<ptrwrap-im.getData()<<std::endl;
-                wrap_row(ptr, ptrwrap, m, step);
-            }
-            jj = j1;
-            ptrwrap -= nwrap * stride;
+        // Row j wraps onto the row jj in [j1,j2) with jj == j mod nwrap.  Rows in [j1,j2)
+        // themselves are skipped.
+        for (int j=0; j<n; ++j) {
+            if (j == j1) j = j2;
+            if (j == n) break;
+            int jj = j1 + ((j - j1) % nwrap + nwrap) % nwrap;
+            ops[jj-j1].push_back(WrapRowOp(j, false));
         }
     }
 
-    // In the normal (not hermx) case, we now wrap rows [j1,j2) into the columns [i1,i2).
-    if (!hermx) {
-        ptr = im.getData() + j1*stride;
-        for (int j=j1; j<j2; ++j, ptr+=skip) {
-            xdbg<<"Wrap row "<<j<<" into columns ["<<i1<<','<<i2<<")\n";
-            xdbg<<"ptr = "<<ptr-im.getData()<<std::endl;
+    // Now add up the rows for each target row.  In the normal (not hermx) case, also wrap
+    // the target row into the columns [i1,i2) while it is still in cache.
+#ifdef _OPENMP
+#pragma omp parallel for if (parallel)
+#endif
+    for (int jj=j1; jj<j2; ++jj) {
+        const std::vector<WrapRowOp>& jj_ops = ops[jj-j1];
+        T* ptrwrap0 = data + jj*stride;
+        for (size_t k=0; k<jj_ops.size(); ++k) {
+            xdbg<<"Wrap row "<<jj_ops[k].j<<" onto row = "<<jj<<
+                (jj_ops[k].conj ? " using conjugation.\n" : "\n");
+            T* ptr = data + jj_ops[k].j*stride;
+            if (jj_ops[k].conj) {
+                T* ptrwrap = ptrwrap0 + (m-1)*step;
+                wrap_row_conj(ptr, ptrwrap, m, step);
+            } else {
+                T* ptrwrap = ptrwrap0;
+                wrap_row(ptr, ptrwrap, m, step);
+            }
+        }
+        if (!hermx) {
+            xdbg<<"Wrap row "<<jj<<" into columns ["<<i1<<','<<i2<<")\n";
+            T* ptr = ptrwrap0;
             wrap_cols(ptr, m, mwrap, i1, i2, step);
         }
     }
@@ -1002,104 +1213,148 @@ void invertImage(ImageView<T> im)
 
 namespace depixelize {
 
-    typedef Eigen::LLT<Eigen::Ref<Eigen::MatrixXd> > SolverType;
-    std::unique_ptr<SolverType> _solver;
-    std::unique_ptr<Eigen::MatrixXd> _A; // Need this too!
-    int _nx = -1;
-    int _ny = -1;
-    std::vector<double> _unit_integrals;
+    // The matrix we need to invert has elements
+    //     A(row,col) = unit_integrals[|p-h|] * unit_integrals[|q-k|]
+    // where row = q*nx + p and col = k*nx + h.  This is separable: A = Ky (x) Kx, where Kx is
+    // the nx x nx matrix Kx(p,h) = unit_integrals[|p-h|] (zero if |p-h| >= n) and similarly
+    // for Ky.  So rather than factor the npix x npix matrix A, we only need to factor Kx and
+    // Ky, and the solution is X = Kx^-1 B Ky^-1, where B is the image viewed as an nx x ny
+    // column-major matrix.
+    typedef Eigen::LLT<Eigen::MatrixXd> SolverType;
+
+    struct CacheEntry
+    {
+        int m;
+        std::vector<double> unit_integrals;
+        std::shared_ptr<SolverType> solver;
+    };
+
+    // The cache of 1-d factorizations, most recently used first.  We keep as many as fit in
+    // max_cache_bytes, but always at least the two most recent ones (i.e. Kx and Ky for the
+    // most recent image).
+    std::list<CacheEntry> _cache;
+    size_t _cache_bytes = 0;
+    const size_t max_cache_bytes = 64 * 1024 * 1024;
+
+    size_t entry_bytes(int m)
+    { return size_t(m) * m * sizeof(double); }
+
+    std::shared_ptr<SolverType> get_solver(int m, const double* unit_integrals, const int n)
+    {
+        // Only the first m unit_integrals are relevant for an m x m matrix.
+        const int nk = std::min(n, m);
+        for (auto it=_cache.begin(); it!=_cache.end(); ++it) {
+            if (it->m != m) continue;
+            if (int(it->unit_integrals.size()) != nk) continue;
+            if (!std::equal(unit_integrals, unit_integrals+nk, it->unit_integrals.begin()))
+                continue;
+            // Move it to the front.
+            _cache.splice(_cache.begin(), _cache, it);
+            return _cache.front().solver;
+        }
+
+        dbg<<"Build depixelize solver for m = "<<m<<std::endl;
+        Eigen::MatrixXd K(m, m);
+        for (int h=0; h<m; ++h) {
+            for (int p=0; p<m; ++p) {
+                int d = std::abs(p-h);
+                K(p,h) = d < nk ? unit_integrals[d] : 0.;
+            }
+        }
+
+        CacheEntry entry;
+        entry.m = m;
+        entry.unit_integrals.assign(unit_integrals, unit_integrals+nk);
+        entry.solver.reset(new SolverType(K));
+        _cache.push_front(entry);
+        _cache_bytes += entry_bytes(m);
 
-    SolverType* get_cache(
-        int nx, int ny, const double* unit_integrals, const int n)
+        while (_cache_bytes > max_cache_bytes && _cache.size() > 2) {
+            _cache_bytes -= entry_bytes(_cache.back().m);
+            _cache.pop_back();
+        }
+        return _cache.front().solver;
+    }
+
+    // Solve K X = B in place for the columns of B, spreading the columns over threads
+    // when there are enough of them to make it worthwhile.
+    void solve_columns(const SolverType& solver, Eigen::MatrixXd& B)
     {
-        if (nx != _nx || ny != _ny) return 0;
-        if (int(_unit_integrals.size()) != n) return 0;
-        for (int k=0; k<n; ++k)
-            if (_unit_integrals[k] != unit_integrals[k]) return 0;
-        return _solver.get();
+        const int ncol = B.cols();
+        const int block = 16;
+#ifdef _OPENMP
+#pragma omp parallel for if (B.size() >= 16384)
+#endif
+        for (int j0=0; j0<ncol; j0+=block) {
+            const int nj = std::min(block, ncol-j0);
+            auto Bj = B.middleCols(j0, nj);
+            solver.solveInPlace(Bj);
+        }
     }
 
-    void set_cache(SolverType* solver, Eigen::MatrixXd* A,
-                   const int nx, const int ny, const double* unit_integrals, const int n)
+    // B <- Kx^-1 B Ky^-1
+    void solve(const SolverType& solverx, const SolverType& solvery, Eigen::MatrixXd& B)
     {
-        _solver.reset(solver);
-        _A.reset(A);
-        _nx = nx;
-        _ny = ny;
-        _unit_integrals = std::vector<double>(unit_integrals, unit_integrals+n);
+        solve_columns(solverx, B);
+        Eigen::MatrixXd Bt = B.transpose();
+        solve_columns(solvery, Bt);
+        B = Bt.transpose();
+    }
+
+    // Replace the nx x ny image in data with its solution.
+    template <typename T>
+    void solve_image(const SolverType& solverx, const SolverType& solvery, T* data,
+                     int nx, int ny)
+    {
+        Eigen::MatrixXd B(nx, ny);
+        const int npix = nx * ny;
+        // Note: In Eigen 3.4, this can be B.data()
+        double* bit = &B(0,0);
+        for(int k=0; k<npix; ++k) bit[k] = data[k];
+        solve(solverx, solvery, B);
+        for(int k=0; k<npix; ++k) data[k] = bit[k];
+    }
+
+    // K is real, so for complex images, solve for the real and imaginary parts separately.
+    template <typename T>
+    void solve_image(const SolverType& solverx, const SolverType& solvery,
+                     std::complex<T>* data, int nx, int ny)
+    {
+        Eigen::MatrixXd Br(nx, ny);
+        Eigen::MatrixXd Bi(nx, ny);
+        const int npix = nx * ny;
+        double* brit = &Br(0,0);
+        double* biit = &Bi(0,0);
+        for(int k=0; k<npix; ++k) {
+            brit[k] = std::real(data[k]);
+            biit[k] = std::imag(data[k]);
+        }
+        solve(solverx, solvery, Br);
+        solve(solverx, solvery, Bi);
+        for(int k=0; k<npix; ++k) data[k] = std::complex<T>(brit[k], biit[k]);
     }
 }
 
 template <typename T>
 void ImageView<T>::depixelizeSelf(const double* unit_integrals, const int n)
 {
-    using Eigen::MatrixXd;
-    using Eigen::Matrix;
-    using Eigen::Dynamic;
-
     const int nx = this->getNCol();
     const int ny = this->getNRow();
-    const int npix = nx * ny;
-
-    depixelize::SolverType* solver = depixelize::get_cache(nx, ny, unit_integrals, n);
-    if (!solver) {
-        // Make solver and cache it.
-        MatrixXd* A = new MatrixXd(npix, npix);
-        A->setZero();
-        for(int col=0; col<npix; ++col) {
-            int h = col % nx;
-            int k = col / nx;
-            // Only populate lower triangle of A (since it's symmetric)
-            // I.e. only when row >= col, so q >= k
-            int q1 = k;
-            int q2 = std::min(k+n,ny);
-            int p1 = std::max(h-n+1,0);
-            int p2 = std::min(h+n,nx);
-            auto Acol = A->col(col);
-            for(int q=q1; q<q2; ++q) {
-                int row = q*nx + p1;
-                double kq = unit_integrals[q-k];
-                // Note: In Eigen 3.4, this can be Acol.begin() + row
-                auto Acolit = &Acol[row];
-                const double* kpit = unit_integrals + (h-p1);
-                // A(row,col) = unit_integrals[std::abs(p-h)] * unit_integrals[std::abs(q-k)];
-                for(int p=p1; p<h; ++p) {
-                    *Acolit++ = *kpit-- * kq;
-                }
-                for(int p=h; p<p2; ++p) {
-                    *Acolit++ = *kpit++ * kq;
-                }
-            }
-        }
-
-        // Rather than A->llt(), this lets solver be constructed in place, so less memory usage.
-        // cf. https://eigen.tuxfamily.org/dox/group__InplaceDecomposition.html
-        // But this also means we need to persist A as long as the solver, so cache it too.
-        solver = new depixelize::SolverType(*A);
-
-        depixelize::set_cache(solver, A, nx, ny, unit_integrals, n);
-    }
-
-    Matrix<typename ComplexHelper<T>::double_type, Dynamic, 1> b(npix);
-    // Note: In Eigen 3.4, this can be b.begin()
-    auto bit = &b[0];
-    T* ptr = getData();
-    for(int col=0; col<npix; ++col) *bit++ = *ptr++;
 
-    // Unfortunately, Eigen doesn't seem to be able to solve the vector in place, but
-    // that's less memory, so just assign the answer back to b.
-    b = solver->solve(b);
+    // Hold onto these, in case getting solvery evicts solverx from the cache.
+    std::shared_ptr<depixelize::SolverType> solverx =
+        depixelize::get_solver(nx, unit_integrals, n);
+    std::shared_ptr<depixelize::SolverType> solvery =
+        depixelize::get_solver(ny, unit_integrals, n);
 
-    // Copy back to the image
-    ptr = getData();
-    bit = &b[0];
-    for(int col=0; col<npix; ++col) *ptr++ = *bit++;
+    // The image data viewed as an nx x ny column-major matrix is B(p,q) = image(p,q).
+    depixelize::solve_image(*solverx, *solvery, getData(), nx, ny);
 }
 
 void ClearDepixelizeCache()
 {
-    depixelize::_solver.reset();
-    depixelize::_A.reset();
+    depixelize::_cache.clear();
+    depixelize::_cache_bytes = 0;
 }
 
 // The classes ConstReturn, ReturnInverse, and ReturnSecond are defined in ImageArith.h.
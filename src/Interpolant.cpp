@@ -138,6 +138,70 @@ namespace galsim {
         for (; N; --N, ++u) *u = uval(*u);
     }
 
+    void Interpolant::xvalTaps(double f, int k1, int k2, double* wts) const
+    {
+        const int kmin = 1 - nTaps()/2;
+        for (int k=k1; k<=k2; ++k) *wts++ = xval(k + kmin - f);
+    }
+
+    void Interpolant::getTaps(double x, int pmin, int pmax, int& p1, int& p2,
+                              double* wts) const
+    {
+        const double SMALL = 10.*std::numeric_limits<double>::epsilon();
+        if (isExactAtNodes() && std::abs(x-std::floor(x+0.01)) < SMALL*(std::abs(x)+1)) {
+            // If x is (basically) an integer, only 1 sample contributes.
+            p1 = p2 = int(std::floor(x+0.01));
+            if (p1 < pmin || p1 > pmax) --p2;
+            else wts[0] = xval(p1-x);
+        } else {
+            double p0 = std::floor(x);
+            const int ntaps = nTaps();
+            const int pa = int(p0) + 1 - ntaps/2;
+            // Only calculate the weights for the taps that are in [pmin,pmax].
+            p1 = std::max(pa, pmin);
+            p2 = std::min(pa + ntaps - 1, pmax);
+            if (p1 <= p2) xvalTaps(x-p0, p1-pa, p2-pa, wts);
+        }
+    }
+
+    // Space for up to this many weights is kept on the stack in interpolate2d.  Any more than
+    // that go on the heap.
+    const int MAX_STACK_TAPS = 64;
+
+    double Interpolant::interpolate2d(const double* data, int nx, int ny, int stride,
+                                      double x, double y) const
+    {
+        // Limit the taps to the extent of the grid, so we only calculate the weights we use.
+        // This is important for interpolants like Sinc with very many taps.
+        const int ntaps = nTaps();
+        const int nxw = std::min(ntaps, nx);
+        const int nyw = std::min(ntaps, ny);
+        double xbuf[MAX_STACK_TAPS];
+        double ybuf[MAX_STACK_TAPS];
+        std::vector<double> xvec, yvec;
+        double* xwt = xbuf;
+        double* ywt = ybuf;
+        if (nxw > MAX_STACK_TAPS) { xvec.resize(nxw); xwt = &xvec[0]; }
+        if (nyw > MAX_STACK_TAPS) { yvec.resize(nyw); ywt = &yvec[0]; }
+
+        int p1, p2, q1, q2;
+        getTaps(x, 0, nx-1, p1, p2, xwt);
+        if (p1 > p2) return 0.;
+        getTaps(y, 0, ny-1, q1, q2, ywt);
+        if (q1 > q2) return 0.;
+
+        const int np = p2-p1+1;
+        const double* ptr = data + q1*stride + p1;
+        const double* yw = ywt;
+        double sum = 0.;
+        for (int q=q1; q<=q2; ++q, ptr+=stride) {
+            double xsum = 0.;
+            for (int p=0; p<np; ++p) xsum += xwt[p] * ptr[p];
+            sum += xsum * *yw++;
+        }
+        return sum;
+    }
+
     //
     // Delta
     //
@@ -248,6 +312,12 @@ namespace galsim {
         if (x > 1.) return 0.;
         else return 1.-x;
     }
+    void Linear::xvalTaps(double f, int k1, int k2, double* wts) const
+    {
+        double all[2] = { 1.-f, f };
+        std::copy(all+k1, all+k2+1, wts);
+    }
+
     double Linear::uval(double u) const
     {
         double s = math::sinc(u);
@@ -289,6 +359,19 @@ namespace galsim {
         else return 0.;
     }
 
+    void Cubic::xvalTaps(double f, int k1, int k2, double* wts) const
+    {
+        // The taps are at |x| = 1+f, f, 1-f, 2-f, so each one is always on the same
+        // piece of the polynomial.
+        double g = 1.-f;
+        double all[4];
+        all[0] = -0.5*f*g*g;
+        all[1] = 1. + f*f*(1.5*f-2.5);
+        all[2] = 1. + g*g*(1.5*g-2.5);
+        all[3] = -0.5*g*f*f;
+        std::copy(all+k1, all+k2+1, wts);
+    }
+
     double Cubic::uval(double u) const
     {
         u = std::abs(u);
@@ -326,38 +409,45 @@ namespace galsim {
 
 #ifdef USE_TABLES
         double tol = gsparams.kvalue_accuracy;
-        // Strangely, not all compilers correctly setup an empty map when it is a
-        // static variable, so you can get seg faults using it.
-        // Doing an explicit clear fixes the problem.
-        if (_cache_umax.size() == 0) { _cache_umax.clear(); _cache_tab.clear(); }
-
-        if (_cache_umax.count(tol)) {
-            // Then uMax and tab are already cached.
-            _tab = _cache_tab[tol];
-            _uMax = _cache_umax[tol];
-        } else {
-            // Then need to do the calculation and then cache it.
-            const double uStep =
-                gsparams.table_spacing * std::pow(gsparams.kvalue_accuracy/10.,0.25);
-            _uMax = 0.;
-            _tab.reset(new TableBuilder(Table::spline));
-            for (double u=0.; u - _uMax < 1. || u<1.1; u+=uStep) {
-                double ft = uCalc(u);
+        // The caches are shared by all Cubic objects, so only let one thread at a time
+        // look at them or build new entries.
+#ifdef _OPENMP
+#pragma omp critical (galsim_cubic_cache)
+#endif
+        {
+            // Strangely, not all compilers correctly setup an empty map when it is a
+            // static variable, so you can get seg faults using it.
+            // Doing an explicit clear fixes the problem.
+            if (_cache_umax.size() == 0) { _cache_umax.clear(); _cache_tab.clear(); }
+
+            if (_cache_umax.count(tol)) {
+                // Then uMax and tab are already cached.
+                _tab = _cache_tab[tol];
+                _uMax = _cache_umax[tol];
+            } else {
+                // Then need to do the calculation and then cache it.
+                const double uStep =
+                    gsparams.table_spacing * std::pow(gsparams.kvalue_accuracy/10.,0.25);
+                _uMax = 0.;
+                _tab.reset(new TableBuilder(Table::spline));
+                for (double u=0.; u - _uMax < 1. || u<1.1; u+=uStep) {
+                    double ft = uCalc(u);
 #ifdef DEBUGLOGGING
-                double s = math::sinc(u);
-                double c = cos(M_PI*u);
-                double ft2 = s*s*s*(3.*s-2.*c);
-                dbg<<"u = "<<u<<", ft = "<<ft<<"  "<<ft2<<"  diff = "<<ft-ft2<<std::endl;
+                    double s = math::sinc(u);
+                    double c = cos(M_PI*u);
+                    double ft2 = s*s*s*(3.*s-2.*c);
+                    dbg<<"u = "<<u<<", ft = "<<ft<<"  "<<ft2<<"  diff = "<<ft-ft2<<std::endl;
 #endif
-                _tab->addEntry(u, ft);
-                if (std::abs(ft) > tol) _uMax = u;
+                    _tab->addEntry(u, ft);
+                    if (std::abs(ft) > tol) _uMax = u;
+                }
+                _tab->finalize();
+                // Save these values in the cache.
+                _cache_tab[tol] = _tab;
+                _cache_umax[tol] = _uMax;
+                dbg<<"umax = "<<_uMax<<", alt umax = "<<
+                    std::pow((3.*sqrt(3.)/8.)/tol, 1./3.) / M_PI <<std::endl;
             }
-            _tab->finalize();
-            // Save these values in the cache.
-            _cache_tab[tol] = _tab;
-            _cache_umax[tol] = _uMax;
-            dbg<<"umax = "<<_uMax<<", alt umax = "<<
-                std::pow((3.*sqrt(3.)/8.)/tol, 1./3.) / M_PI <<std::endl;
         }
 #else
         // uMax is the value where |ft| <= tolerance
@@ -386,50 +476,71 @@ namespace galsim {
     // Quintic
     //
 
+    // The three pieces of the quintic kernel, valid for 0<=x<=1, 1<=x<=2, and 2<=x<=3.
+#ifdef ALT_QUINTIC
+    // Gary claims in http://arxiv.org/abs/1401.2636 that his quintic function (below) has the
+    // following properties:
+    //
+    // f(0) = 1
+    // f(1) = f(2) = f(3) = 0
+    // f'(0) = 0
+    // f'(1)_left = f'(1)_right
+    // f'(2)_left = f'(2)_right
+    // f'(3)_left = 0
+    // f''(0) = 0
+    // (*) f''(1)_left = f''(1)_right
+    // (*) f''(2)_left = f''(2)_right
+    // (*) f''(3)_left = 0
+    // f(x-3)+f(x-2) + f(x-1) + f(x) + f(x+1) + f(x+2) = 1 from 0..1
+    // F'(j) = F''(j) = F'''(j) = F''''(j) = 0
+    //
+    // However, it turns out that the second derivative continuity equations (marked * above)
+    // are not actually satisfied.  I (MJ) tried to derive a version that does satisfy all
+    // the constraints and discovered that the system is over-constrained.  If I keep the
+    // second derivative constraints and drop F''''(j) = 0, I get the following:
+    static inline double QuinticPiece1(double x)
+    { return 1. + x*x*x*(-15./2. + x*(32./3. + x*(-25./6.))); }
+    static inline double QuinticPiece2(double x)
+    { return (x-1.)*(x-2.)*(-23./4. + x*(169./12. + x*(-39./4. + x*(25./12.)))); }
+    static inline double QuinticPiece3(double x)
+    { return (x-2.)*(x-3.)*(x-3.)*(x-3.)*(3./4. + x*(-5./12.)); }
+#else
+    // This is Gary's original version with F''''(j) = 0, but f''(x) is not continuous at
+    // x = 1,2,3.
+    static inline double QuinticPiece1(double x)
+    { return 1. + x*x*x*(-95./12. + x*(23./2. + x*(-55./12.))); }
+    static inline double QuinticPiece2(double x)
+    { return (x-1.)*(x-2.)*(-23./4. + x*(29./2. + x*(-83./8. + x*(55./24.)))); }
+    static inline double QuinticPiece3(double x)
+    { return (x-2.)*(x-3.)*(x-3.)*(-9./4. + x*(25./12. + x*(-11./24.))); }
+#endif
+
     double Quintic::xval(double x) const
     {
         x = std::abs(x);
-#ifdef ALT_QUINTIC
-        // Gary claims in http://arxiv.org/abs/1401.2636 that his quintic function (below) has the
-        // following properties:
-        //
-        // f(0) = 1
-        // f(1) = f(2) = f(3) = 0
-        // f'(0) = 0
-        // f'(1)_left = f'(1)_right
-        // f'(2)_left = f'(2)_right
-        // f'(3)_left = 0
-        // f''(0) = 0
-        // (*) f''(1)_left = f''(1)_right
-        // (*) f''(2)_left = f''(2)_right
-        // (*) f''(3)_left = 0
-        // f(x-3)+f(x-2) + f(x-1) + f(x) + f(x+1) + f(x+2) = 1 from 0..1
-        // F'(j) = F''(j) = F'''(j) = F''''(j) = 0
-        //
-        // However, it turns out that the second derivative continuity equations (marked * above)
-        // are not actually satisfied.  I (MJ) tried to derive a version that does satisfy all
-        // the constraints and discovered that the system is over-constrained.  If I keep the
-        // second derivative constraints and drop F''''(j) = 0, I get the following:
         if (x <= 1.)
-            return 1. + x*x*x*(-15./2. + x*(32./3. + x*(-25./6.)));
+            return QuinticPiece1(x);
         else if (x <= 2.)
-            return (x-1.)*(x-2.)*(-23./4. + x*(169./12. + x*(-39./4. + x*(25./12.))));
+            return QuinticPiece2(x);
         else if (x <= 3.)
-            return (x-2.)*(x-3.)*(x-3.)*(x-3.)*(3./4. + x*(-5./12.));
+            return QuinticPiece3(x);
         else
             return 0.;
-#else
-        // This is Gary's original version with F''''(j) = 0, but f''(x) is not continuous at
-        // x = 1,2,3.
-        if (x <= 1.)
-            return 1. + x*x*x*(-95./12. + x*(23./2. + x*(-55./12.)));
-        else if (x <= 2.)
-            return (x-1.)*(x-2.)*(-23./4. + x*(29./2. + x*(-83./8. + x*(55./24.))));
-        else if (x <= 3.)
-            return (x-2.)*(x-3.)*(x-3.)*(-9./4. + x*(25./12. + x*(-11./24.)));
-        else
-            return 0.;
-#endif
+    }
+
+    void Quintic::xvalTaps(double f, int k1, int k2, double* wts) const
+    {
+        // The taps are at |x| = 2+f, 1+f, f, 1-f, 2-f, 3-f, so each one is always on the same
+        // piece of the polynomial.
+        double g = 1.-f;
+        double all[6];
+        all[0] = QuinticPiece3(2.+f);
+        all[1] = QuinticPiece2(1.+f);
+        all[2] = QuinticPiece1(f);
+        all[3] = QuinticPiece1(g);
+        all[4] = QuinticPiece2(1.+g);
+        all[5] = QuinticPiece3(2.+g);
+        std::copy(all+k1, all+k2+1, wts);
     }
 
     double Quintic::uval(double u) const
@@ -476,46 +587,53 @@ namespace galsim {
 
 #ifdef USE_TABLES
         double tol = gsparams.kvalue_accuracy;
-        // Strangely, not all compilers correctly setup an empty map when it is a
-        // static variable, so you can get seg faults using it.
-        // Doing an explicit clear fixes the problem.
-        if (_cache_umax.size() == 0) { _cache_umax.clear(); _cache_tab.clear(); }
-
-        if (_cache_umax.count(tol)) {
-            // Then uMax and tab are already cached.
-            _tab = _cache_tab[tol];
-            _uMax = _cache_umax[tol];
-        } else {
-            // Then need to do the calculation and then cache it.
-            const double uStep =
-                gsparams.table_spacing * std::pow(gsparams.kvalue_accuracy/10.,0.25);
-            _uMax = 0.;
-            _tab.reset(new TableBuilder(Table::spline));
-            for (double u=0.; u - _uMax < 1. || u<1.1; u+=uStep) {
-                dbg<<"u = "<<u<<std::endl;
-                double ft = uCalc(u);
-                _tab->addEntry(u, ft);
+        // The caches are shared by all Quintic objects, so only let one thread at a time
+        // look at them or build new entries.
+#ifdef _OPENMP
+#pragma omp critical (galsim_quintic_cache)
+#endif
+        {
+            // Strangely, not all compilers correctly setup an empty map when it is a
+            // static variable, so you can get seg faults using it.
+            // Doing an explicit clear fixes the problem.
+            if (_cache_umax.size() == 0) { _cache_umax.clear(); _cache_tab.clear(); }
+
+            if (_cache_umax.count(tol)) {
+                // Then uMax and tab are already cached.
+                _tab = _cache_tab[tol];
+                _uMax = _cache_umax[tol];
+            } else {
+                // Then need to do the calculation and then cache it.
+                const double uStep =
+                    gsparams.table_spacing * std::pow(gsparams.kvalue_accuracy/10.,0.25);
+                _uMax = 0.;
+                _tab.reset(new TableBuilder(Table::spline));
+                for (double u=0.; u - _uMax < 1. || u<1.1; u+=uStep) {
+                    dbg<<"u = "<<u<<std::endl;
+                    double ft = uCalc(u);
+                    _tab->addEntry(u, ft);
 #ifdef DEBUGLOGGING
-                double s = math::sinc(u);
-                double piu = M_PI*u;
-                double c = cos(piu);
-                double ssq = s*s;
-                double piusq = piu*piu;
+                    double s = math::sinc(u);
+                    double piu = M_PI*u;
+                    double c = cos(piu);
+                    double ssq = s*s;
+                    double piusq = piu*piu;
 #ifdef ALT_QUINTIC
-                double ft2 = ssq*ssq*(ssq*(12.*piusq-50.) + 44.*s*c+5.);
+                    double ft2 = ssq*ssq*(ssq*(12.*piusq-50.) + 44.*s*c+5.);
 #else
-                double ft2 = s*ssq*ssq*(s*(55.-19.*piusq) + 2.*c*(piusq-27.));
+                    double ft2 = s*ssq*ssq*(s*(55.-19.*piusq) + 2.*c*(piusq-27.));
 #endif
-                dbg<<"u = "<<u<<", ft = "<<ft<<"  "<<ft2<<"  diff = "<<ft-ft2<<std::endl;
+                    dbg<<"u = "<<u<<", ft = "<<ft<<"  "<<ft2<<"  diff = "<<ft-ft2<<std::endl;
 #endif
-                if (std::abs(ft) > tol) _uMax = u;
+                    if (std::abs(ft) > tol) _uMax = u;
+                }
+                _tab->finalize();
+                // Save these values in the cache.
+                _cache_tab[tol] = _tab;
+                _cache_umax[tol] = _uMax;
+                dbg<<"umax = "<<_uMax<<", alt umax = "<<
+                    std::pow((25.*sqrt(5.)/108.)/tol, 1./3.) / M_PI <<std::endl;
             }
-            _tab->finalize();
-            // Save these values in the cache.
-            _cache_tab[tol] = _tab;
-            _cache_umax[tol] = _uMax;
-            dbg<<"umax = "<<_uMax<<", alt umax = "<<
-                std::pow((25.*sqrt(5.)/108.)/tol, 1./3.) / M_PI <<std::endl;
         }
 #else
         // uMax is the value where |ft| <= tolerance
@@ -838,65 +956,146 @@ namespace galsim {
                  - 2.*_K[5]*(1.-std::cos(10.*M_PI*x))) << std::endl;
         }
 
-        // Strangely, not all compilers correctly setup an empty map when it is a
-        // static variable, so you can get seg faults using it.
-        // Doing an explicit clear fixes the problem.
-        if (_cache_umax.size() == 0) {
-            _cache_umax.clear();
+        // The caches are shared by all Lanczos objects, so only let one thread at a time
+        // look at them or build new entries.
+#ifdef _OPENMP
+#pragma omp critical (galsim_lanczos_cache)
+#endif
+        {
+            // Strangely, not all compilers correctly setup an empty map when it is a
+            // static variable, so you can get seg faults using it.
+            // Doing an explicit clear fixes the problem.
+            if (_cache_umax.size() == 0) {
+                _cache_umax.clear();
 #ifdef USE_TABLES
-            _cache_xtab.clear();
+                _cache_xtab.clear();
 #endif
-            _cache_utab.clear();
-        }
+                _cache_utab.clear();
+                _cache_taptab.clear();
+            }
 
-        KeyType key(n,std::pair<bool,double>(_conserve_dc,tol));
+            KeyType key(n,std::pair<bool,double>(_conserve_dc,tol));
 
-        if (_cache_umax.count(key)) {
-            // Then uMax and tab are already cached.
+            if (_cache_umax.count(key)) {
+                // Then uMax and tab are already cached.
 #ifdef USE_TABLES
-            _xtab = _cache_xtab[key];
+                _xtab = _cache_xtab[key];
 #endif
-            _utab = _cache_utab[key];
-            _uMax = _cache_umax[key];
-        } else {
+                _utab = _cache_utab[key];
+                _uMax = _cache_umax[key];
+            } else {
 #ifdef USE_TABLES
-            // Build xtab = table of x values
-            _xtab.reset(new TableBuilder(Table::spline));
-            // Spline is accurate to O(dx^3), so errors should be ~dx^4.
-            const double xStep1 =
-                gsparams.table_spacing * std::pow(gsparams.xvalue_accuracy/10.,0.25);
-            // Make sure steps hit the integer values exactly.
-            const double xStep = 1. / std::ceil(1./xStep1);
-            for(double x=0.; x<_nd; x+=xStep) _xtab->addEntry(x, xCalc(x));
-            _xtab->finalize();
+                // Build xtab = table of x values
+                _xtab.reset(new TableBuilder(Table::spline));
+                // Spline is accurate to O(dx^3), so errors should be ~dx^4.
+                const double xStep1 =
+                    gsparams.table_spacing * std::pow(gsparams.xvalue_accuracy/10.,0.25);
+                // Make sure steps hit the integer values exactly.
+                const double xStep = 1. / std::ceil(1./xStep1);
+                for(double x=0.; x<_nd; x+=xStep) _xtab->addEntry(x, xCalc(x));
+                _xtab->finalize();
 #endif
 
-            // Build utab = table of u values
-            _utab.reset(new TableBuilder(Table::spline));
-            // The peak second derivative of the Lanczos kernel if Fourier space empirically
-            // seems to a bit over ~100.  Use 200 to be conservative, so this mean use
-            // h = (kvalue_accuracy/200)**0.25
-            const double uStep =
-                gsparams.table_spacing * std::pow(gsparams.kvalue_accuracy/200.,0.25) / _nd;
-            _uMax = 0.;
-            for (double u=0.; u - _uMax < 1./_nd || u<1.1; u+=uStep) {
-                double uval = uCalc(u);
-                _utab->addEntry(u, uval);
-                if (std::abs(uval) > gsparams.kvalue_accuracy) _uMax = u;
-            }
-            _utab->finalize();
-            // Save these values in the cache.
+                // Build utab = table of u values
+                _utab.reset(new TableBuilder(Table::spline));
+                // The peak second derivative of the Lanczos kernel if Fourier space empirically
+                // seems to a bit over ~100.  Use 200 to be conservative, so this mean use
+                // h = (kvalue_accuracy/200)**0.25
+                const double uStep =
+                    gsparams.table_spacing * std::pow(gsparams.kvalue_accuracy/200.,0.25) / _nd;
+                _uMax = 0.;
+                for (double u=0.; u - _uMax < 1./_nd || u<1.1; u+=uStep) {
+                    double uval = uCalc(u);
+                    _utab->addEntry(u, uval);
+                    if (std::abs(uval) > gsparams.kvalue_accuracy) _uMax = u;
+                }
+                _utab->finalize();
+                // Save these values in the cache.
 #ifdef USE_TABLES
-            _cache_xtab[key] = _xtab;
+                _cache_xtab[key] = _xtab;
 #endif
-            _cache_utab[key] = _utab;
-            _cache_umax[key] = _uMax;
+                _cache_utab[key] = _utab;
+                _cache_umax[key] = _uMax;
+            }
+
+            // The tap table depends on xvalue_accuracy rather than kvalue_accuracy.
+            KeyType xkey(n,std::pair<bool,double>(_conserve_dc,gsparams.xvalue_accuracy));
+            if (_cache_taptab.count(xkey)) {
+                _taptab = _cache_taptab[xkey];
+                _nphase = _taptab->size() / (2*_n) - 1;
+            } else {
+                buildTapTable();
+                _cache_taptab[xkey] = _taptab;
+            }
+        }
+    }
+
+    void Lanczos::buildTapTable()
+    {
+        // Each tap weight is a smooth function of the phase f over 0 <= f <= 1, so we tabulate
+        // them at _nphase+1 equally spaced phases and use 4-point Lagrange interpolation between
+        // them in xvalTaps.  The error in this interpolation scales as h^4 f'''', so start with
+        // a spacing that is usually good enough and refine it until the errors at the midpoints
+        // of the intervals (where they are largest) are below the target accuracy.
+        const int ntaps = 2*_n;
+        const int kmin = 1-_n;
+        const double tol = 1.e-4 * _gsparams.xvalue_accuracy;
+        std::vector<double> wts(ntaps);
+        for (_nphase = 64; ; _nphase *= 2) {
+            _taptab.reset(new std::vector<double>((_nphase+1)*ntaps));
+            std::vector<double>& tab = *_taptab;
+            for (int r=0; r<=_nphase; ++r) {
+                double f = double(r)/_nphase;
+                for (int k=0; k<ntaps; ++k) tab[r*ntaps+k] = xval(k+kmin-f);
+            }
+            // Don't go on forever if tol is unreasonably small.
+            if (_nphase >= (1<<16)) break;
+
+            double maxerr = 0.;
+            for (int r=0; r<_nphase; ++r) {
+                double f = (r+0.5)/_nphase;
+                xvalTaps(f, 0, ntaps-1, &wts[0]);
+                for (int k=0; k<ntaps; ++k)
+                    maxerr = std::max(maxerr, std::abs(wts[k] - xval(k+kmin-f)));
+            }
+            dbg<<"Lanczos tap table with nphase = "<<_nphase<<" has maxerr = "<<maxerr<<std::endl;
+            if (maxerr < tol) break;
         }
     }
 
     std::map<Lanczos::KeyType,shared_ptr<TableBuilder> > Lanczos::_cache_xtab;
     std::map<Lanczos::KeyType,shared_ptr<TableBuilder> > Lanczos::_cache_utab;
     std::map<Lanczos::KeyType,double> Lanczos::_cache_umax;
+    std::map<Lanczos::KeyType,shared_ptr<std::vector<double> > > Lanczos::_cache_taptab;
+
+    void Lanczos::xvalTaps(double f, int k1, int k2, double* wts) const
+    {
+        const int ntaps = 2*_n;
+
+        // Use the 4 tabulated phases r0..r0+3, which are normally the two that bracket f and
+        // one more on each side.  Near the ends, shift them to stay within the table.
+        double t = f * _nphase;
+        int r0 = int(t) - 1;
+        if (r0 < 0) r0 = 0;
+        else if (r0 > _nphase-3) r0 = _nphase-3;
+        t -= r0;
+
+        // The Lagrange interpolation coefficients for nodes at t = 0,1,2,3.
+        double t1 = t-1.;
+        double t2 = t-2.;
+        double t3 = t-3.;
+        double c0 = (-1./6.) * t1*t2*t3;
+        double c1 = 0.5 * t*t2*t3;
+        double c2 = -0.5 * t*t1*t3;
+        double c3 = (1./6.) * t*t1*t2;
+
+        const double* tab0 = &(*_taptab)[r0*ntaps];
+        const double* tab1 = tab0 + ntaps;
+        const double* tab2 = tab1 + ntaps;
+        const double* tab3 = tab2 + ntaps;
+        for (int k=k1; k<=k2; ++k)
+            *wts++ = c0*tab0[k] + c1*tab1[k] + c2*tab2[k] + c3*tab3[k];
+    }
 
     double Lanczos::xval(double x) const
     {
@@ -253,7 +253,9 @@ namespace galsim {
         // plus either X and Y or 3 Lq vectors.
         const int BLOCKING_FACTOR=4096;
 
-        const int max_npts = std::max(BLOCKING_FACTOR,npts_full);
+        // The temporaries only need to hold one block.  Callers like SBShapelet's FillXValue
+        // pass in blocks that are already smaller than this, so don't allocate more than that.
+        const int max_npts = std::min(BLOCKING_FACTOR,npts_full);
         VectorXd Rsq_full(max_npts);
         MatrixXd A_full(max_npts,2);
         MatrixXd tmp_full(max_npts,2);
@@ -34,11 +34,15 @@ namespace galsim {
     };
 
     PhotonArray::PhotonArray(int N) : 
-        _N(N), _dxdz(0), _dydz(0), _wave(0), _is_correlated(false), _vx(N), _vy(N), _vflux(N)
+        _N(N), _dxdz(0), _dydz(0), _wave(0), _is_correlated(false),
+        _mem(allocateAlignedMemory<double>(3*N))
     {
-        _x = &_vx[0];
-        _y = &_vy[0];
-        _flux = &_vflux[0];
+        _x = _mem.get();
+        _y = _x + N;
+        _flux = _y + N;
+        // Pooled memory may hold values from a previous use.  Start with all zeros, as the
+        // std::vectors used to, so callers never see stale photons.
+        std::fill(_x, _x + 3*size_t(N), 0.);
     }
 
     template <typename T>
@@ -85,12 +85,19 @@ namespace galsim {
             xdbg<<"Start Poly area"<<std::endl;
             assert(_sorted);
             // Calculates the area of a polygon using the shoelace algorithm
-            for (int i=0; i<_npoints; i++) {
-                int j = (i + 1) % _npoints;
-                _area += _points[i].x * _points[j].y;
-                _area -= _points[j].x * _points[i].y;
+            // The closing term (last point to first) is done separately so the main loop
+            // doesn't need a modulus.
+            double area = 0.;
+            const Position<double>* p = _points.data();
+            for (int i=0; i<_npoints-1; i++) {
+                area += p[i].x * p[i+1].y;
+                area -= p[i+1].x * p[i].y;
+            }
+            if (_npoints > 0) {
+                area += p[_npoints-1].x * p[0].y;
+                area -= p[0].x * p[_npoints-1].y;
             }
-            _area = std::abs(_area) / 2.0;
+            _area = std::abs(area) / 2.0;
         }
         return _area;
     }
@@ -341,6 +341,13 @@ namespace galsim {
     double UniformDeviate::generate1()
     { return _devimpl->_urd(*this->_impl->_rng); }
 
+    void UniformDeviate::generateSerial(long long N, double* data)
+    {
+        boost::random::uniform_real_distribution<>& urd = _devimpl->_urd;
+        BaseDeviateImpl::rng_type& rng = *this->_impl->_rng;
+        for (long long i=0; i<N; ++i) data[i] = urd(rng);
+    }
+
     std::string UniformDeviate::make_repr(bool incl_seed)
     {
         std::ostringstream oss(" ");
@@ -32,6 +32,103 @@
 namespace galsim
 {
 
+    // Solve the least-squares problem for each mode.  NSED and NBAND are the sizes of the
+    // matrices if known at compile time, else Eigen::Dynamic.
+    template <int NSED, int NBAND>
+    static void SolveCRGModes(std::complex<double>* coef, std::complex<double>* Sigma,
+                              const double* w, const std::complex<double>* kimgs,
+                              const std::complex<double>* psf_eff_kimgs,
+                              const int nsed, const int nband, const int nkx, const int nky)
+    {
+        using Eigen::Dynamic;
+        using Eigen::InnerStride;
+        using Eigen::Stride;
+        using Eigen::Upper;
+        typedef std::complex<double> CD;
+        typedef Eigen::Matrix<CD,NBAND,NSED> MatrixA;
+        typedef Eigen::Matrix<CD,NBAND,1> VectorB;
+        typedef Eigen::Matrix<CD,NSED,1> VectorX;
+        typedef Eigen::Matrix<CD,NSED,NSED> MatrixS;
+        typedef Eigen::Matrix<double,NBAND,1> VectorW;
+        const int npix = nkx * nky;
+        const int nsedsq = nsed * nsed;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            // Each thread allocates its own workspace once, rather than once per mode.
+            MatrixA A(nband, nsed);
+            VectorB b(nband);
+            VectorX x(nsed);
+            MatrixS dxT(nsed, nsed);
+            Eigen::HouseholderQR<MatrixA> qr(nband, nsed);
+            Eigen::ColPivHouseholderQR<MatrixA> qrp(nband, nsed);
+
+            // Note: The conjugate modes filled in below are never in the range of modes that
+            // are solved directly, so the threads never write to the same elements.
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+            for (int ix=0; ix<nkx/2+1; ++ix) {
+                for (int iy=0; iy<nky; ++iy) {
+                    if ((ix == 0 || ix == nkx/2) && iy > nky/2) {
+                        // already filled in the rest of this column
+                        break;
+                    }
+                    Eigen::Map<const VectorW,0,InnerStride<> > ww(
+                        w+iy*nkx+ix, nband, InnerStride<>(npix));
+                    Eigen::Map<const MatrixA,0,Stride<Dynamic,Dynamic> > psf(
+                        psf_eff_kimgs + iy*nkx + ix, nband, nsed,
+                        Stride<Dynamic,Dynamic>(npix, npix * nsed));
+                    Eigen::Map<const VectorB,0,InnerStride<> > kimg(
+                        kimgs + iy*nkx + ix, nband, InnerStride<>(npix));
+
+                    A = ww.asDiagonal() * psf;
+                    b = ww.asDiagonal() * kimg;
+                    qr.compute(A);
+                    if (qr.matrixQR().diagonal().array().abs().minCoeff() <
+                        1.e-15*qr.matrixQR().diagonal().array().abs().maxCoeff()) {
+                        // Then (nearly) signular.  Use QRP instead.  (This should be fairly rare.)
+                        qrp.compute(A);
+                        x = qrp.solve(b);
+
+                        // A = Q R Pt
+                        // (AtA)^-1 = (PRtQtQRPt)^-1 = (PRtRPt)^-1 = P R^-1 Rt^-1 Pt
+                        const int nzp = qrp.nonzeroPivots();
+                        dxT.setIdentity();
+                        qrp.matrixR().topLeftCorner(nzp,nzp).template triangularView<Upper>()
+                            .adjoint().solveInPlace(dxT.topLeftCorner(nzp,nzp));
+                        qrp.matrixR().topLeftCorner(nzp,nzp).template triangularView<Upper>()
+                            .solveInPlace(dxT.topLeftCorner(nzp,nzp));
+                        dxT = qrp.colsPermutation() * dxT * qrp.colsPermutation().transpose();
+                    } else {
+                        x = qr.solve(b);
+                        // A = Q R
+                        // (AtA)^-1 = (RtQtQR)^-1 = (RtR)^-1 = R^-1 Rt^-1
+                        dxT.setIdentity();
+                        qr.matrixQR().topRows(nsed).template triangularView<Upper>()
+                            .adjoint().solveInPlace(dxT);
+                        qr.matrixQR().topRows(nsed).template triangularView<Upper>()
+                            .solveInPlace(dxT);
+                    }
+                    Eigen::Map<VectorX>(coef + iy*nkx*nsed + ix*nsed, nsed) = x;
+                    Eigen::Map<MatrixS>(Sigma + iy*nkx*nsedsq + ix*nsedsq, nsed, nsed) = dxT;
+
+                    if (ix > 0 && iy > 0) {
+                        int ix2 = nkx - ix;
+                        int iy2 = nky - iy;
+                        if (ix == ix2 && iy == iy2) continue;
+                        Eigen::Map<VectorX>(coef + iy2*nkx*nsed + ix2*nsed, nsed) =
+                            x.conjugate();
+                        Eigen::Map<MatrixS>(Sigma + iy2*nkx*nsedsq + ix2*nsedsq, nsed, nsed) =
+                            dxT.conjugate();
+                    }
+                }
+            }
+        }
+    }
+
     void ComputeCRGCoefficients(std::complex<double>* coef, std::complex<double>* Sigma,
                                 const double* w, const std::complex<double>* kimgs,
                                 const std::complex<double>* psf_eff_kimgs,
@@ -85,74 +182,23 @@ namespace galsim
                 Sigma[-iy, -ix] = np.conj(dx)
         */
 
-        using Eigen::MatrixXcd;
-        using Eigen::VectorXcd;
-        using Eigen::VectorXd;
-        int npix = nkx * nky;
-        int nsedsq = nsed * nsed;
-        MatrixXcd A(nband, nsed);
-        VectorXcd b(nband);
-
-        for (int ix=0; ix<nkx/2+1; ++ix) {
-            for (int iy=0; iy<nky; ++iy) {
-                if ((ix == 0 || ix == nkx/2) && iy > nky/2) {
-                    // already filled in the rest of this column
-                    break;
-                }
-                using Eigen::Dynamic;
-                using Eigen::InnerStride;
-                using Eigen::Stride;
-                using Eigen::Upper;
-                Eigen::Map<const VectorXd,0,InnerStride<> > ww(
-                    w+iy*nkx+ix, nband, InnerStride<>(npix));
-                Eigen::Map<const MatrixXcd,0,Stride<Dynamic,Dynamic> > psf(
-                    psf_eff_kimgs + iy*nkx + ix, nband, nsed,
-                    Stride<Dynamic,Dynamic>(npix, npix * nsed));
-                Eigen::Map<const VectorXcd,0,InnerStride<> > kimg(
-                    kimgs + iy*nkx + ix, nband, InnerStride<>(npix));
-                Eigen::Map<VectorXcd> x(coef + iy*nkx*nsed + ix*nsed, nsed);
-                Eigen::Map<MatrixXcd> dxT(Sigma + iy*nkx*nsedsq + ix*nsedsq, nsed, nsed);
-
-                A = ww.asDiagonal() * psf;
-                b = ww.asDiagonal() * kimg;
-                Eigen::HouseholderQR<MatrixXcd> qr = A.householderQr();
-                Eigen::Diagonal<const MatrixXcd> Rdiag = qr.matrixQR().diagonal();
-                if (Rdiag.array().abs().minCoeff() < 1.e-15*Rdiag.array().abs().maxCoeff()) {
-                    // Then (nearly) signular.  Use QRP instead.  (This should be fairly rare.)
-                    Eigen::ColPivHouseholderQR<MatrixXcd> qrp = A.colPivHouseholderQr();
-                    x = qrp.solve(b);
-
-                    // A = Q R Pt
-                    // (AtA)^-1 = (PRtQtQRPt)^-1 = (PRtRPt)^-1 = P R^-1 Rt^-1 Pt
-                    const int nzp = qrp.nonzeroPivots();
-                    Eigen::TriangularView<const Eigen::Block<const MatrixXcd>, Upper> R =
-                        qrp.matrixR().topLeftCorner(nzp,nzp).triangularView<Upper>();
-                    dxT.setIdentity();
-                    R.adjoint().solveInPlace(dxT.topLeftCorner(nzp,nzp));
-                    R.solveInPlace(dxT.topLeftCorner(nzp,nzp));
-                    dxT = qrp.colsPermutation() * dxT * qrp.colsPermutation().transpose();
-                } else {
-                    x = qr.solve(b);
-                    // A = Q R
-                    // (AtA)^-1 = (RtQtQR)^-1 = (RtR)^-1 = R^-1 Rt^-1
-                    Eigen::TriangularView<const Eigen::Block<const MatrixXcd>, Upper> R =
-                        qr.matrixQR().topRows(nsed).triangularView<Upper>();
-                    dxT.setIdentity();
-                    R.adjoint().solveInPlace(dxT);
-                    R.solveInPlace(dxT);
-                }
-
-
-                if (ix > 0 && iy > 0) {
-                    int ix2 = nkx - ix;
-                    int iy2 = nky - iy;
-                    if (ix == ix2 && iy == iy2) continue;
-                    Eigen::Map<VectorXcd>(coef + iy2*nkx*nsed + ix2*nsed, nsed) = x.conjugate();
-                    Eigen::Map<MatrixXcd>(Sigma + iy2*nkx*nsedsq + ix2*nsedsq, nsed, nsed) =
-                        dxT.conjugate();
-                }
-            }
-        }
+        // Use fixed-size matrices for the most common cases, since Eigen is much faster with
+        // these for small matrices.  (nsed > nband is underdetermined, so we don't bother.)
+        if (nsed == 1 && nband == 1)
+            SolveCRGModes<1,1>(coef, Sigma, w, kimgs, psf_eff_kimgs, nsed, nband, nkx, nky);
+        else if (nsed == 1 && nband == 2)
+            SolveCRGModes<1,2>(coef, Sigma, w, kimgs, psf_eff_kimgs, nsed, nband, nkx, nky);
+        else if (nsed == 2 && nband == 2)
+            SolveCRGModes<2,2>(coef, Sigma, w, kimgs, psf_eff_kimgs, nsed, nband, nkx, nky);
+        else if (nsed == 1 && nband == 3)
+            SolveCRGModes<1,3>(coef, Sigma, w, kimgs, psf_eff_kimgs, nsed, nband, nkx, nky);
+        else if (nsed == 2 && nband == 3)
+            SolveCRGModes<2,3>(coef, Sigma, w, kimgs, psf_eff_kimgs, nsed, nband, nkx, nky);
+        else if (nsed == 3 && nband == 3)
+            SolveCRGModes<3,3>(coef, Sigma, w, kimgs, psf_eff_kimgs, nsed, nband, nkx, nky);
+        else
+            SolveCRGModes<Eigen::Dynamic,Eigen::Dynamic>(
+                coef, Sigma, w, kimgs, psf_eff_kimgs, nsed, nband, nkx, nky);
     }
 
 }
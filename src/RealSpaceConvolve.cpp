@@ -30,6 +30,7 @@
 #endif
 
 #include <numeric>
+#include <exception>
 
 namespace galsim {
 
@@ -250,73 +251,94 @@ namespace galsim {
         }
     }
 
-    double RealSpaceConvolve(
-        const SBProfile& p1, const SBProfile& p2, const Position<double>& pos, double flux,
-        const GSParams& gsparams)
+    // The parts of the calculation that only depend on p1 and p2, not on the position.
+    // When filling an image, these are computed once, rather than once per pixel.
+    class RealSpaceConvolver
     {
-        // Coming in, if only one of them is axisymmetric, it should be p1.
-        // This cuts down on some of the logic below.
-        // Furthermore, the calculation of xmin, xmax isn't optimal if both are
-        // axisymmetric.  But that involves a bit of geometry to get the right cuts,
-        // so I didn't bother, since I don't think we'll be doing that too often.
-        // So p2 is always taken to be a rectangle rather than possibly a circle.
-        assert(p1.isAxisymmetric() || !p2.isAxisymmetric());
+    public:
+        RealSpaceConvolver(const SBProfile& p1, const SBProfile& p2, double flux,
+                           const GSParams& gsparams) :
+            _p1(p1), _p2(p2), _flux(flux), _gsparams(gsparams)
+        {
+            // Coming in, if only one of them is axisymmetric, it should be p1.
+            // This cuts down on some of the logic below.
+            // Furthermore, the calculation of xmin, xmax isn't optimal if both are
+            // axisymmetric.  But that involves a bit of geometry to get the right cuts,
+            // so I didn't bother, since I don't think we'll be doing that too often.
+            // So p2 is always taken to be a rectangle rather than possibly a circle.
+            assert(p1.isAxisymmetric() || !p2.isAxisymmetric());
+
+            p1.getXRange(_xmin1,_xmax1,_xsplits1);
+            p2.getXRange(_xmin2,_xmax2,_xsplits2);
+            dbg<<"p1 X range = "<<_xmin1<<"  "<<_xmax1<<std::endl;
+            dbg<<"p2 X range = "<<_xmin2<<"  "<<_xmax2<<std::endl;
+
+            std::vector<double> ysplits1, ysplits2;
+            p1.getYRange(_ymin1,_ymax1,ysplits1);
+            p2.getYRange(_ymin2,_ymax2,ysplits2);
+            dbg<<"p1 Y range = "<<_ymin1<<"  "<<_ymax1<<std::endl;
+            dbg<<"p2 Y range = "<<_ymin2<<"  "<<_ymax2<<std::endl;
+
+            // If either profile is infinite, then we don't need to worry about any boundary
+            // overlaps.
+            _check_overlap = (_xmin1 == -integ::MOCK_INF || _xmax2 == integ::MOCK_INF) &&
+                (_xmax1 == integ::MOCK_INF || _xmin2 == -integ::MOCK_INF);
+        }
 
+        double operator()(const Position<double>& pos) const;
+
+    private:
+        const SBProfile& _p1;
+        const SBProfile& _p2;
+        double _flux;
+        const GSParams& _gsparams;
+        double _xmin1, _xmax1, _xmin2, _xmax2;
+        double _ymin1, _ymax1, _ymin2, _ymax2;
+        std::vector<double> _xsplits1, _xsplits2;
+        bool _check_overlap;
+    };
+
+    double RealSpaceConvolver::operator()(const Position<double>& pos) const
+    {
         dbg<<"Start RealSpaceConvolve for pos = "<<pos<<std::endl;
-        double xmin1, xmax1, xmin2, xmax2;
-        std::vector<double> xsplits1, xsplits2;
-        p1.getXRange(xmin1,xmax1,xsplits1);
-        p2.getXRange(xmin2,xmax2,xsplits2);
-        dbg<<"p1 X range = "<<xmin1<<"  "<<xmax1<<std::endl;
-        dbg<<"p2 X range = "<<xmin2<<"  "<<xmax2<<std::endl;
 
         // Check for early exit
-        if (pos.x < xmin1 + xmin2 || pos.x > xmax1 + xmax2) {
+        if (pos.x < _xmin1 + _xmin2 || pos.x > _xmax1 + _xmax2) {
             dbg<<"x is outside range, so trivially 0\n";
             return 0;
         }
 
-        double ymin1, ymax1, ymin2, ymax2;
-        std::vector<double> ysplits1, ysplits2;
-        p1.getYRange(ymin1,ymax1,ysplits1);
-        p2.getYRange(ymin2,ymax2,ysplits2);
-        dbg<<"p1 Y range = "<<ymin1<<"  "<<ymax1<<std::endl;
-        dbg<<"p2 Y range = "<<ymin2<<"  "<<ymax2<<std::endl;
         // Second check for early exit
-        if (pos.y < ymin1 + ymin2 || pos.y > ymax1 + ymax2) {
+        if (pos.y < _ymin1 + _ymin2 || pos.y > _ymax1 + _ymax2) {
             dbg<<"y is outside range, so trivially 0\n";
             return 0;
         }
 
-        double xmin = std::max(xmin1, pos.x - xmax2);
-        double xmax = std::min(xmax1, pos.x - xmin2);
+        double xmin = std::max(_xmin1, pos.x - _xmax2);
+        double xmax = std::min(_xmax1, pos.x - _xmin2);
         xdbg<<"xmin..xmax = "<<xmin<<" ... "<<xmax<<std::endl;
 
         // Consolidate the splits from each profile in to a single list to use.
         std::vector<double> xsplits;
-        for(size_t k=0;k<xsplits1.size();++k) {
-            double s = xsplits1[k];
+        for(size_t k=0;k<_xsplits1.size();++k) {
+            double s = _xsplits1[k];
             xdbg<<"p1 has split at "<<s<<std::endl;
             if (s > xmin && s < xmax) xsplits.push_back(s);
         }
-        for(size_t k=0;k<xsplits2.size();++k) {
-            double s = pos.x-xsplits2[k];
-            xdbg<<"p2 has split at "<<xsplits2[k]<<", which is really (pox.x-s) "<<s<<std::endl;
+        for(size_t k=0;k<_xsplits2.size();++k) {
+            double s = pos.x-_xsplits2[k];
+            xdbg<<"p2 has split at "<<_xsplits2[k]<<", which is really (pox.x-s) "<<s<<std::endl;
             if (s > xmin && s < xmax) xsplits.push_back(s);
         }
 
-        // If either profile is infinite, then we don't need to worry about any boundary
-        // overlaps, so can skip this section.
-        if ( (xmin1 == -integ::MOCK_INF || xmax2 == integ::MOCK_INF) &&
-             (xmax1 == integ::MOCK_INF || xmin2 == -integ::MOCK_INF) ) {
-
+        if (_check_overlap) {
             // Update the xmin and xmax values if the top of one profile crosses through
             // the bottom of the other.  Then part of the nominal range will in fact
             // be disjoint.  This leads to a bunch of 0's for the inner integral which
             // makes it harder for the outer integral to converge.
-            OverlapFinder func1(p1,p2,pos,1);
+            OverlapFinder func1(_p1,_p2,pos,1);
             UpdateXRange(func1,xmin,xmax,xsplits);
-            OverlapFinder func2(p1,p2,pos,2);
+            OverlapFinder func2(_p1,_p2,pos,2);
             UpdateXRange(func2,xmin,xmax,xsplits);
 
             // Third check for early exit
@@ -329,13 +351,13 @@ namespace galsim {
             // Then we don't have zero's, but the curve being integrated over gets a bend,
             // which also makes it hard for the outer integral to converge, so we
             // want to add split points at those bends.
-            OverlapFinder func3(p1,p2,pos,3);
+            OverlapFinder func3(_p1,_p2,pos,3);
             AddSplitsAtBends(func3,xmin,xmax,xsplits);
-            OverlapFinder func4(p1,p2,pos,4);
+            OverlapFinder func4(_p1,_p2,pos,4);
             AddSplitsAtBends(func4,xmin,xmax,xsplits);
         }
 
-        ConvolveFunc conv(p1,p2,pos);
+        ConvolveFunc conv(_p1,_p2,pos);
 
 #ifdef DEBUGLOGGING
         std::ostream* integ_dbgout = Debugger::instance().do_level(3) ?
@@ -353,7 +375,7 @@ namespace galsim {
             if (s > xmin && s < xmax) xreg.addSplit(s);
         }
 
-        YRegion yreg(p1,p2,pos);
+        YRegion yreg(_p1,_p2,pos);
 
 
 #ifdef TIMING
@@ -363,8 +385,8 @@ namespace galsim {
 #endif
 
         double result = integ::int2d(conv, xreg, yreg,
-                                     gsparams.realspace_relerr,
-                                     gsparams.realspace_abserr * flux);
+                                     _gsparams.realspace_relerr,
+                                     _gsparams.realspace_abserr * _flux);
 
 #ifdef TIMING
         gettimeofday(&tp,0);
@@ -376,4 +398,70 @@ namespace galsim {
         return result;
     }
 
+    double RealSpaceConvolve(
+        const SBProfile& p1, const SBProfile& p2, const Position<double>& pos, double flux,
+        const GSParams& gsparams)
+    {
+        RealSpaceConvolver conv(p1,p2,flux,gsparams);
+        return conv(pos);
+    }
+
+    template <typename T>
+    void RealSpaceConvolveImage(
+        const SBProfile& p1, const SBProfile& p2, ImageView<T> im,
+        double x0, double dx, double dxy, double y0, double dy, double dyx,
+        double flux, const GSParams& gsparams)
+    {
+        dbg<<"Start RealSpaceConvolveImage\n";
+        dbg<<"x = "<<x0<<" + i * "<<dx<<" + j * "<<dxy<<std::endl;
+        dbg<<"y = "<<y0<<" + i * "<<dyx<<" + j * "<<dy<<std::endl;
+        const int m = im.getNCol();
+        const int n = im.getNRow();
+        T* ptr = im.getData();
+        const int stride = im.getStride();
+        assert(im.getStep() == 1);
+
+        RealSpaceConvolver conv(p1,p2,flux,gsparams);
+
+        // Each pixel is a separate (and typically fairly expensive) 2d integral, so just
+        // distribute the pixels over the threads.  The cost varies a lot from one pixel to
+        // the next (e.g. the ones outside the overlap are trivially 0), so use dynamic
+        // scheduling.
+        // The profiles' xValue functions need to be safe to call from several threads at once.
+        // (Any lazily built tables have to be guarded, since a given pixel might not need them,
+        // so there is no one pixel we could do first to set them up.)
+        // The integrator can throw (e.g. an IntFailure), which can't propagate out of an
+        // OpenMP parallel region, so save the first exception and rethrow it after the loop.
+        std::exception_ptr eptr;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,16)
+#endif
+        for (int k=0; k<m*n; ++k) {
+            try {
+                int i = k % m;
+                int j = k / m;
+                double x = x0 + i*dx + j*dxy;
+                double y = y0 + i*dyx + j*dy;
+                ptr[j*stride + i] = conv(Position<double>(x,y));
+            } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical (galsim_realspace_convolve)
+#endif
+                {
+                    if (!eptr) eptr = std::current_exception();
+                }
+            }
+        }
+        if (eptr) std::rethrow_exception(eptr);
+    }
+
+    template void RealSpaceConvolveImage(
+        const SBProfile& p1, const SBProfile& p2, ImageView<double> im,
+        double x0, double dx, double dxy, double y0, double dy, double dyx,
+        double flux, const GSParams& gsparams);
+    template void RealSpaceConvolveImage(
+        const SBProfile& p1, const SBProfile& p2, ImageView<float> im,
+        double x0, double dx, double dxy, double y0, double dy, double dyx,
+        double flux, const GSParams& gsparams);
+
 }
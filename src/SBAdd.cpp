@@ -113,6 +113,46 @@ namespace galsim {
         return kv;
     }
 
+    void SBAdd::SBAddImpl::xValueMany(const double* x, const double* y, double* val,
+                                      int n) const
+    {
+        if (n <= 0) return;
+        ConstIter pptr = _plist.begin();
+        assert(pptr != _plist.end());
+        pptr->xValueMany(x, y, val, n);
+        std::vector<double> temp(n);
+        for (++pptr; pptr != _plist.end(); ++pptr) {
+            pptr->xValueMany(x, y, &temp[0], n);
+            for (int i=0; i<n; ++i) val[i] += temp[i];
+        }
+    }
+
+    void SBAdd::SBAddImpl::kValueMany(const double* kx, const double* ky,
+                                      std::complex<double>* kval, int n) const
+    {
+        if (n <= 0) return;
+        ConstIter pptr = _plist.begin();
+        assert(pptr != _plist.end());
+        pptr->kValueMany(kx, ky, kval, n);
+        std::vector<std::complex<double> > temp(n);
+        for (++pptr; pptr != _plist.end(); ++pptr) {
+            pptr->kValueMany(kx, ky, &temp[0], n);
+            for (int i=0; i<n; ++i) kval[i] += temp[i];
+        }
+    }
+
+    bool SBAdd::SBAddImpl::useStrips(int jzero) const
+    {
+        // If jzero != 0, axisymmetric components can use the symmetry about that row to save
+        // a lot of work, which would be lost for the strips that don't include it.  So only
+        // use strips if this doesn't apply to any component.
+        if (_plist.size() == 1) return false;
+        if (jzero == 0) return true;
+        for (ConstIter pptr = _plist.begin(); pptr != _plist.end(); ++pptr)
+            if (pptr->isAxisymmetric()) return false;
+        return true;
+    }
+
     template <typename T>
     void SBAdd::SBAddImpl::fillXImage(ImageView<T> im,
                                       double x0, double dx, int izero,
@@ -121,14 +161,29 @@ namespace galsim {
         dbg<<"SBAdd fillXImage\n";
         dbg<<"x = "<<x0<<" + i * "<<dx<<", izero = "<<izero<<std::endl;
         dbg<<"y = "<<y0<<" + j * "<<dy<<", jzero = "<<jzero<<std::endl;
-        ConstIter pptr = _plist.begin();
-        assert(pptr != _plist.end());
-        GetImpl(*pptr)->fillXImage(im,x0,dx,izero,y0,dy,jzero);
-        if (++pptr != _plist.end()) {
-            ImageAlloc<T> im2(im.getBounds());
-            for (; pptr != _plist.end(); ++pptr) {
-                GetImpl(*pptr)->fillXImage(im2.view(),x0,dx,izero,y0,dy,jzero);
-                im += im2;
+        assert(!_plist.empty());
+        if (useStrips(jzero)) {
+            const int m = im.getNCol();
+            ImageAlloc<T> im2(Bounds<int>(0, m-1, 0, GetStripRows(m, sizeof(T))-1));
+            ForEachStrip(im, jzero, [&](ImageView<T> strip, int j1, int jzero1) {
+                ImageView<T> strip2 = im2[Bounds<int>(0, m-1, 0, strip.getNRow()-1)];
+                double y1 = y0 + j1*dy;
+                ConstIter pptr = _plist.begin();
+                GetImpl(*pptr)->fillXImage(strip,x0,dx,izero,y1,dy,jzero1);
+                for (++pptr; pptr != _plist.end(); ++pptr) {
+                    GetImpl(*pptr)->fillXImage(strip2,x0,dx,izero,y1,dy,jzero1);
+                    strip += strip2;
+                }
+            });
+        } else {
+            ConstIter pptr = _plist.begin();
+            GetImpl(*pptr)->fillXImage(im,x0,dx,izero,y0,dy,jzero);
+            if (++pptr != _plist.end()) {
+                ImageAlloc<T> im2(im.getBounds());
+                for (; pptr != _plist.end(); ++pptr) {
+                    GetImpl(*pptr)->fillXImage(im2.view(),x0,dx,izero,y0,dy,jzero);
+                    im += im2;
+                }
             }
         }
     }
@@ -141,16 +196,24 @@ namespace galsim {
         dbg<<"SBAdd fillXImage\n";
         dbg<<"x = "<<x0<<" + i * "<<dx<<" + j * "<<dxy<<std::endl;
         dbg<<"y = "<<y0<<" + i * "<<dyx<<" + j * "<<dy<<std::endl;
-        ConstIter pptr = _plist.begin();
-        assert(pptr != _plist.end());
-        GetImpl(*pptr)->fillXImage(im,x0,dx,dxy,y0,dy,dyx);
-        if (++pptr != _plist.end()) {
-            ImageAlloc<T> im2(im.getBounds());
-            for (; pptr != _plist.end(); ++pptr) {
-                GetImpl(*pptr)->fillXImage(im2.view(),x0,dx,dxy,y0,dy,dyx);
-                im += im2;
-            }
+        assert(!_plist.empty());
+        if (_plist.size() == 1) {
+            GetImpl(_plist.front())->fillXImage(im,x0,dx,dxy,y0,dy,dyx);
+            return;
         }
+        const int m = im.getNCol();
+        ImageAlloc<T> im2(Bounds<int>(0, m-1, 0, GetStripRows(m, sizeof(T))-1));
+        ForEachStrip(im, 0, [&](ImageView<T> strip, int j1, int) {
+            ImageView<T> strip2 = im2[Bounds<int>(0, m-1, 0, strip.getNRow()-1)];
+            double x1 = x0 + j1*dxy;
+            double y1 = y0 + j1*dy;
+            ConstIter pptr = _plist.begin();
+            GetImpl(*pptr)->fillXImage(strip,x1,dx,dxy,y1,dy,dyx);
+            for (++pptr; pptr != _plist.end(); ++pptr) {
+                GetImpl(*pptr)->fillXImage(strip2,x1,dx,dxy,y1,dy,dyx);
+                strip += strip2;
+            }
+        });
     }
 
     template <typename T>
@@ -161,14 +224,31 @@ namespace galsim {
         dbg<<"SBAdd fillKImage\n";
         dbg<<"kx = "<<kx0<<" + i * "<<dkx<<", izero = "<<izero<<std::endl;
         dbg<<"ky = "<<ky0<<" + j * "<<dky<<", jzero = "<<jzero<<std::endl;
-        ConstIter pptr = _plist.begin();
-        assert(pptr != _plist.end());
-        GetImpl(*pptr)->fillKImage(im,kx0,dkx,izero,ky0,dky,jzero);
-        if (++pptr != _plist.end()) {
-            ImageAlloc<std::complex<T> > im2(im.getBounds());
-            for (; pptr != _plist.end(); ++pptr) {
-                GetImpl(*pptr)->fillKImage(im2.view(),kx0,dkx,izero,ky0,dky,jzero);
-                im += im2;
+        assert(!_plist.empty());
+        if (useStrips(jzero)) {
+            const int m = im.getNCol();
+            ImageAlloc<std::complex<T> > im2(
+                Bounds<int>(0, m-1, 0, GetStripRows(m, sizeof(std::complex<T>))-1));
+            ForEachStrip(im, jzero, [&](ImageView<std::complex<T> > strip, int j1, int jzero1) {
+                ImageView<std::complex<T> > strip2 =
+                    im2[Bounds<int>(0, m-1, 0, strip.getNRow()-1)];
+                double ky1 = ky0 + j1*dky;
+                ConstIter pptr = _plist.begin();
+                GetImpl(*pptr)->fillKImage(strip,kx0,dkx,izero,ky1,dky,jzero1);
+                for (++pptr; pptr != _plist.end(); ++pptr) {
+                    GetImpl(*pptr)->fillKImage(strip2,kx0,dkx,izero,ky1,dky,jzero1);
+                    strip += strip2;
+                }
+            });
+        } else {
+            ConstIter pptr = _plist.begin();
+            GetImpl(*pptr)->fillKImage(im,kx0,dkx,izero,ky0,dky,jzero);
+            if (++pptr != _plist.end()) {
+                ImageAlloc<std::complex<T> > im2(im.getBounds());
+                for (; pptr != _plist.end(); ++pptr) {
+                    GetImpl(*pptr)->fillKImage(im2.view(),kx0,dkx,izero,ky0,dky,jzero);
+                    im += im2;
+                }
             }
         }
     }
@@ -181,16 +261,25 @@ namespace galsim {
         dbg<<"SBAdd fillKImage\n";
         dbg<<"kx = "<<kx0<<" + i * "<<dkx<<" + j * "<<dkxy<<std::endl;
         dbg<<"ky = "<<ky0<<" + i * "<<dkyx<<" + j * "<<dky<<std::endl;
-        ConstIter pptr = _plist.begin();
-        assert(pptr != _plist.end());
-        GetImpl(*pptr)->fillKImage(im,kx0,dkx,dkxy,ky0,dky,dkyx);
-        if (++pptr != _plist.end()) {
-            ImageAlloc<std::complex<T> > im2(im.getBounds());
-            for (; pptr != _plist.end(); ++pptr) {
-                GetImpl(*pptr)->fillKImage(im2.view(),kx0,dkx,dkxy,ky0,dky,dkyx);
-                im += im2;
-            }
+        assert(!_plist.empty());
+        if (_plist.size() == 1) {
+            GetImpl(_plist.front())->fillKImage(im,kx0,dkx,dkxy,ky0,dky,dkyx);
+            return;
         }
+        const int m = im.getNCol();
+        ImageAlloc<std::complex<T> > im2(
+            Bounds<int>(0, m-1, 0, GetStripRows(m, sizeof(std::complex<T>))-1));
+        ForEachStrip(im, 0, [&](ImageView<std::complex<T> > strip, int j1, int) {
+            ImageView<std::complex<T> > strip2 = im2[Bounds<int>(0, m-1, 0, strip.getNRow()-1)];
+            double kx1 = kx0 + j1*dkxy;
+            double ky1 = ky0 + j1*dky;
+            ConstIter pptr = _plist.begin();
+            GetImpl(*pptr)->fillKImage(strip,kx1,dkx,dkxy,ky1,dky,dkyx);
+            for (++pptr; pptr != _plist.end(); ++pptr) {
+                GetImpl(*pptr)->fillKImage(strip2,kx1,dkx,dkxy,ky1,dky,dkyx);
+                strip += strip2;
+            }
+        });
     }
 
     double SBAdd::SBAddImpl::getPositiveFlux() const
@@ -123,6 +123,12 @@ namespace galsim {
         return _knorm * _info->kValue(ksq_over_pisq);
     }
 
+    void SBAiry::SBAiryImpl::kValueRadialMany(const double* ksq, double* val, int n) const
+    {
+        for (int i=0; i<n; ++i)
+            val[i] = _knorm * _info->kValue(ksq[i] * _inv_Dsq_pisq);
+    }
+
     template <typename T>
     void SBAiry::SBAiryImpl::fillXImage(ImageView<T> im,
                                         double x0, double dx, int izero,
@@ -364,6 +370,10 @@ namespace galsim {
     void AiryInfo::shoot(PhotonArray& photons, UniformDeviate ud) const
     {
         // Use the OneDimensionalDeviate to sample from scale-free distribution
+        // Multiple threads may be shooting photons at once, so only let one build the sampler.
+#ifdef _OPENMP
+#pragma omp critical (galsim_airy_sampler)
+#endif
         checkSampler();
         assert(_sampler.get());
         _sampler->shoot(photons, ud);
@@ -244,8 +244,17 @@ namespace galsim {
         dbg<<"Box shoot: N = "<<N<<std::endl;
         dbg<<"Target flux = "<<getFlux()<<std::endl;
         double fluxPerPhoton = _flux/N;
-        for (int i=0; i<N; i++)
-            photons.setPhoton(i, _width*(ud()-0.5), _height*(ud()-0.5), fluxPerPhoton);
+        double* x = photons.getXArray();
+        double* y = photons.getYArray();
+        double* flux = photons.getFluxArray();
+        for (int i=0; i<N; i++) {
+            // N.B. Each photon draws its y deviate before its x deviate.  This is the
+            // established photon stream for Box, so keep this order to preserve existing
+            // photon-shooting results for a given seed.
+            y[i] = _height*(ud()-0.5);
+            x[i] = _width*(ud()-0.5);
+            flux[i] = fluxPerPhoton;
+        }
         dbg<<"Box Realized flux = "<<photons.getTotalFlux()<<std::endl;
     }
 
@@ -450,9 +459,9 @@ namespace galsim {
         dbg<<"Target flux = "<<getFlux()<<std::endl;
         double fluxPerPhoton = _flux/N;
         // cf. SBGaussian's shoot function
+#ifdef USE_COS_SIN
         for (int i=0; i<N; i++) {
             // First get a point uniformly distributed on unit circle
-#ifdef USE_COS_SIN
             double theta = 2.*M_PI*ud();
             double rsq = ud(); // cumulative dist function P(<r) = r^2 for unit circle
             double sint,cost;
@@ -460,16 +469,18 @@ namespace galsim {
             // Then map radius to the desired Gaussian with analytic transformation
             double r = sqrt(rsq) * _r0;;
             photons.setPhoton(i, r*cost, r*sint, fluxPerPhoton);
+        }
 #else
-            double xu, yu, rsq;
-            do {
-                xu = 2.*ud()-1.;
-                yu = 2.*ud()-1.;
-                rsq = xu*xu+yu*yu;
-            } while (rsq>=1.);
-            photons.setPhoton(i, xu * _r0, yu * _r0, fluxPerPhoton);
-#endif
+        double* x = photons.getXArray();
+        double* y = photons.getYArray();
+        double* flux = photons.getFluxArray();
+        ShootUnitCircle(ud, N, x, y, flux, false);
+        for (int i=0; i<N; i++) {
+            x[i] *= _r0;
+            y[i] *= _r0;
+            flux[i] = fluxPerPhoton;
         }
+#endif
         dbg<<"TopHat Realized flux = "<<photons.getTotalFlux()<<std::endl;
     }
 }
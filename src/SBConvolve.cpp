@@ -168,6 +168,52 @@ namespace galsim {
             throw SBError("Real-space integration of more than 2 profiles is not implemented.");
     }
 
+    bool SBConvolve::SBConvolveImpl::isQuadrantSymmetric() const
+    {
+        for (ConstIter pptr = _plist.begin(); pptr != _plist.end(); ++pptr)
+            if (!GetImpl(*pptr)->isQuadrantSymmetric()) return false;
+        return true;
+    }
+
+    template <typename T>
+    void SBConvolve::SBConvolveImpl::fillXImage(ImageView<T> im,
+                                                double x0, double dx, int izero,
+                                                double y0, double dy, int jzero) const
+    {
+        dbg<<"SBConvolve fillXImage\n";
+        dbg<<"x = "<<x0<<" + i * "<<dx<<", izero = "<<izero<<std::endl;
+        dbg<<"y = "<<y0<<" + j * "<<dy<<", jzero = "<<jzero<<std::endl;
+        if ((izero != 0 || jzero != 0) && isQuadrantSymmetric()) {
+            // The convolution of two profiles with f(x,y) = f(|x|,|y|) has the same symmetry,
+            // so we only need to do the integrals for one quadrant.
+            xdbg<<"Use Quadrant\n";
+            fillXImageQuadrant(im,x0,dx,izero,y0,dy,jzero);
+        } else {
+            fillXImage(im,x0,dx,0.,y0,dy,0.);
+        }
+    }
+
+    template <typename T>
+    void SBConvolve::SBConvolveImpl::fillXImage(ImageView<T> im,
+                                                double x0, double dx, double dxy,
+                                                double y0, double dy, double dyx) const
+    {
+        dbg<<"SBConvolve fillXImage\n";
+        dbg<<"x = "<<x0<<" + i * "<<dx<<" + j * "<<dxy<<std::endl;
+        dbg<<"y = "<<y0<<" + i * "<<dyx<<" + j * "<<dy<<std::endl;
+        if (_plist.size() == 2) {
+            // cf. xValue
+            const SBProfile& p1 = _plist.front();
+            const SBProfile& p2 = _plist.back();
+            if (p2.isAxisymmetric())
+                RealSpaceConvolveImage(p2,p1,im,x0,dx,dxy,y0,dy,dyx,_fluxProduct,this->gsparams);
+            else
+                RealSpaceConvolveImage(p1,p2,im,x0,dx,dxy,y0,dy,dyx,_fluxProduct,this->gsparams);
+        } else {
+            defaultFillXImage(im,x0,dx,dxy,y0,dy,dyx);
+        }
+    }
+
     std::complex<double> SBConvolve::SBConvolveImpl::kValue(const Position<double>& k) const
     {
         ConstIter pptr = _plist.begin();
@@ -177,6 +223,16 @@ namespace galsim {
         return kv;
     }
 
+    bool SBConvolve::SBConvolveImpl::useStrips(int jzero) const
+    {
+        // cf. SBAdd::SBAddImpl::useStrips
+        if (_plist.size() == 1) return false;
+        if (jzero == 0) return true;
+        for (ConstIter pptr = _plist.begin(); pptr != _plist.end(); ++pptr)
+            if (pptr->isAxisymmetric()) return false;
+        return true;
+    }
+
     template <typename T>
     void SBConvolve::SBConvolveImpl::fillKImage(ImageView<std::complex<T> > im,
                                                 double kx0, double dkx, int izero,
@@ -185,14 +241,31 @@ namespace galsim {
         dbg<<"SBConvolve fillKImage\n";
         dbg<<"kx = "<<kx0<<" + i * "<<dkx<<", izero = "<<izero<<std::endl;
         dbg<<"ky = "<<ky0<<" + j * "<<dky<<", jzero = "<<jzero<<std::endl;
-        ConstIter pptr = _plist.begin();
-        assert(pptr != _plist.end());
-        GetImpl(*pptr)->fillKImage(im,kx0,dkx,izero,ky0,dky,jzero);
-        if (++pptr != _plist.end()) {
-            ImageAlloc<std::complex<T> > im2(im.getBounds());
-            for (; pptr != _plist.end(); ++pptr) {
-                GetImpl(*pptr)->fillKImage(im2.view(),kx0,dkx,izero,ky0,dky,jzero);
-                im *= im2;
+        assert(!_plist.empty());
+        if (useStrips(jzero)) {
+            const int m = im.getNCol();
+            ImageAlloc<std::complex<T> > im2(
+                Bounds<int>(0, m-1, 0, GetStripRows(m, sizeof(std::complex<T>))-1));
+            ForEachStrip(im, jzero, [&](ImageView<std::complex<T> > strip, int j1, int jzero1) {
+                ImageView<std::complex<T> > strip2 =
+                    im2[Bounds<int>(0, m-1, 0, strip.getNRow()-1)];
+                double ky1 = ky0 + j1*dky;
+                ConstIter pptr = _plist.begin();
+                GetImpl(*pptr)->fillKImage(strip,kx0,dkx,izero,ky1,dky,jzero1);
+                for (++pptr; pptr != _plist.end(); ++pptr) {
+                    GetImpl(*pptr)->fillKImage(strip2,kx0,dkx,izero,ky1,dky,jzero1);
+                    strip *= strip2;
+                }
+            });
+        } else {
+            ConstIter pptr = _plist.begin();
+            GetImpl(*pptr)->fillKImage(im,kx0,dkx,izero,ky0,dky,jzero);
+            if (++pptr != _plist.end()) {
+                ImageAlloc<std::complex<T> > im2(im.getBounds());
+                for (; pptr != _plist.end(); ++pptr) {
+                    GetImpl(*pptr)->fillKImage(im2.view(),kx0,dkx,izero,ky0,dky,jzero);
+                    im *= im2;
+                }
             }
         }
     }
@@ -205,16 +278,25 @@ namespace galsim {
         dbg<<"SBConvolve fillKImage\n";
         dbg<<"kx = "<<kx0<<" + i * "<<dkx<<" + j * "<<dkxy<<std::endl;
         dbg<<"ky = "<<ky0<<" + i * "<<dkyx<<" + j * "<<dky<<std::endl;
-        ConstIter pptr = _plist.begin();
-        assert(pptr != _plist.end());
-        GetImpl(*pptr)->fillKImage(im,kx0,dkx,dkxy,ky0,dky,dkyx);
-        if (++pptr != _plist.end()) {
-            ImageAlloc<std::complex<T> > im2(im.getBounds());
-            for (; pptr != _plist.end(); ++pptr) {
-                GetImpl(*pptr)->fillKImage(im2.view(),kx0,dkx,dkxy,ky0,dky,dkyx);
-                im *= im2;
-            }
+        assert(!_plist.empty());
+        if (_plist.size() == 1) {
+            GetImpl(_plist.front())->fillKImage(im,kx0,dkx,dkxy,ky0,dky,dkyx);
+            return;
         }
+        const int m = im.getNCol();
+        ImageAlloc<std::complex<T> > im2(
+            Bounds<int>(0, m-1, 0, GetStripRows(m, sizeof(std::complex<T>))-1));
+        ForEachStrip(im, 0, [&](ImageView<std::complex<T> > strip, int j1, int) {
+            ImageView<std::complex<T> > strip2 = im2[Bounds<int>(0, m-1, 0, strip.getNRow()-1)];
+            double kx1 = kx0 + j1*dkxy;
+            double ky1 = ky0 + j1*dky;
+            ConstIter pptr = _plist.begin();
+            GetImpl(*pptr)->fillKImage(strip,kx1,dkx,dkxy,ky1,dky,dkyx);
+            for (++pptr; pptr != _plist.end(); ++pptr) {
+                GetImpl(*pptr)->fillKImage(strip2,kx1,dkx,dkxy,ky1,dky,dkyx);
+                strip *= strip2;
+            }
+        });
     }
 
     double SBConvolve::SBConvolveImpl::getPositiveFlux() const
@@ -307,6 +389,33 @@ namespace galsim {
     double SBAutoConvolve::SBAutoConvolveImpl::xValue(const Position<double>& pos) const
     { return RealSpaceConvolve(_adaptee,_adaptee,pos,getFlux(),this->gsparams); }
 
+    template <typename T>
+    void SBAutoConvolve::SBAutoConvolveImpl::fillXImage(ImageView<T> im,
+                                                        double x0, double dx, int izero,
+                                                        double y0, double dy, int jzero) const
+    {
+        dbg<<"SBAutoConvolve fillXImage\n";
+        dbg<<"x = "<<x0<<" + i * "<<dx<<", izero = "<<izero<<std::endl;
+        dbg<<"y = "<<y0<<" + j * "<<dy<<", jzero = "<<jzero<<std::endl;
+        if ((izero != 0 || jzero != 0) && isQuadrantSymmetric()) {
+            xdbg<<"Use Quadrant\n";
+            fillXImageQuadrant(im,x0,dx,izero,y0,dy,jzero);
+        } else {
+            fillXImage(im,x0,dx,0.,y0,dy,0.);
+        }
+    }
+
+    template <typename T>
+    void SBAutoConvolve::SBAutoConvolveImpl::fillXImage(ImageView<T> im,
+                                                        double x0, double dx, double dxy,
+                                                        double y0, double dy, double dyx) const
+    {
+        dbg<<"SBAutoConvolve fillXImage\n";
+        dbg<<"x = "<<x0<<" + i * "<<dx<<" + j * "<<dxy<<std::endl;
+        dbg<<"y = "<<y0<<" + i * "<<dyx<<" + j * "<<dy<<std::endl;
+        RealSpaceConvolveImage(_adaptee,_adaptee,im,x0,dx,dxy,y0,dy,dyx,getFlux(),this->gsparams);
+    }
+
     template <typename T>
     struct Square
     { T operator()(T x) { return x*x; } };
@@ -399,6 +508,35 @@ namespace galsim {
         return RealSpaceConvolve(_adaptee,temp,pos,getFlux(),this->gsparams);
     }
 
+    template <typename T>
+    void SBAutoCorrelate::SBAutoCorrelateImpl::fillXImage(ImageView<T> im,
+                                                          double x0, double dx, int izero,
+                                                          double y0, double dy, int jzero) const
+    {
+        dbg<<"SBAutoCorrelate fillXImage\n";
+        dbg<<"x = "<<x0<<" + i * "<<dx<<", izero = "<<izero<<std::endl;
+        dbg<<"y = "<<y0<<" + j * "<<dy<<", jzero = "<<jzero<<std::endl;
+        if ((izero != 0 || jzero != 0) && isQuadrantSymmetric()) {
+            xdbg<<"Use Quadrant\n";
+            fillXImageQuadrant(im,x0,dx,izero,y0,dy,jzero);
+        } else {
+            fillXImage(im,x0,dx,0.,y0,dy,0.);
+        }
+    }
+
+    template <typename T>
+    void SBAutoCorrelate::SBAutoCorrelateImpl::fillXImage(ImageView<T> im,
+                                                          double x0, double dx, double dxy,
+                                                          double y0, double dy, double dyx) const
+    {
+        dbg<<"SBAutoCorrelate fillXImage\n";
+        dbg<<"x = "<<x0<<" + i * "<<dx<<" + j * "<<dxy<<std::endl;
+        dbg<<"y = "<<y0<<" + i * "<<dyx<<" + j * "<<dy<<std::endl;
+        // Only make the flipped profile once, rather than once per pixel as in xValue.
+        SBProfile temp = _adaptee.transform(-1., 0., 0., -1.);
+        RealSpaceConvolveImage(_adaptee,temp,im,x0,dx,dxy,y0,dy,dyx,getFlux(),this->gsparams);
+    }
+
     template <typename T>
     struct AbsSquare
     { T operator()(T x) { return std::norm(x); } };
@@ -19,6 +19,8 @@
 
 //#define DEBUGLOGGING
 
+#include <algorithm>
+
 #include "SBDeltaFunction.h"
 #include "SBDeltaFunctionImpl.h"
 
@@ -77,9 +79,9 @@ namespace galsim {
         dbg<<"Target flux = "<<getFlux()<<std::endl;
 
         double fluxPerPhoton = _flux/N;
-        for (int i=0; i<N; i++) {
-            photons.setPhoton(i, 0.0, 0.0, fluxPerPhoton);
-        }
+        std::fill(photons.getXArray(), photons.getXArray()+N, 0.);
+        std::fill(photons.getYArray(), photons.getYArray()+N, 0.);
+        std::fill(photons.getFluxArray(), photons.getFluxArray()+N, fluxPerPhoton);
         dbg<<"Realized flux = "<<photons.getTotalFlux()<<std::endl;
     }
 }
@@ -115,6 +115,29 @@ namespace galsim {
         }
     }
 
+    void SBExponential::SBExponentialImpl::xValueMany(const double* x, const double* y,
+                                                      double* val, int n) const
+    {
+        for (int i=0; i<n; ++i) {
+            double r = sqrt(x[i] * x[i] + y[i] * y[i]);
+            val[i] = _norm * fmath::expd(-r * _inv_r0);
+        }
+    }
+
+    void SBExponential::SBExponentialImpl::kValueRadialMany(const double* ksq, double* val,
+                                                            int n) const
+    {
+        for (int i=0; i<n; ++i) {
+            double ksq1 = ksq[i]*_r0_sq;
+            if (ksq1 < _ksq_min) {
+                val[i] = _flux*(1. - 1.5*ksq1*(1. - 1.25*ksq1));
+            } else {
+                double ksqp1 = 1. + ksq1;
+                val[i] = _flux / (ksqp1 * sqrt(ksqp1));
+            }
+        }
+    }
+
     // A helper class for doing the inner loops in the below fill*Image functions.
     // This lets us do type-specific optimizations on just this portion.
     // First the normal (legible) version that we use if there is no SSE support. (HA!)
@@ -114,6 +114,30 @@ namespace galsim {
         }
     }
 
+    void SBGaussian::SBGaussianImpl::xValueMany(const double* x, const double* y, double* val,
+                                                int n) const
+    {
+        for (int i=0; i<n; ++i) {
+            double rsq = x[i]*x[i] + y[i]*y[i];
+            val[i] = _norm * fmath::expd( -0.5 * rsq * _inv_sigma_sq );
+        }
+    }
+
+    void SBGaussian::SBGaussianImpl::kValueRadialMany(const double* ksq, double* val,
+                                                      int n) const
+    {
+        for (int i=0; i<n; ++i) {
+            double ksq1 = ksq[i]*_sigma_sq;
+            if (ksq1 > _ksq_max) {
+                val[i] = 0.;
+            } else if (ksq1 < _ksq_min) {
+                val[i] = _flux*(1. - 0.5*ksq1*(1. - 0.25*ksq1));
+            } else {
+                val[i] = _flux * fmath::expd(-0.5*ksq1);
+            }
+        }
+    }
+
     template <typename T>
     void SBGaussian::SBGaussianImpl::fillXImage(ImageView<T> im,
                                                 double x0, double dx, int izero,
@@ -281,9 +305,9 @@ namespace galsim {
         dbg<<"Gaussian shoot: N = "<<N<<std::endl;
         dbg<<"Target flux = "<<getFlux()<<std::endl;
         double fluxPerPhoton = _flux/N;
+#ifdef USE_COS_SIN
         for (int i=0; i<N; i++) {
             // First get a point uniformly distributed on unit circle
-#ifdef USE_COS_SIN
             double theta = 2.*M_PI*ud();
             double rsq = ud(); // cumulative dist function P(<r) = r^2 for unit circle
             double sint,cost;
@@ -291,18 +315,23 @@ namespace galsim {
             // Then map radius to the desired Gaussian with analytic transformation
             double rFactor = _sigma * std::sqrt( -2. * std::log(rsq));
             photons.setPhoton(i, rFactor*cost, rFactor*sint, fluxPerPhoton);
+        }
 #else
-            double xu, yu, rsq;
-            do {
-                xu = 2.*ud()-1.;
-                yu = 2.*ud()-1.;
-                rsq = xu*xu+yu*yu;
-            } while (rsq>=1. || rsq==0.);
-            // Then map radius to the desired Gaussian with analytic transformation
+        // First get points uniformly distributed on unit circle.
+        // (Use the flux array to hold rsq until we're done with it.)
+        double* x = photons.getXArray();
+        double* y = photons.getYArray();
+        double* flux = photons.getFluxArray();
+        ShootUnitCircle(ud, N, x, y, flux, true);
+        // Then map radius to the desired Gaussian with analytic transformation
+        for (int i=0; i<N; i++) {
+            double rsq = flux[i];
             double rFactor = _sigma * std::sqrt( -2. * std::log(rsq) / rsq);
-            photons.setPhoton(i, rFactor*xu, rFactor*yu, fluxPerPhoton);
-#endif
+            x[i] *= rFactor;
+            y[i] *= rFactor;
+            flux[i] = fluxPerPhoton;
         }
+#endif
         dbg<<"Gaussian Realized flux = "<<photons.getTotalFlux()<<std::endl;
     }
 }
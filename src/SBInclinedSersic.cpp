@@ -271,10 +271,20 @@ namespace galsim {
             ky0 *= _r0;
             dky *= _r0;
 
+            // The vertical factor only depends on ky, so it only needs to be calculated once
+            // per row.  Then the face-on Sersic values for the row can be done together.
+            std::vector<double> ksq(m);
+            std::vector<double> val(m);
             for (int j=0; j<n; ++j,ky0+=dky,ptr+=skip) {
+                double ky_cosi = ky0*_cosi;
+                double kysq = ky_cosi*ky_cosi;
+                double conv = _flux * convFactor(ky0);
                 double kx = kx0;
                 for (int i=0;i<m;++i,kx+=dkx)
-                    *ptr++ = _flux * kValueHelper(kx,ky0);
+                    ksq[i] = kx*kx + kysq;
+                _info->kValueMany(&ksq[0], &val[0], m);
+                for (int i=0;i<m;++i)
+                    *ptr++ = ksq[i] > _ksq_max ? 0. : conv * val[i];
             }
         }
     }
@@ -300,11 +310,20 @@ namespace galsim {
         dky *= _r0;
         dkyx *= _r0;
 
+        std::vector<double> ksq(m);
+        std::vector<double> conv(m);
+        std::vector<double> val(m);
         for (int j=0; j<n; ++j,kx0+=dkxy,ky0+=dky,ptr+=skip) {
             double kx = kx0;
             double ky = ky0;
-            for (int i=0; i<m; ++i,kx+=dkx,ky+=dkyx)
-                *ptr++ = _flux * kValueHelper(kx,ky);
+            for (int i=0; i<m; ++i,kx+=dkx,ky+=dkyx) {
+                double ky_cosi = ky*_cosi;
+                ksq[i] = kx*kx + ky_cosi*ky_cosi;
+                conv[i] = convFactor(ky);
+            }
+            _info->kValueMany(&ksq[0], &val[0], m);
+            for (int i=0; i<m; ++i)
+                *ptr++ = ksq[i] > _ksq_max ? 0. : _flux * conv[i] * val[i];
         }
     }
 
@@ -342,6 +361,15 @@ namespace galsim {
         }
 
         // Calculate the convolution factor
+        double res_conv = convFactor(ky);
+
+        double res = res_base*res_conv;
+
+        return res;
+    }
+
+    double SBInclinedSersic::SBInclinedSersicImpl::convFactor(double ky) const
+    {
         double res_conv;
 
         double scaled_ky = _half_pi_h_sini_over_r*ky;
@@ -362,10 +390,7 @@ namespace galsim {
             xxdbg << "res_conv (normal) = " << res_conv << "; ksq_min = " << _ksq_min << std::endl;
         }
 
-
-        double res = res_base*res_conv;
-
-        return res;
+        return res_conv;
     }
 
     void SBInclinedSersic::SBInclinedSersicImpl::shoot(
@@ -103,10 +103,10 @@ namespace galsim {
         SBProfileImpl(gsparams),
         _image(image.view()), _image_bounds(image.getBounds()),
         _init_bounds(init_bounds), _nonzero_bounds(nonzero_bounds),
-        _xInterp(xInterp), _kInterp(kInterp),
+        _xInterp(xInterp), _kInterp(kInterp), _kready(false),
         _stepk(stepk), _maxk(maxk),
         _flux(INVALID), _xcentroid(INVALID), _ycentroid(INVALID),
-        _readyToShoot(false)
+        _readyToShoot(false), _shared(getSharedData(_image))
     {
         dbg<<"image bounds = "<<image.getBounds()<<std::endl;
         dbg<<"init bounds = "<<_init_bounds<<std::endl;
@@ -155,63 +155,185 @@ namespace galsim {
 
     SBInterpolatedImage::SBInterpolatedImageImpl::~SBInterpolatedImageImpl() {}
 
-    const Interpolant& SBInterpolatedImage::SBInterpolatedImageImpl::getXInterp() const
-    { return _xInterp; }
+    SBInterpolatedImage::SBInterpolatedImageImpl::SharedList
+        SBInterpolatedImage::SBInterpolatedImageImpl::_shared_list;
+    std::map<SBInterpolatedImage::SBInterpolatedImageImpl::SharedKey,
+             SBInterpolatedImage::SBInterpolatedImageImpl::SharedList::iterator>
+        SBInterpolatedImage::SBInterpolatedImageImpl::_shared_map;
+    size_t SBInterpolatedImage::SBInterpolatedImageImpl::_shared_nbytes = 0;
+    size_t SBInterpolatedImage::SBInterpolatedImageImpl::_shared_max_nbytes =
+        sbp::max_interpolated_image_cache;
+
+    // Calculate two independent 64 bit hashes of the bounds and pixel values of an image.
+    // Together, these make accidental collisions between different images vanishingly unlikely.
+    static void HashImage(const BaseImage<double>& image, uint64_t& h1, uint64_t& h2)
+    {
+        // h1 is FNV-1a, applied to whole 64 bit words rather than bytes.
+        // h2 uses the multiply-rotate mixing step of MurmurHash.
+        h1 = 14695981039346656037ULL;
+        h2 = 0x9e3779b97f4a7c15ULL;
+        const uint64_t fnv_prime = 1099511628211ULL;
+        const uint64_t c1 = 0x87c37b91114253d5ULL;
+        const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+        const Bounds<int>& b = image.getBounds();
+        const int bvals[4] = { b.getXMin(), b.getXMax(), b.getYMin(), b.getYMax() };
+        for (int k=0; k<4; ++k) {
+            uint64_t w = uint64_t(uint32_t(bvals[k]));
+            h1 = (h1 ^ w) * fnv_prime;
+            w *= c1; w = (w << 31) | (w >> 33); w *= c2;
+            h2 ^= w; h2 = (h2 << 27) | (h2 >> 37); h2 = h2*5 + 0x52dce729;
+        }
+        for (int y=b.getYMin(); y<=b.getYMax(); ++y) {
+            const double* ptr = &image(b.getXMin(),y);
+            for (int x=b.getXMin(); x<=b.getXMax(); ++x, ptr+=image.getStep()) {
+                uint64_t w;
+                std::memcpy(&w, ptr, sizeof(w));
+                h1 = (h1 ^ w) * fnv_prime;
+                w *= c1; w = (w << 31) | (w >> 33); w *= c2;
+                h2 ^= w; h2 = (h2 << 27) | (h2 >> 37); h2 = h2*5 + 0x52dce729;
+            }
+        }
+    }
 
-    const Interpolant& SBInterpolatedImage::SBInterpolatedImageImpl::getKInterp() const
-    { return _kInterp; }
+    shared_ptr<SBInterpolatedImage::SBInterpolatedImageImpl::SharedData>
+    SBInterpolatedImage::SBInterpolatedImageImpl::getSharedData(const BaseImage<double>& image)
+    {
+        uint64_t h1, h2;
+        HashImage(image, h1, h2);
+        SharedKey key(h1, h2);
+        dbg<<"image hash = "<<h1<<", "<<h2<<std::endl;
+
+        shared_ptr<SharedData> data;
+#ifdef _OPENMP
+#pragma omp critical (galsim_interpolatedimage_cache)
+#endif
+        {
+            std::map<SharedKey,SharedList::iterator>::iterator it = _shared_map.find(key);
+            if (it != _shared_map.end()) {
+                dbg<<"Found image in cache\n";
+                // Move it to the front of the list.
+                _shared_list.splice(_shared_list.begin(), _shared_list, it->second);
+                data = it->second->second;
+            } else {
+                data.reset(new SharedData());
+                _shared_list.push_front(std::make_pair(key, data));
+                _shared_map[key] = _shared_list.begin();
+                addSharedBytes(*data, sizeof(SharedData));
+            }
+        }
+        return data;
+    }
 
-    double SBInterpolatedImage::SBInterpolatedImageImpl::maxSB() const
-    { return _image.maxAbsElement(); }
+    void SBInterpolatedImage::SBInterpolatedImageImpl::addSharedBytes(
+        SharedData& data, size_t nbytes)
+    {
+        data.nbytes += nbytes;
+        if (!data.cached) return;
+        _shared_nbytes += nbytes;
+        dbg<<"InterpolatedImage cache size = "<<_shared_nbytes<<" bytes\n";
+        trimSharedData();
+    }
 
-    double SBInterpolatedImage::SBInterpolatedImageImpl::xValue(const Position<double>& pos) const
+    void SBInterpolatedImage::SBInterpolatedImageImpl::trimSharedData()
     {
-        double x = pos.x;
-        double y = pos.y;
+        // Remove the least recently used items until we are under the limit.  Always keep the
+        // most recent one, even if it is larger than the limit by itself.
+        // Note: Any SBInterpolatedImages still using the removed items keep them alive, but
+        // new ones will need to recompute them.
+        while (_shared_nbytes > _shared_max_nbytes && _shared_list.size() > 1) {
+            SharedData& old = *_shared_list.back().second;
+            dbg<<"Remove item using "<<old.nbytes<<" bytes from cache\n";
+            _shared_nbytes -= old.nbytes;
+            old.cached = false;
+            _shared_map.erase(_shared_list.back().first);
+            _shared_list.pop_back();
+        }
+    }
 
-        int p1, p2, q1, q2;  // Range over which we need to sum.
-        const double SMALL = 10.*std::numeric_limits<double>::epsilon();
+    void SBInterpolatedImage::SBInterpolatedImageImpl::ClearCache()
+    {
+#ifdef _OPENMP
+#pragma omp critical (galsim_interpolatedimage_cache)
+#endif
+        {
+            for (SharedList::iterator it=_shared_list.begin(); it!=_shared_list.end(); ++it)
+                it->second->cached = false;
+            _shared_list.clear();
+            _shared_map.clear();
+            _shared_nbytes = 0;
+        }
+    }
 
-        // If x or y are integers, only sum 1 element in that direction.
-        if (std::abs(x-std::floor(x+0.01)) < SMALL*(std::abs(x)+1)) {
-            p1 = p2 = int(std::floor(x+0.01));
-        } else {
-            p1 = int(std::ceil(x-_xInterp.xrange()));
-            p2 = int(std::floor(x+_xInterp.xrange()));
+    int SBInterpolatedImage::SBInterpolatedImageImpl::GetCacheSize()
+    {
+        int n;
+#ifdef _OPENMP
+#pragma omp critical (galsim_interpolatedimage_cache)
+#endif
+        {
+            n = int(_shared_list.size());
         }
-        if (std::abs(y-std::floor(y+0.01)) < SMALL*(std::abs(y)+1)) {
-            q1 = q2 = int(std::floor(y+0.01));
-        } else {
-            q1 = int(std::ceil(y-_xInterp.xrange()));
-            q2 = int(std::floor(y+_xInterp.xrange()));
+        return n;
+    }
+
+    size_t SBInterpolatedImage::SBInterpolatedImageImpl::GetCacheBytes()
+    {
+        size_t nbytes;
+#ifdef _OPENMP
+#pragma omp critical (galsim_interpolatedimage_cache)
+#endif
+        {
+            nbytes = _shared_nbytes;
         }
+        return nbytes;
+    }
 
-        // If either range is not in non-zero part, then value is 0.
-        if (p2 < _nonzero_bounds.getXMin() ||
-            p1 > _nonzero_bounds.getXMax() ||
-            q2 < _nonzero_bounds.getYMin() ||
-            q1 > _nonzero_bounds.getYMax()) {
-            return 0.;
+    size_t SBInterpolatedImage::SBInterpolatedImageImpl::SetCacheMaxBytes(size_t nbytes)
+    {
+        size_t old_max;
+#ifdef _OPENMP
+#pragma omp critical (galsim_interpolatedimage_cache)
+#endif
+        {
+            old_max = _shared_max_nbytes;
+            _shared_max_nbytes = nbytes;
+            trimSharedData();
         }
-        // Limit to nonzero region
-        if (p1 < _nonzero_bounds.getXMin()) p1 = _nonzero_bounds.getXMin();
-        if (p2 > _nonzero_bounds.getXMax()) p2 = _nonzero_bounds.getXMax();
-        if (q1 < _nonzero_bounds.getYMin()) q1 = _nonzero_bounds.getYMin();
-        if (q2 > _nonzero_bounds.getYMax()) q2 = _nonzero_bounds.getYMax();
+        return old_max;
+    }
 
-        // We'll need these for each row.  Save them.
-        double xwt[p2-p1+1];
-        for (int p=p1, pp=0; p<=p2; ++p, ++pp) xwt[pp] = _xInterp.xval(p-x);
+    void ClearInterpolatedImageCache()
+    { SBInterpolatedImage::SBInterpolatedImageImpl::ClearCache(); }
 
-        double sum = 0.;
-        for (int q=q1; q<=q2; ++q) {
-            double xsum = 0.;
-            for (int p=p1, pp=0; p<=p2; ++p, ++pp) {
-                xsum += xwt[pp] * _image(p,q);
-            }
-            sum += xsum * _xInterp.xval(q-y);
-        }
-        return sum;
+    int GetInterpolatedImageCacheSize()
+    { return SBInterpolatedImage::SBInterpolatedImageImpl::GetCacheSize(); }
+
+    size_t GetInterpolatedImageCacheBytes()
+    { return SBInterpolatedImage::SBInterpolatedImageImpl::GetCacheBytes(); }
+
+    size_t SetInterpolatedImageCacheMaxBytes(size_t nbytes)
+    { return SBInterpolatedImage::SBInterpolatedImageImpl::SetCacheMaxBytes(nbytes); }
+
+    const Interpolant& SBInterpolatedImage::SBInterpolatedImageImpl::getXInterp() const
+    { return _xInterp; }
+
+    const Interpolant& SBInterpolatedImage::SBInterpolatedImageImpl::getKInterp() const
+    { return _kInterp; }
+
+    double SBInterpolatedImage::SBInterpolatedImageImpl::maxSB() const
+    { return _image.maxAbsElement(); }
+
+    double SBInterpolatedImage::SBInterpolatedImageImpl::xValue(const Position<double>& pos) const
+    {
+        // Only the non-zero region of the image can contribute, so only give that part
+        // to the interpolant.
+        const int xmin = _nonzero_bounds.getXMin();
+        const int ymin = _nonzero_bounds.getYMin();
+        const int nx = _nonzero_bounds.getXMax() - xmin + 1;
+        const int ny = _nonzero_bounds.getYMax() - ymin + 1;
+        return _xInterp.interpolate2d(&_image(xmin,ymin), nx, ny, _image.getStride(),
+                                      pos.x - xmin, pos.y - ymin);
     }
 
     int WrapKIndex(int k, int No2, int N)
@@ -313,7 +435,7 @@ namespace galsim {
 
     // This is the inner loop in all of the KValue calculations, including both the regular
     // kValue method and both versions of fillKImage.
-    std::complex<double> KValueInnerLoop(int n, int p, int q, int No2, int N, double* xwt,
+    std::complex<double> KValueInnerLoop(int n, int p, int q, int No2, int N, const double* xwt,
                                          const BaseImage<std::complex<double> >& kimage)
     {
         std::complex<double> sum = 0.;
@@ -382,6 +504,26 @@ namespace galsim {
         return sum;
     }
 
+    // Sum up the contributions from the kimage given the tap weights in each direction.
+    // p1, q1 are the first kimage indices (in units of the kimage grid, before wrapping)
+    // that have nonzero weight, and np, nq are the number of weights in each direction.
+    std::complex<double> KValueSum(int p1, int np, const double* xwt,
+                                   int q1, int nq, const double* ywt,
+                                   const BaseImage<std::complex<double> >& kimage)
+    {
+        const int No2 = kimage.getBounds().getXMax();
+        const int N = No2 * 2;
+        const int pwrap1 = WrapKIndex(p1, No2, N);
+        int qwrap = WrapKIndex(q1, No2, N);
+        xdbg<<"pwrap, qwrap = "<<pwrap1<<','<<qwrap<<std::endl;
+        std::complex<double> sum = 0.;
+        for (int q=0; q<nq; ++q, ++qwrap) {
+            if (qwrap == No2) qwrap -= N;
+            sum += KValueInnerLoop(np,pwrap1,qwrap,No2,N,xwt,kimage) * ywt[q];
+        }
+        return sum;
+    }
+
     std::complex<double> SBInterpolatedImage::SBInterpolatedImageImpl::kValue(
         const Position<double>& kpos) const
     {
@@ -398,68 +540,126 @@ namespace galsim {
         dbg<<"xKernelTransform = "<<xKernelTransform<<std::endl;
 
         int No2 = _kimage->getBounds().getXMax();
-        int N = No2 * 2;
         double kscale = No2/M_PI; // This is 1/dk
         xdbg<<"kimage bounds = "<<_kimage->getBounds()<<", scale = "<<kscale<<std::endl;
         kx *= kscale;
         ky *= kscale;
 
-        int p1, p2, q1, q2;  // Range over which we need to sum.
-        // Note, unlike for xValue, whre we limited the range to the size of the image,
-        // here, we allow i,j to nominally go off the kimage bounds, in which case we
+        // Note, unlike for xValue, where we limited the range to the size of the image,
+        // here, we allow p,q to nominally go off the kimage bounds, in which case we
         // wrap around when using it, due to the periodic nature of the fft.
-        const double SMALL = 10.*std::numeric_limits<double>::epsilon();
-
-        if (std::abs(kx-std::floor(kx+0.01)) < SMALL*(std::abs(kx)+1)) {
-            // If kx or ky are integers, only sum 1 element in that direction.
-            p1 = p2 = int(std::floor(kx+0.01));
-        } else {
-            p1 = int(std::ceil(kx-_kInterp.xrange()));
-            p2 = int(std::floor(kx+_kInterp.xrange()));
-        }
-        if (std::abs(ky-std::floor(ky+0.01)) < SMALL*(std::abs(ky)+1)) {
-            q1 = q2 = int(std::floor(ky+0.01));
-        } else {
-            q1 = int(std::ceil(ky-_kInterp.xrange()));
-            q2 = int(std::floor(ky+_kInterp.xrange()));
-        }
+        const int ntaps = _kInterp.nTaps();
+        std::vector<double> xwt(ntaps);
+        std::vector<double> ywt(ntaps);
+        int p1, p2, q1, q2;  // Range over which we need to sum.
+        _kInterp.getTaps(kx, p1, p2, &xwt[0]);
+        _kInterp.getTaps(ky, q1, q2, &ywt[0]);
         dbg<<"p range = "<<p1<<"..."<<p2<<std::endl;
         dbg<<"q range = "<<q1<<"..."<<q2<<std::endl;
 
-        // We'll need these for each row.  Save them.
-        double xwt[p2-p1+1];
-        for (int p=p1, pp=0; p<=p2; ++p, ++pp) xwt[pp] = _kInterp.xval(p-kx);
-
-        std::complex<double> sum = 0.;
-        int pwrap1 = WrapKIndex(p1, No2, N);
-        int qwrap1 = WrapKIndex(q1, No2, N);
-        dbg<<"pwrap, qwrap = "<<qwrap1<<','<<qwrap1<<std::endl;
-        dbg<<"kimage bounds = "<<_kimage->getBounds()<<std::endl;
-        for (int q=q1, qwrap=qwrap1; q<=q2; ++q, ++qwrap) {
-            if (qwrap == No2) qwrap -= N;
-            std::complex<double> xsum = KValueInnerLoop(p2-p1+1,pwrap1,qwrap,No2,N,xwt,*_kimage);
-            sum += xsum * _kInterp.xval(q-ky);
-        }
-
+        std::complex<double> sum = KValueSum(p1, p2-p1+1, &xwt[0], q1, q2-q1+1, &ywt[0],
+                                             *_kimage);
         dbg<<"sum = "<<sum<<std::endl;
         sum *= xKernelTransform;
         dbg<<"sum => "<<sum<<std::endl;
         return sum;
     }
 
+    void SBInterpolatedImage::SBInterpolatedImageImpl::kValueMany(
+        const double* kx, const double* ky, std::complex<double>* kval, int n) const
+    {
+        dbg<<"evaluating kValueMany for "<<n<<" points"<<std::endl;
+        if (n <= 0) return;
+
+        // Make sure the kimage is built before we split into threads.
+        checkK();
+
+        const int No2 = _kimage->getBounds().getXMax();
+        const double kscale = No2/M_PI;
+        const int ntaps = _kInterp.nTaps();
+
+#ifdef _OPENMP
+#pragma omp parallel if (n >= 1000)
+#endif
+        {
+            std::vector<double> xwt(ntaps);
+            std::vector<double> ywt(ntaps);
+            int p1=0, p2=-1, q1=0, q2=-1;
+            double xkernel=0., ykernel=0.;
+
+            // The k positions very often come from a grid (or a transformed grid), so runs of
+            // consecutive points share the same kx or ky.  Keep the weights for the last values
+            // and only recompute them when the value changes.
+            bool have_x = false, have_y = false;
+            double last_kx=0., last_ky=0.;
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (int i=0; i<n; ++i) {
+                if (std::abs(kx[i]) > _maxk1 || std::abs(ky[i]) > _maxk1) {
+                    kval[i] = 0.;
+                    continue;
+                }
+                if (!have_x || kx[i] != last_kx) {
+                    last_kx = kx[i];
+                    have_x = true;
+                    xkernel = _xInterp.uval(kx[i]*_uscale);
+                    _kInterp.getTaps(kx[i]*kscale, p1, p2, &xwt[0]);
+                }
+                if (!have_y || ky[i] != last_ky) {
+                    last_ky = ky[i];
+                    have_y = true;
+                    ykernel = _xInterp.uval(ky[i]*_uscale);
+                    _kInterp.getTaps(ky[i]*kscale, q1, q2, &ywt[0]);
+                }
+                kval[i] = (xkernel * ykernel) *
+                    KValueSum(p1, p2-p1+1, &xwt[0], q1, q2-q1+1, &ywt[0], *_kimage);
+            }
+        }
+    }
+
     void SBInterpolatedImage::SBInterpolatedImageImpl::checkK() const
     {
-        // Conduct FFT
-        if (_kimage.get()) return;
-
-        int Nx = _image.getXMax()-_image.getXMin()+1;
-        dbg<<"Nx = "<<Nx<<std::endl;
-        Bounds<int> b(0,Nx/2,-Nx/2,Nx/2-1);
-        _kimage.reset(new ImageAlloc<std::complex<double> >(b));
-        rfft(_image, _kimage->view());
-        dbg<<"made kimage\n";
-        dbg<<"kimage bounds = "<<_kimage->getBounds()<<std::endl;
-        dbg<<"kimage flux = "<<(*_kimage)(0,0).real()<<std::endl;
+        // The acquire pairs with the release below, so if this is true, _kimage is fully set.
+        if (_kready.load(std::memory_order_acquire)) return;
+
+        // Another SBInterpolatedImage with the same image may have already done this.
+        shared_ptr<ImageAlloc<std::complex<double> > > kimage;
+#ifdef _OPENMP
+#pragma omp critical (galsim_interpolatedimage_cache)
+#endif
+        {
+            kimage = _shared->kimage;
+        }
+
+        if (!kimage) {
+            // Conduct FFT
+            int Nx = _image.getXMax()-_image.getXMin()+1;
+            dbg<<"Nx = "<<Nx<<std::endl;
+            Bounds<int> b(0,Nx/2,-Nx/2,Nx/2-1);
+            kimage.reset(new ImageAlloc<std::complex<double> >(b));
+            rfft(_image, kimage->view());
+            dbg<<"made kimage\n";
+            dbg<<"kimage bounds = "<<kimage->getBounds()<<std::endl;
+            dbg<<"kimage flux = "<<(*kimage)(0,0).real()<<std::endl;
+        }
+
+        // Several threads may get here at once, so only the first one to finish saves its
+        // kimage.  The others all use that one.
+#ifdef _OPENMP
+#pragma omp critical (galsim_interpolatedimage_cache)
+#endif
+        {
+            if (!_shared->kimage) {
+                _shared->kimage = kimage;
+                addSharedBytes(*_shared, kimage->getBounds().area() * sizeof(std::complex<double>));
+            }
+            if (!_kimage) {
+                _kimage = _shared->kimage;
+                _kready.store(true, std::memory_order_release);
+            }
+        }
     }
 
     template <typename T>
@@ -474,9 +674,7 @@ namespace galsim {
         const int m = im.getNCol();
         const int n = im.getNRow();
         T* ptr = im.getData();
-        int skip = im.getNSkip();
         assert(im.getStep() == 1);
-        const double SMALL = 10.*std::numeric_limits<double>::epsilon();
 
         // Notation: We have two images to loop over here, so there are two sets of x,y values.
         //           To distinguish them, I'll use x,y for the output image,
@@ -507,7 +705,7 @@ namespace galsim {
         xdbg<<"Old i,j ranges = "<<0<<"  "<<m<<"  "<<0<<"  "<<n<<std::endl;
         xdbg<<"New i,j ranges = "<<i1<<"  "<<i2<<"  "<<j1<<"  "<<j2<<std::endl;
 
-        // Fix up x0, y0, ptr, skip to correspond to these i,j ranges.
+        // Fix up x0, y0 to correspond to these i,j ranges.
         x0 += i1*dx;
         y0 += j1*dy;
         if (x0 < minx || x0 > maxx) { x0 += dx; ++i1; } // First points may be able to increase
@@ -519,134 +717,151 @@ namespace galsim {
             return;
         }
 
-        ptr += i1 + j1*im.getStride();
-        int mm = i2-i1;  // We'll need this new row length a few times below.
-        skip += (m - mm);
+        int mm = i2-i1;
 
         // Each point in the output image is going to be
         //
         //     I(x,y) = Sum_p,q wt(p-x) wt(q-y) _image(p,q)
         //
-        // We have a lot of points with the same x or the same y, which means that
-        // xwt and ywt values are repeated a lot.  So we want to find a way to reuse
-        // those _xInterp.xval values.
+        // This is separable, so we do it in two passes.  First we interpolate each row q of
+        // the image in the x direction onto the output columns:
         //
-        // Finally, it is most efficient if we have the innermost loop be along the
-        // direction with step=1 in both the input and output images.
+        //     rowq(i) = Sum_p wt(p-x_i) _image(p,q)
         //
-        // The way we try to meet all these goals is to build up the output image one row
-        // at a time:
+        // and then we combine these rows in the y direction for each output row:
         //
         //     I(:,j) = Sum_q wt(q-y_j) rowq(:)
         //
-        // where rowq is an array the same length as the output row.
-        // Then for each of these y,q values, we can compute rowq as
+        // The weights only depend on x_i or y_j, so we compute them all once up front.
         //
-        //     rowq(i) = Sum_p wt(p-x_i) _image(p,q)
+        // For large output images, the rowq arrays for the whole image would be much larger
+        // than the cache, so we split the output image into tiles and do both passes for
+        // one tile at a time.  This only repeats the x pass for the few rows of the image
+        // that are shared between vertically adjacent tiles.  The tiles are independent, so
+        // this also lets us do them in parallel.
         //
-        // The same set of wt(p-x) values are needed for every rowq calculation, so we
-        // compute them once and save them.  Furthermore, the complete rowq calculation for
-        // a given q is independent of y, so we save that as well.
-
+        // Finally, it is most efficient if we have the innermost loop be along the
+        // direction with step=1 in both the input and output images, which is true of
+        // both passes.
+
+        const int nn = j2-j1;
+        const int ntaps = _xInterp.nTaps();
+        const int stride = im.getStride();
+        ptr += i1 + j1*stride;
+
+        // Get the weights for each output column, limited to the nonzero region.
+        // Only the weights in that region are calculated, so there are at most nxw per column.
+        const int xmin = _nonzero_bounds.getXMin();
+        const int xmax = _nonzero_bounds.getXMax();
+        const int nxw = std::min(ntaps, xmax-xmin+1);
+        std::vector<double> xwt(mm * nxw);
+        std::vector<int> p1ar(mm);
+        std::vector<int> p2ar(mm);
         double x = x0;
-        double xwt[_xInterp.ixrange() * mm];
-        double p1ar[mm];
-        double p2ar[mm];
-        int k=0;
-        for (int i=i1; i<i2; ++i,x+=dx) {
+        for (int i=0; i<mm; ++i,x+=dx) {
             int p1,p2;
-            // If x is (basically) an integer, only 1 p value.
-            // Otherwise, have a range based on xInterp.xrange()
-            if (std::abs(x-std::floor(x+0.01)) < SMALL*(std::abs(x)+1)) {
-                p1 = p2 = int(std::floor(x+0.01));
-            } else {
-                p1 = int(std::ceil(x-_xInterp.xrange()));
-                p2 = int(std::floor(x+_xInterp.xrange()));
-            }
-            // Limit to nonzero region
-            if (p1 < _nonzero_bounds.getXMin()) p1 = _nonzero_bounds.getXMin();
-            if (p2 > _nonzero_bounds.getXMax()) p2 = _nonzero_bounds.getXMax();
-            p1ar[i-i1] = p1;
-            p2ar[i-i1] = p2;
-            xdbg<<"i = "<<i<<"  x = "<<x<<": p1,p2 = "<<p1<<','<<p2<<std::endl;
-            assert(p2-p1+1 <= _xInterp.ixrange());
-
-            for (int p=p1; p<=p2; ++p) {
-                xassert(k < _xInterp.ixrange()*mm);
-                xwt[k++] = _xInterp.xval(p-x);
-            }
+            _xInterp.getTaps(x, xmin, xmax, p1, p2, &xwt[i*nxw]);
+            p1ar[i] = p1;
+            p2ar[i] = p2;
+            xdbg<<"i = "<<i+i1<<"  x = "<<x<<": p1,p2 = "<<p1<<','<<p2<<std::endl;
+            assert(p2-p1+1 <= nxw);
         }
 
-        // The inner calculation for rowq is the same for multiple y values since it is
-        // independent of y, so each time we use the same q, the rowq array is the same.
-        // Therefore we should cache these calculations to reuse when possible.
-        std::map<int, std::vector<double> > rowq_cache;
-
-        im.setZero();
+        // Likewise for the output rows.
+        const int ymin = _nonzero_bounds.getYMin();
+        const int ymax = _nonzero_bounds.getYMax();
+        const int nyw = std::min(ntaps, ymax-ymin+1);
+        std::vector<double> ywt(nn * nyw);
+        std::vector<int> q1ar(nn);
+        std::vector<int> q2ar(nn);
         double y = y0;
-        double temp[mm];
-        for (int j=j1; j<j2; ++j,y+=dy,ptr+=skip) {
-            memset(temp, 0, mm * sizeof(double)); // Zero out temp array
-            xdbg<<"j = "<<j<<", y = "<<y<<std::endl;
-            // If y is (basically) an integer, only 1 q value.
-            // Otherwise, have a range based on xInterp.xrange()
-            // Subtlety: also keep track of the minimum q we want to keep in the cache, which
-            // may be less than q1 to account for sometimes y being integer, sometimes not.
-            int q1,q2,qmin;
-            if (std::abs(y-std::floor(y+0.01)) < SMALL*(std::abs(y)+1)) {
-                q1 = q2 = int(std::floor(y+0.01));
-                qmin = int(std::ceil(y-_xInterp.xrange()));
-            } else {
-                qmin = q1 = int(std::ceil(y-_xInterp.xrange()));
-                q2 = int(std::floor(y+_xInterp.xrange()));
-            }
-            xdbg<<"q1,q2 = "<<q1<<','<<q2<<std::endl;
-            // Limit to nonzero region
-            if (q1 < _nonzero_bounds.getYMin()) q1 = _nonzero_bounds.getYMin();
-            if (q2 > _nonzero_bounds.getYMax()) q2 = _nonzero_bounds.getYMax();
-            xdbg<<"q1,q2 => "<<q1<<','<<q2<<std::endl;
-
-            // Dump any cached rows we don't need anymore.
-            while (rowq_cache.size() > 0 && rowq_cache.begin()->first < qmin) {
-                rowq_cache.erase(rowq_cache.begin());
-            }
+        for (int j=0; j<nn; ++j,y+=dy) {
+            int q1,q2;
+            _xInterp.getTaps(y, ymin, ymax, q1, q2, &ywt[j*nyw]);
+            q1ar[j] = q1;
+            q2ar[j] = q2;
+            xdbg<<"j = "<<j+j1<<"  y = "<<y<<": q1,q2 = "<<q1<<','<<q2<<std::endl;
+            assert(q2-q1+1 <= nyw);
+        }
 
-            for (int q=q1; q<=q2; ++q) {
-                // Get rowq from cache.  If it isn't there, it will be an empty vector.
-                std::vector<double>& rowq = rowq_cache[q];
+        // With these sizes, the rowq arrays for a tile take up a few hundred KB at most
+        // (unless the output is much more coarsely sampled than the image).
+        const int tile_nx = 256;
+        const int tile_ny = 64;
+        const int ntx = (mm-1) / tile_nx + 1;
+        const int nty = (nn-1) / tile_ny + 1;
+        const int ntiles = ntx * nty;
+        dbg<<"Using "<<ntx<<" x "<<nty<<" tiles\n";
 
-                // If this rowq was not in cache, need to make it.
-                if (rowq.size() == 0) {
-                    rowq.resize(mm);
-                    double x = x0;
-                    int k=0;
-                    std::vector<double>::iterator row_it=rowq.begin();
-                    for (int i=i1; i<i2; ++i,x+=dx,++row_it) {
-                        *row_it = 0.;
-                        int p1 = p1ar[i-i1];
-                        int p2 = p2ar[i-i1];
-                        const double* imptr = &_image(p1,q);
-                        for (int p=p1; p<=p2; ++p) {
-                            *row_it += xwt[k++] * *imptr++;
+        im.setZero();
+#ifdef _OPENMP
+#pragma omp parallel if (ntiles > 1)
+#endif
+        {
+            std::vector<double> rows;
+            std::vector<char> used;
+            // Note: In addition to the efficiency gain of accumulating each output row in a
+            // small contiguous array, this is also important for accuracy if the output image
+            // is T=float, so we don't gratuitously lose precision by adding floats rather than
+            // doubles.
+            std::vector<double> temp(tile_nx);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+            for (int t=0; t<ntiles; ++t) {
+                const int ia = (t % ntx) * tile_nx;
+                const int ib = std::min(ia + tile_nx, mm);
+                const int ja = (t / ntx) * tile_ny;
+                const int jb = std::min(ja + tile_ny, nn);
+                const int nx = ib-ia;
+
+                // Find which rows of the image are needed for this tile.  If the output is
+                // sampled more coarsely than the image, not all of them are.
+                int qa = std::numeric_limits<int>::max();
+                int qb = std::numeric_limits<int>::min();
+                for (int j=ja; j<jb; ++j) {
+                    if (q1ar[j] > q2ar[j]) continue;
+                    qa = std::min(qa, q1ar[j]);
+                    qb = std::max(qb, q2ar[j]);
+                }
+                if (qa > qb) continue;  // Nothing to do.  This tile is all zeros.
+                const int nq = qb-qa+1;
+                used.assign(nq, 0);
+                for (int j=ja; j<jb; ++j)
+                    for (int q=q1ar[j]; q<=q2ar[j]; ++q) used[q-qa] = 1;
+
+                // First pass: rowq for each needed image row, but only for this tile's columns.
+                rows.resize(nq * nx);
+                for (int q=qa; q<=qb; ++q) {
+                    if (!used[q-qa]) continue;
+                    double* rowq = &rows[(q-qa) * nx];
+                    for (int i=ia; i<ib; ++i) {
+                        const int p1 = p1ar[i];
+                        const int np = p2ar[i]-p1+1;
+                        const double* wptr = &xwt[i*nxw];
+                        double sum = 0.;
+                        if (np > 0) {
+                            const double* imptr = &_image(p1,q);
+                            for (int k=0; k<np; ++k) sum += wptr[k] * imptr[k];
                         }
+                        rowq[i-ia] = sum;
                     }
                 }
 
-                // Now add that to the output row with the ywt scaling.
-                double ywt = _xInterp.xval(q-y);
-                double* tptr = temp;
-                std::vector<double>::const_iterator row_it = rowq.begin();
-                for (int i=i1; i<i2; ++i) {
-                    *tptr++ += *row_it++ * ywt;
+                // Second pass: combine the rows with the y weights.
+                for (int j=ja; j<jb; ++j) {
+                    std::fill(temp.begin(), temp.begin()+nx, 0.);
+                    const double* wptr = &ywt[j*nyw];
+                    for (int q=q1ar[j]; q<=q2ar[j]; ++q) {
+                        const double wt = *wptr++;
+                        const double* rowq = &rows[(q-qa) * nx];
+                        for (int i=0; i<nx; ++i) temp[i] += wt * rowq[i];
+                    }
+                    T* optr = ptr + j*stride + ia;
+                    for (int i=0; i<nx; ++i) optr[i] = temp[i];
                 }
             }
-            // Now finally copy onto the real output image.
-            // Note: In addition to getting a tiny efficiency gain from having temp on
-            // the stack while doing the calculation above, this is also important for
-            // accuracy if the output image is T=float, so we don't gratuitously
-            // lose precision by adding floats rather than doubles.
-            double* tptr = temp;
-            for (int i=i1; i<i2; ++i) *ptr++ = *tptr++;
         }
         dbg<<"Done SBInterpolatedImage fillXImage\n";
     }
@@ -666,9 +881,10 @@ namespace galsim {
         int skip = im.getNSkip();
         assert(im.getStep() == 1);
 
-        // In this version every _xInterp.xval call is different, so there's not really any
-        // way to save any of those calls.  The only real optimization that still applies
-        // is the min/max checks to skip places where the output is zero.
+        // In this version every interpolant weight is different, so there's not really any
+        // way to reuse them.  The only real optimizations that still apply are the min/max
+        // checks to skip places where the output is zero and getting all the weights for each
+        // direction at once with interpolate2d.
 
         // Find the min/max x and y values where the output can be nonzero.
         double minx = _nonzero_bounds.getXMin() - _xInterp.xrange();
@@ -714,13 +930,21 @@ namespace galsim {
             return;
         }
 
-        // Fix up x0, y0, ptr, skip to correspond to these i,j ranges.
+        // Fix up x0, y0 to correspond to these i,j ranges.
         x0 += i1*dx + j1*dxy;
         y0 += j1*dy + i1*dyx;
         ptr += i1 + j1*im.getStride();
         int mm = i2-i1;
         skip += (m - mm);
 
+        // The part of the image that is given to the interpolant.
+        const int xmin = _nonzero_bounds.getXMin();
+        const int ymin = _nonzero_bounds.getYMin();
+        const int nx = _nonzero_bounds.getXMax() - xmin + 1;
+        const int ny = _nonzero_bounds.getYMax() - ymin + 1;
+        const int stride = _image.getStride();
+        const double* data = &_image(xmin,ymin);
+
         im.setZero();
         for (int j=j1; j<j2; ++j,x0+=dxy,y0+=dy,ptr+=skip) {
             double x = x0;
@@ -731,34 +955,9 @@ namespace galsim {
                 // region is a parallelogram, so some points can still be sipped.
                 if (y > maxy || y < miny || x > maxx || x < minx) continue;
 
-                int p1 = int(std::ceil(x-_xInterp.xrange()));
-                int p2 = int(std::floor(x+_xInterp.xrange()));
-                int q1 = int(std::ceil(y-_xInterp.xrange()));
-                int q2 = int(std::floor(y+_xInterp.xrange()));
-                if (p1 < _nonzero_bounds.getXMin()) p1 = _nonzero_bounds.getXMin();
-                if (p2 > _nonzero_bounds.getXMax()) p2 = _nonzero_bounds.getXMax();
-                if (q1 < _nonzero_bounds.getYMin()) q1 = _nonzero_bounds.getYMin();
-                if (q2 > _nonzero_bounds.getYMax()) q2 = _nonzero_bounds.getYMax();
-
-                double xwt[p2-p1+1];
-                for (int p=p1, pp=0; p<=p2; ++p, ++pp) {
-                    xwt[pp] = _xInterp.xval(p-x);
-                }
-
-                double sum=0.;
-                for (int q=q1; q<=q2; ++q) {
-                    double ywt = _xInterp.xval(q-y);
-
-                    double xsum = 0.;
-                    const double* imptr = &_image(p1,q);
-                    for (int p=p1, pp=0; p<=p2; ++p, ++pp) {
-                        xsum += xwt[pp] * *imptr++;
-                    }
-                    sum += xsum * ywt;
-                }
                 xassert(ptr >= im.getData());
                 xassert(ptr < im.getData() + im.getNElements());
-                *ptr = sum;
+                *ptr = _xInterp.interpolate2d(data, nx, ny, stride, x-xmin, y-ymin);
             }
         }
     }
@@ -948,55 +1147,26 @@ namespace galsim {
         std::complex<T>* ptr = im.getData();
         int skip = im.getNSkip();
         assert(im.getStep() == 1);
-        checkK();
-
-        double ux0 = kx0 * _uscale;
-        double uy0 = ky0 * _uscale;
-        double dux = dkx * _uscale;
-        double duy = dky * _uscale;
-        double duxy = dkxy * _uscale;
-        double duyx = dkyx * _uscale;
 
-        int No2 = _kimage->getBounds().getXMax();
-        int N = No2 * 2;
-        double kscale = No2/M_PI;
-        kx0 *= kscale;
-        dkx *= kscale;
-        dkxy *= kscale;
-        ky0 *= kscale;
-        dky *= kscale;
-        dkyx *= kscale;
-        double maxk1 = _maxk1 * kscale;
-
-        for (int j=0; j<n; ++j,kx0+=dkxy,ky0+=dky,ux0+=duxy,uy0+=duy,ptr+=skip) {
-            double kx = kx0;
-            double ky = ky0;
-            double ux = ux0;
-            double uy = uy0;
-            for (int i=0; i<m; ++i,kx+=dkx,ky+=dkyx,ux+=dux,uy+=duyx) {
-                if (std::abs(kx) > maxk1 || std::abs(ky) > maxk1) {
-                    *ptr++ = T(0);
-                } else {
-                    int p1 = int(std::ceil(kx-_kInterp.xrange()));
-                    int p2 = int(std::floor(kx+_kInterp.xrange()));
-                    int q1 = int(std::ceil(ky-_kInterp.xrange()));
-                    int q2 = int(std::floor(ky+_kInterp.xrange()));
-
-                    double xwt[p2-p1+1];
-                    for (int p=p1, pp=0; p<=p2; ++p, ++pp) xwt[pp] = _kInterp.xval(p-kx);
-
-                    std::complex<double> sum = 0.;
-                    int pwrap1 = WrapKIndex(p1, No2, N);
-                    int qwrap1 = WrapKIndex(q1, No2, N);
-                    for (int q=q1, qwrap=qwrap1; q<=q2; ++q, ++qwrap) {
-                        if (qwrap == No2) qwrap -= N;
-                        double ywt = _kInterp.xval(q-ky);
-                        sum += ywt * KValueInnerLoop(p2-p1+1,pwrap1,qwrap,No2,N,xwt,*_kimage);
-                    }
-                    *ptr++ = _xInterp.uval(ux) * _xInterp.uval(uy) * sum;
-                }
+        // There is nothing to gain from separability here, so just make the list of all the
+        // k positions and let kValueMany do the work.
+        std::vector<double> kx(m*n);
+        std::vector<double> ky(m*n);
+        std::vector<std::complex<double> > kval(m*n);
+        int k=0;
+        for (int j=0; j<n; ++j,kx0+=dkxy,ky0+=dky) {
+            double x = kx0;
+            double y = ky0;
+            for (int i=0; i<m; ++i,x+=dkx,y+=dkyx,++k) {
+                kx[k] = x;
+                ky[k] = y;
             }
         }
+        kValueMany(&kx[0], &ky[0], &kval[0], m*n);
+
+        k=0;
+        for (int j=0; j<n; ++j,ptr+=skip)
+            for (int i=0; i<m; ++i) *ptr++ = kval[k++];
     }
 
     ConstImageView<double> SBInterpolatedImage::SBInterpolatedImageImpl::getPaddedImage() const
@@ -1125,7 +1295,28 @@ namespace galsim {
         double fluxTot = getFlux();
         double thresh = (1.-this->gsparams.folding_threshold) * fluxTot;
         dbg<<"thresh = "<<thresh<<std::endl;
-        double R = CalculateSizeContainingFlux(im, thresh);
+
+        const Bounds<int>& b = _init_bounds;
+        Tuple<int,int,int,int,double> key(b.getXMin(), b.getXMax(), b.getYMin(), b.getYMax(),
+                                          thresh);
+        double R = -1.;
+#ifdef _OPENMP
+#pragma omp critical (galsim_interpolatedimage_cache)
+#endif
+        {
+            std::map<Tuple<int,int,int,int,double>, double>::iterator it = _shared->size.find(key);
+            if (it != _shared->size.end()) R = it->second;
+        }
+        if (R < 0.) {
+            R = CalculateSizeContainingFlux(im, thresh);
+#ifdef _OPENMP
+#pragma omp critical (galsim_interpolatedimage_cache)
+#endif
+            {
+                if (_shared->size.insert(std::make_pair(key, R)).second)
+                    addSharedBytes(*_shared, sizeof(key) + sizeof(R));
+            }
+        }
 
         dbg<<"R = "<<R<<std::endl;
         // Add xInterp range in quadrature just like convolution:
@@ -1158,55 +1349,75 @@ namespace galsim {
         // Among the elements with kval > thresh, find the one with the maximum ksq
         double thresh = this->gsparams.maxk_threshold * getFlux();
         thresh *= thresh; // Since values will be |kval|^2.
-        double maxk_ix = 0.;
-        // When we get 5 rows in a row all below thresh, stop.
-        int n_below_thresh = 0;
         // Don't go past the current value of maxk
         if (max_maxk == 0.) max_maxk = _maxk;
         int max_ix = int(std::ceil(max_maxk / dk));
         if (max_ix > No2) max_ix = No2;
 
-        // We take the k value to be maximum of kx and ky.  This is appropriate, because
-        // this is how maxK() is eventually used -- it sets the size in k-space for both
-        // kx and ky when drawing.  Since kx<0 is just the conjugate of the corresponding
-        // point at (-kx,-ky), we only check the right half of the square.  i.e. the
-        // upper-right and lower-right quadrants.
-        for(int ix=0; ix<=max_ix; ++ix) {
-            xdbg<<"Start search for ix = "<<ix<<std::endl;
-            // Search along the two sides with either kx = ix or ky = ix.
-            for(int iy=0; iy<=ix; ++iy) {
-                // The bottom side of the square in the lower-right quadrant.
-                double norm_kval = fast_norm((*_kimage)(iy,-ix));
-                xdbg<<"norm_kval at "<<iy<<','<<-ix<<" = "<<norm_kval<<std::endl;
-                if (norm_kval <= thresh && iy != ix && ix != No2) {
-                    // The top side of the square in the upper-right quadrant.
-                    norm_kval = fast_norm((*_kimage)(iy,ix));
-                    xdbg<<"norm_kval at "<<iy<<','<<ix<<" = "<<norm_kval<<std::endl;
-                }
-                if (norm_kval <= thresh && iy > 0) {
-                    // The right side of the square in the lower-right quadrant.
-                    norm_kval = fast_norm((*_kimage)(ix,-iy));
-                    xdbg<<"norm_kval at "<<ix<<','<<-iy<<" = "<<norm_kval<<std::endl;
-                }
-                if (norm_kval <= thresh && ix > 0 && iy != No2) {
-                    // The right side of the square in the upper-right quadrant.
-                    // The ky argument is wrapped to positive values.
-                    norm_kval = fast_norm((*_kimage)(ix,iy));
-                    xdbg<<"norm_kval at "<<ix<<','<<iy<<" = "<<norm_kval<<std::endl;
-                }
-                if (norm_kval > thresh) {
-                    xdbg<<"This one is above thresh\n";
-                    // Mark this k value as being aboe the threshold.
-                    maxk_ix = ix;
-                    // Reset the count to 0
-                    n_below_thresh = 0;
-                    // Don't bother checking the rest of the pixels with this k value.
-                    break;
+        // Another SBInterpolatedImage with the same image may have already done this.
+        Tuple<int,double> key(max_ix, thresh);
+        double maxk_ix = -1.;
+#ifdef _OPENMP
+#pragma omp critical (galsim_interpolatedimage_cache)
+#endif
+        {
+            std::map<Tuple<int,double>, double>::iterator it = _shared->maxk.find(key);
+            if (it != _shared->maxk.end()) maxk_ix = it->second;
+        }
+        if (maxk_ix < 0.) {
+            maxk_ix = 0.;
+            // When we get 5 rows in a row all below thresh, stop.
+            int n_below_thresh = 0;
+
+            // We take the k value to be maximum of kx and ky.  This is appropriate, because
+            // this is how maxK() is eventually used -- it sets the size in k-space for both
+            // kx and ky when drawing.  Since kx<0 is just the conjugate of the corresponding
+            // point at (-kx,-ky), we only check the right half of the square.  i.e. the
+            // upper-right and lower-right quadrants.
+            for(int ix=0; ix<=max_ix; ++ix) {
+                xdbg<<"Start search for ix = "<<ix<<std::endl;
+                // Search along the two sides with either kx = ix or ky = ix.
+                for(int iy=0; iy<=ix; ++iy) {
+                    // The bottom side of the square in the lower-right quadrant.
+                    double norm_kval = fast_norm((*_kimage)(iy,-ix));
+                    xdbg<<"norm_kval at "<<iy<<','<<-ix<<" = "<<norm_kval<<std::endl;
+                    if (norm_kval <= thresh && iy != ix && ix != No2) {
+                        // The top side of the square in the upper-right quadrant.
+                        norm_kval = fast_norm((*_kimage)(iy,ix));
+                        xdbg<<"norm_kval at "<<iy<<','<<ix<<" = "<<norm_kval<<std::endl;
+                    }
+                    if (norm_kval <= thresh && iy > 0) {
+                        // The right side of the square in the lower-right quadrant.
+                        norm_kval = fast_norm((*_kimage)(ix,-iy));
+                        xdbg<<"norm_kval at "<<ix<<','<<-iy<<" = "<<norm_kval<<std::endl;
+                    }
+                    if (norm_kval <= thresh && ix > 0 && iy != No2) {
+                        // The right side of the square in the upper-right quadrant.
+                        // The ky argument is wrapped to positive values.
+                        norm_kval = fast_norm((*_kimage)(ix,iy));
+                        xdbg<<"norm_kval at "<<ix<<','<<iy<<" = "<<norm_kval<<std::endl;
+                    }
+                    if (norm_kval > thresh) {
+                        xdbg<<"This one is above thresh\n";
+                        // Mark this k value as being aboe the threshold.
+                        maxk_ix = ix;
+                        // Reset the count to 0
+                        n_below_thresh = 0;
+                        // Don't bother checking the rest of the pixels with this k value.
+                        break;
+                    }
                 }
+                xdbg<<"Done ix = "<<ix<<".  Current count = "<<n_below_thresh<<std::endl;
+                // If we get through 5 rows with nothing above the threshold, stop looking.
+                if (++n_below_thresh == 5) break;
+            }
+#ifdef _OPENMP
+#pragma omp critical (galsim_interpolatedimage_cache)
+#endif
+            {
+                if (_shared->maxk.insert(std::make_pair(key, maxk_ix)).second)
+                    addSharedBytes(*_shared, sizeof(key) + sizeof(maxk_ix));
             }
-            xdbg<<"Done ix = "<<ix<<".  Current count = "<<n_below_thresh<<std::endl;
-            // If we get through 5 rows with nothing above the threshold, stop looking.
-            if (++n_below_thresh == 5) break;
         }
         xdbg<<"Finished.  maxk_ix = "<<maxk_ix<<std::endl;
         // Add 1 to get the first row that is below the threshold.
@@ -1220,52 +1431,89 @@ namespace galsim {
     {
         if (_readyToShoot) return;
 
-        dbg<<"SBInterpolatedImage not ready to shoot.  Build _pt:\n";
+        dbg<<"SBInterpolatedImage not ready to shoot.\n";
 
-        // Build the sets holding cumulative fluxes of all Pixels
-        _positiveFlux = 0.;
-        _negativeFlux = 0.;
-        _pt.clear();
+        // Also build the interpolant's photon sampler, which is otherwise made lazily by the
+        // first shoot call.  This way shoot is safe to call from multiple threads once
+        // getPositiveFlux has been called (cf. SBProfile::shootChunks).
+        _xInterp.prepareForShoot();
 
-        Bounds<int> b = _nonzero_bounds;
-        int xStart = -((b.getXMax()-b.getXMin()+1)/2);
-        int y = -((b.getYMax()-b.getYMin()+1)/2);
+        // The pixel fluxes are convolved by the interpolant, so we need to correct the
+        // positive and negative fluxes in the same way that SBConvolve does.
+        double p2 = _xInterp.getPositiveFlux2d();
+        double n2 = _xInterp.getNegativeFlux2d();
+        dbg<<"Interpolant has positiveFlux = "<<p2<<", negativeFlux = "<<n2<<std::endl;
 
-        // We loop over the non-zero bounds, since this is the only region with any flux.
-        //
-        // ix,iy are the indices in the original image
-        // x,y are the positions relative to the center point.
-        for (int iy = b.getYMin(); iy<= b.getYMax(); ++iy, ++y) {
-            int x = xStart;
-            for (int ix = b.getXMin(); ix<= b.getXMax(); ++ix, ++x) {
-                double flux = _image(ix,iy);
-                if (flux==0.) continue;
-                if (flux > 0.) {
-                    _positiveFlux += flux;
-                } else {
-                    _negativeFlux += -flux;
+        // Another SBInterpolatedImage with the same image may have already built the tree.
+        const Bounds<int>& b = _nonzero_bounds;
+        Tuple<int,int,int,int,double> key(b.getXMin(), b.getXMax(), b.getYMin(), b.getYMax(),
+                                          p2+n2);
+        shared_ptr<const ShootData> shootdata;
+#ifdef _OPENMP
+#pragma omp critical (galsim_interpolatedimage_cache)
+#endif
+        {
+            std::map<Tuple<int,int,int,int,double>, shared_ptr<const ShootData> >::iterator it =
+                _shared->shoot.find(key);
+            if (it != _shared->shoot.end()) shootdata = it->second;
+        }
+
+        if (!shootdata) {
+            dbg<<"Build shooting tree\n";
+            shared_ptr<ShootData> data(new ShootData());
+
+            // Build the sets holding cumulative fluxes of all Pixels
+            data->positiveFlux = 0.;
+            data->negativeFlux = 0.;
+
+            int xStart = -((b.getXMax()-b.getXMin()+1)/2);
+            int y = -((b.getYMax()-b.getYMin()+1)/2);
+
+            // We loop over the non-zero bounds, since this is the only region with any flux.
+            //
+            // ix,iy are the indices in the original image
+            // x,y are the positions relative to the center point.
+            for (int iy = b.getYMin(); iy<= b.getYMax(); ++iy, ++y) {
+                int x = xStart;
+                for (int ix = b.getXMin(); ix<= b.getXMax(); ++ix, ++x) {
+                    double flux = _image(ix,iy);
+                    if (flux==0.) continue;
+                    if (flux > 0.) {
+                        data->positiveFlux += flux;
+                    } else {
+                        data->negativeFlux += -flux;
+                    }
+                    data->pt.push_back(shared_ptr<Pixel>(new Pixel(x,y,flux)));
                 }
-                _pt.push_back(shared_ptr<Pixel>(new Pixel(x,y,flux)));
+            }
+            dbg<<"positiveFlux = "<<data->positiveFlux<<", negativeFlux = "<<
+                data->negativeFlux<<std::endl;
+
+            double thresh = std::numeric_limits<double>::epsilon() *
+                (data->positiveFlux + data->negativeFlux) * (p2 + n2);
+            dbg<<"thresh = "<<thresh<<std::endl;
+            data->pt.buildTree(thresh);
+
+            // Each pixel has a Pixel, a tree Element, and the shared_ptr overheads.
+            size_t nbytes = data->pt.size() * (sizeof(Pixel) + 96);
+#ifdef _OPENMP
+#pragma omp critical (galsim_interpolatedimage_cache)
+#endif
+            {
+                std::pair<std::map<Tuple<int,int,int,int,double>,
+                                   shared_ptr<const ShootData> >::iterator, bool> ret =
+                    _shared->shoot.insert(std::make_pair(key, data));
+                if (ret.second) addSharedBytes(*_shared, nbytes);
+                shootdata = ret.first->second;
             }
         }
 
-        // The above just computes the positive and negative flux for the main image.
-        // This is convolved by the interpolant, so we need to correct these values
-        // in the same way that SBConvolve does:
-        double p1 = _positiveFlux;
-        double n1 = _negativeFlux;
-        dbg<<"positiveFlux = "<<p1<<", negativeFlux = "<<n1<<std::endl;
-        double p2 = _xInterp.getPositiveFlux2d();
-        double n2 = _xInterp.getNegativeFlux2d();
-        dbg<<"Interpolant has positiveFlux = "<<p2<<", negativeFlux = "<<n2<<std::endl;
+        double p1 = shootdata->positiveFlux;
+        double n1 = shootdata->negativeFlux;
         _positiveFlux = p1*p2 + n1*n2;
         _negativeFlux = p1*n2 + n1*p2;
         dbg<<"positiveFlux => "<<_positiveFlux<<", negativeFlux => "<<_negativeFlux<<std::endl;
-
-        double thresh = std::numeric_limits<double>::epsilon() * (_positiveFlux + _negativeFlux);
-        dbg<<"thresh = "<<thresh<<std::endl;
-        _pt.buildTree(thresh);
-
+        _shootdata = shootdata;
         _readyToShoot = true;
     }
 
@@ -1286,7 +1534,7 @@ namespace galsim {
          */
         assert(N>=0);
 
-        if (N<=0 || _pt.empty()) return;
+        if (N<=0 || _shootdata->pt.empty()) return;
         double totalAbsFlux = _positiveFlux + _negativeFlux;
         double fluxPerPhoton = totalAbsFlux / N;
         dbg<<"posFlux = "<<_positiveFlux<<", negFlux = "<<_negativeFlux<<std::endl;
@@ -1294,7 +1542,7 @@ namespace galsim {
         dbg<<"fluxPerPhoton = "<<fluxPerPhoton<<std::endl;
         for (int i=0; i<N; ++i) {
             double unitRandom = ud();
-            const shared_ptr<Pixel> p = _pt.find(unitRandom);
+            const shared_ptr<Pixel> p = _shootdata->pt.find(unitRandom);
             photons.setPhoton(i, p->x, p->y, p->isPositive ? fluxPerPhoton : -fluxPerPhoton);
         }
         dbg<<"photons.getTotalFlux = "<<photons.getTotalFlux()<<std::endl;
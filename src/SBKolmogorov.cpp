@@ -120,6 +120,13 @@ namespace galsim {
         return _flux * _info->kValue(ksq);
     }
 
+    void SBKolmogorov::SBKolmogorovImpl::kValueRadialMany(
+        const double* ksq, double* val, int n) const
+    {
+        for (int i=0; i<n; ++i)
+            val[i] = _flux * _info->kValue(ksq[i] * _inv_k0sq);
+    }
+
     template <typename T>
     void SBKolmogorov::SBKolmogorovImpl::fillXImage(ImageView<T> im,
                                                     double x0, double dx, int izero,
@@ -366,13 +373,30 @@ namespace galsim {
         // Continue until the missing flux is less than shoot_accuracy.
         double thresh = gsparams->shoot_accuracy / (2.*M_PI);
         xdbg<<"thresh  = "<<thresh<<std::endl;
-        KolmXValue xval_func(*gsparams);
+
+        // Do the Hankel transforms in batches of r values, which lets them share a single
+        // tabulation of the kValue in log(k).  As for Sersic, this choice of dlogk keeps the
+        // interpolation error there well below integration_abserr.
+        KolmKValue kvalue;
+        double dlogk = gsparams->table_spacing * sqrt(sqrt(gsparams->integration_abserr)) / 2.;
+        const int n_batch = 32;
+        std::vector<double> r_batch(n_batch);
+        std::vector<double> val_batch(n_batch);
+        int i_batch = n_batch;
 
         // Don't go over r=1.e4.  F(1.e4) ~ 1.e-14, so if we haven't stopped by then,
         // we're probably hitting numerical precision issues.
         for (double logr=-3.; logr < std::log(1.e4); logr += dlogr) {
             double r = std::exp(logr);
-            val = xval_func(r) / (2.*M_PI);
+            if (i_batch == n_batch) {
+                double logr_batch = logr;
+                for (int i=0; i<n_batch; ++i, logr_batch += dlogr)
+                    r_batch[i] = std::exp(logr_batch);
+                math::hankel_inf_many(kvalue, r_batch.data(), val_batch.data(), n_batch, 0., dlogk,
+                                      gsparams->integration_relerr, gsparams->integration_abserr);
+                i_batch = 0;
+            }
+            val = val_batch[i_batch++] / (2.*M_PI);
             dbg<<"f("<<r<<") = "<<val<<std::endl;
             _radial.addEntry(r,val);
 
@@ -277,6 +277,22 @@ namespace galsim {
         return _knorm * (this->*_kV)(ksq);
     }
 
+    void SBMoffat::SBMoffatImpl::xValueMany(const double* x, const double* y, double* val,
+                                            int n) const
+    {
+        for (int i=0; i<n; ++i) {
+            double rsq = (x[i]*x[i] + y[i]*y[i])*_inv_rD_sq;
+            if (rsq > _maxRrD_sq) val[i] = 0.;
+            else val[i] = _norm * _pow_mbeta(1.+rsq, _beta);
+        }
+    }
+
+    void SBMoffat::SBMoffatImpl::kValueRadialMany(const double* ksq, double* val, int n) const
+    {
+        for (int i=0; i<n; ++i)
+            val[i] = _knorm * (this->*_kV)(ksq[i]*_rD_sq);
+    }
+
     // Used by MoffatMaxKSolver
     double SBMoffat::SBMoffatImpl::kV2(double ksq) const
     {
@@ -630,8 +646,8 @@ namespace galsim {
         dbg<<"Target flux = "<<getFlux()<<std::endl;
         // Moffat has analytic inverse-cumulative-flux function.
         double fluxPerPhoton = _flux/N;
-        for (int i=0; i<N; i++) {
 #ifdef USE_COS_SIN
+        for (int i=0; i<N; i++) {
             // First get a point uniformly distributed on unit circle
             double theta = 2.*M_PI*ud();
             double rsq = ud(); // cumulative dist function P(<r) = r^2 for unit circle
@@ -641,20 +657,25 @@ namespace galsim {
             double newRsq = fast_pow(1. - rsq * _fluxFactor, 1. / (1. - _beta)) - 1.;
             double rFactor = _rD * std::sqrt(newRsq);
             photons.setPhoton(i, rFactor*cost, rFactor*sint, fluxPerPhoton);
+        }
 #else
-            // First get a point uniformly distributed on unit circle
-            double xu, yu, rsq;
-            do {
-                xu = 2.*ud()-1.;
-                yu = 2.*ud()-1.;
-                rsq = xu*xu+yu*yu;
-            } while (rsq>=1. || rsq==0.);
-            // Then map radius to the Moffat flux distribution
-            double newRsq = fast_pow(1. - rsq * _fluxFactor, 1. / (1. - _beta)) - 1.;
+        // First get points uniformly distributed on unit circle.
+        // (Use the flux array to hold rsq until we're done with it.)
+        double* x = photons.getXArray();
+        double* y = photons.getYArray();
+        double* flux = photons.getFluxArray();
+        ShootUnitCircle(ud, N, x, y, flux, true);
+        // Then map radius to the Moffat flux distribution
+        const double inv_1mbeta = 1. / (1. - _beta);
+        for (int i=0; i<N; i++) {
+            double rsq = flux[i];
+            double newRsq = fast_pow(1. - rsq * _fluxFactor, inv_1mbeta) - 1.;
             double rFactor = _rD * std::sqrt(newRsq / rsq);
-            photons.setPhoton(i, rFactor*xu, rFactor*yu, fluxPerPhoton);
-#endif
+            x[i] *= rFactor;
+            y[i] *= rFactor;
+            flux[i] = fluxPerPhoton;
         }
+#endif
         dbg<<"Moffat Realized flux = "<<photons.getTotalFlux()<<std::endl;
     }
 
@@ -19,6 +19,12 @@
 
 //#define DEBUGLOGGING
 
+#include <exception>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "SBProfile.h"
 #include "SBTransform.h"
 #include "SBProfileImpl.h"
@@ -74,6 +80,19 @@ namespace galsim {
         return _pimpl->kValue(k);
     }
 
+    void SBProfile::xValueMany(const double* x, const double* y, double* val, int n) const
+    {
+        assert(_pimpl.get());
+        _pimpl->xValueMany(x, y, val, n);
+    }
+
+    void SBProfile::kValueMany(const double* kx, const double* ky, std::complex<double>* kval,
+                               int n) const
+    {
+        assert(_pimpl.get());
+        _pimpl->kValueMany(kx, ky, kval, n);
+    }
+
     void SBProfile::getXRange(double& xmin, double& xmax, std::vector<double>& splits) const
     {
         assert(_pimpl.get());
@@ -153,6 +172,71 @@ namespace galsim {
         return _pimpl->shoot(photons,rng);
     }
 
+    void SBProfile::shootChunks(PhotonArray& photons, BaseDeviate rng, int chunk_size) const
+    {
+        assert(_pimpl.get());
+        if (chunk_size <= 0) throw SBError("shootChunks requires chunk_size > 0");
+        const size_t N = photons.size();
+        if (N == 0) return;
+        const int nchunks = int((N-1) / chunk_size) + 1;
+        dbg<<"shootChunks: N = "<<N<<", nchunks = "<<nchunks<<std::endl;
+
+        // Draw the seeds for all the chunks up front, so the random numbers used for each chunk
+        // don't depend on the order in which the chunks are done.
+        std::vector<long> seeds(nchunks);
+        for (int k=0; k<nchunks; ++k) {
+            // A seed of 0 means to seed from the system, which we definitely don't want here.
+            do { seeds[k] = rng.raw(); } while (seeds[k] == 0);
+        }
+
+        // Many profiles calculate their positive and negative fluxes lazily, including their
+        // photon-shooting tables in some cases (e.g. SBInterpolatedImage builds its pixel tree
+        // and its interpolant's sampler).  Make sure these are ready before starting multiple
+        // threads.  Profiles whose samplers are still built on the first shoot guard them with
+        // a critical section.
+        _pimpl->getPositiveFlux();
+        _pimpl->getNegativeFlux();
+
+        double* x = photons.getXArray();
+        double* y = photons.getYArray();
+        double* flux = photons.getFluxArray();
+        double* dxdz = photons.getDXDZArray();
+        double* dydz = photons.getDYDZArray();
+        double* wave = photons.getWavelengthArray();
+        bool is_corr = photons.isCorrelated();
+        bool any_corr = false;
+
+        // Exceptions cannot propagate out of an OpenMP parallel region, so the first one thrown
+        // by any chunk is saved and rethrown after the loop.
+        std::exception_ptr eptr;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(||:any_corr) if (nchunks > 1)
+#endif
+        for (int k=0; k<nchunks; ++k) {
+            try {
+                size_t i1 = size_t(k) * chunk_size;
+                size_t n = std::min(size_t(chunk_size), N-i1);
+                PhotonArray chunk(n, x+i1, y+i1, flux+i1,
+                                  dxdz ? dxdz+i1 : 0, dydz ? dydz+i1 : 0, wave ? wave+i1 : 0,
+                                  is_corr);
+                UniformDeviate ud(seeds[k]);
+                _pimpl->shoot(chunk, ud);
+                // Each chunk is shot with the full flux of the profile.
+                chunk.scaleFlux(double(n) / N);
+                if (chunk.isCorrelated()) any_corr = true;
+            } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical (galsim_shoot_chunks)
+#endif
+                {
+                    if (!eptr) eptr = std::current_exception();
+                }
+            }
+        }
+        if (eptr) std::rethrow_exception(eptr);
+        if (any_corr) photons.setCorrelated();
+    }
+
     double SBProfile::getPositiveFlux() const
     {
         assert(_pimpl.get());
@@ -170,9 +254,66 @@ namespace galsim {
     SBProfile::SBProfileImpl::SBProfileImpl(const GSParams& _gsparams) :
         gsparams(_gsparams) {}
 
+    // How many photons to draw deviates for at a time.
+    const int shoot_block_size = 4096;
+
+    void ShootUnitCircle(UniformDeviate ud, int N, double* x, double* y, double* rsq,
+                         bool exclude_zero)
+    {
+        // Each pair of deviates makes at most one point, so as long as we only draw 2 deviates
+        // for each point still needed, they will all be used.
+        std::vector<double> u(2*std::min(N, shoot_block_size));
+        int n = 0;
+        while (n < N) {
+            const int nu = 2*std::min(N-n, shoot_block_size);
+            ud.generateSerial(nu, &u[0]);
+            for (int k=0; k<nu; k+=2) {
+                double xu = 2.*u[k]-1.;
+                double yu = 2.*u[k+1]-1.;
+                double r2 = xu*xu+yu*yu;
+                if (r2 < 1. && !(exclude_zero && r2 == 0.)) {
+                    x[n] = xu;
+                    y[n] = yu;
+                    rsq[n] = r2;
+                    ++n;
+                }
+            }
+        }
+    }
+
     SBProfile::SBProfileImpl* SBProfile::GetImpl(const SBProfile& rhs)
     { return rhs._pimpl.get(); }
 
+    void SBProfile::SBProfileImpl::xValueMany(const double* x, const double* y, double* val,
+                                              int n) const
+    {
+        for (int i=0; i<n; ++i)
+            val[i] = xValue(Position<double>(x[i], y[i]));
+    }
+
+    void SBProfile::SBProfileImpl::kValueMany(const double* kx, const double* ky,
+                                              std::complex<double>* kval, int n) const
+    {
+        if (n <= 0) return;
+        if (isAxisymmetric()) {
+            std::vector<double> ksq(n);
+            std::vector<double> val(n);
+            for (int i=0; i<n; ++i) ksq[i] = kx[i]*kx[i] + ky[i]*ky[i];
+            kValueRadialMany(&ksq[0], &val[0], n);
+            for (int i=0; i<n; ++i) kval[i] = val[i];
+        } else {
+            for (int i=0; i<n; ++i)
+                kval[i] = kValue(Position<double>(kx[i], ky[i]));
+        }
+    }
+
+    void SBProfile::SBProfileImpl::kValueRadialMany(const double* ksq, double* val, int n) const
+    {
+        assert(isAxisymmetric());
+        for (int i=0; i<n; ++i)
+            val[i] = std::real(kValue(Position<double>(std::sqrt(ksq[i]), 0.)));
+    }
+
     SBTransform SBProfile::transform(double dudx, double dudy, double dvdx, double dvdy) const
     {
         double jac[4] = {dudx, dudy, dvdx, dvdy};
@@ -411,6 +552,136 @@ namespace galsim {
         }
     }
 
+    template <typename T>
+    void SBProfile::drawKMany(const std::vector<SBProfile>& profs,
+                              const std::vector<double>& weights,
+                              std::vector<ImageView<std::complex<T> > > images, double dk)
+    {
+        dbg<<"Start drawKMany: \n";
+        const int nprof = profs.size();
+        const int nim = images.size();
+        dbg<<"nprof = "<<nprof<<", nim = "<<nim<<std::endl;
+        if (int(weights.size()) != nprof)
+            throw SBError("drawKMany requires the same number of weights and profiles");
+        if (nim == 0) throw SBError("drawKMany requires at least one image");
+        const bool sum = (nim == 1 && nprof != 1);
+        if (!sum && nim != nprof)
+            throw SBError("drawKMany requires either one image or one image per profile");
+        for (int k=0; k<nprof; ++k) {
+            assert(profs[k]._pimpl.get());
+            if (!profs[k]._pimpl->isAxisymmetric())
+                throw SBError("drawKMany requires axisymmetric profiles");
+        }
+        const Bounds<int> b = images[0].getBounds();
+        for (int k=0; k<nim; ++k) {
+            assert(images[k].getStep() == 1);
+            if (images[k].getBounds() != b)
+                throw SBError("drawKMany requires all images to have the same bounds");
+        }
+        if (!b.isDefined()) return;
+
+        // The k values only depend on (|i|,|j|), and the radial profile only on
+        // (min(|i|,|j|), max(|i|,|j|)), so only evaluate the profiles at those distinct pairs.
+        // Pair (a,b) with a <= b is stored at index off(a) + b - a.
+        const int xmin = b.getXMin(), xmax = b.getXMax();
+        const int ymin = b.getYMin(), ymax = b.getYMax();
+        const int imax = std::max(std::abs(xmin), std::abs(xmax));
+        const int jmax = std::max(std::abs(ymin), std::abs(ymax));
+        const int amax = std::min(imax, jmax);
+        const int bmax = std::max(imax, jmax);
+        const int nk = (amax+1) * (bmax+1) - amax*(amax+1)/2;
+        std::vector<double> ksq(nk);
+        for (int a=0, ik=0; a<=amax; ++a)
+            for (int bb=a; bb<=bmax; ++bb, ++ik)
+                ksq[ik] = (double(a)*a + double(bb)*bb) * dk*dk;
+
+        // The index into ksq for each pixel, in image order.
+        const int ncol = b.getXMax()-b.getXMin()+1;
+        const int nrow = b.getYMax()-b.getYMin()+1;
+        std::vector<int> index(size_t(ncol)*nrow);
+        for (int y=ymin, ip=0; y<=ymax; ++y) {
+            for (int x=xmin; x<=xmax; ++x, ++ip) {
+                int a = std::min(std::abs(x), std::abs(y));
+                int bb = std::max(std::abs(x), std::abs(y));
+                index[ip] = a*(bmax+1) - a*(a-1)/2 + bb - a;
+            }
+        }
+
+        // Some profiles build their tables lazily.  Make sure they are ready before starting
+        // multiple threads.
+        std::vector<double> val(size_t(nk) * (sum ? 1 : nprof), 0.);
+        for (int k=0; k<nprof; ++k) {
+            double v0;
+            profs[k]._pimpl->kValueRadialMany(&ksq[0], &v0, 1);
+        }
+
+        if (sum) {
+            // Each thread sums a contiguous range of the profiles into its own partial sum.
+            // These are added together in thread order after the parallel region, so the
+            // result doesn't depend on the timing of the threads.
+            int nthreads = 1;
+#ifdef _OPENMP
+            nthreads = omp_get_max_threads();
+#endif
+            std::vector<double> partial(size_t(nk) * nthreads, 0.);
+            int nused = 1;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+            {
+                int thisThread = 0;
+                int numThreads = 1;
+#ifdef _OPENMP
+                thisThread = omp_get_thread_num();
+                numThreads = omp_get_num_threads();
+                if (thisThread == 0) nused = numThreads;
+#endif
+                const int k1 = int(long(nprof) * thisThread / numThreads);
+                const int k2 = int(long(nprof) * (thisThread+1) / numThreads);
+                std::vector<double> vk(nk);
+                double* acc = &partial[size_t(thisThread)*nk];
+                for (int k=k1; k<k2; ++k) {
+                    profs[k]._pimpl->kValueRadialMany(&ksq[0], &vk[0], nk);
+                    const double w = weights[k];
+                    for (int ik=0; ik<nk; ++ik) acc[ik] += w * vk[ik];
+                }
+            }
+            for (int t=0; t<nused; ++t) {
+                const double* acc = &partial[size_t(t)*nk];
+                for (int ik=0; ik<nk; ++ik) val[ik] += acc[ik];
+            }
+        } else {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+            {
+                std::vector<double> vk(nk);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+                for (int k=0; k<nprof; ++k) {
+                    profs[k]._pimpl->kValueRadialMany(&ksq[0], &vk[0], nk);
+                    const double w = weights[k];
+                    double* vp = &val[size_t(k)*nk];
+                    for (int ik=0; ik<nk; ++ik) vp[ik] = w * vk[ik];
+                }
+            }
+        }
+
+        // Scatter the radial values onto the images.
+#ifdef _OPENMP
+#pragma omp parallel for if (nim > 1)
+#endif
+        for (int k=0; k<nim; ++k) {
+            const double* vp = &val[size_t(k)*nk];
+            std::complex<T>* ptr = images[k].getData();
+            const int skip = images[k].getNSkip();
+            for (int j=0, ip=0; j<nrow; ++j, ptr+=skip)
+                for (int i=0; i<ncol; ++i, ++ip)
+                    *ptr++ = vp[index[ip]];
+        }
+    }
+
     // The type of T (real or complex) determines whether the call-back is to
     // fillXImage or fillKImage.
     template <typename T>
@@ -492,6 +763,15 @@ namespace galsim {
         FillQuadrant(*this,im,kx0,dkx,nkx1,ky0,dky,nky1);
     }
 
+    int GetStripRows(int ncol, int elem_size)
+    {
+        // Aim for strips of around 256 KB, which should fit in L2 cache along with the
+        // corresponding part of the output image.  But don't use strips that are too thin,
+        // since some profiles have some setup cost per call that is proportional to ncol.
+        const int target_bytes = 256 * 1024;
+        return std::max(target_bytes / std::max(ncol * elem_size, 1), 16);
+    }
+
     void GetKValueRange1d(int& i1, int& i2, int m, double kmax, double ksqmax,
                           double kx0, double dkx, double ky, double& kysq)
     {
@@ -585,6 +865,13 @@ namespace galsim {
     template void SBProfile::drawK(ImageView<std::complex<double> > image, double dk,
                                    double* jac) const;
 
+    template void SBProfile::drawKMany(
+        const std::vector<SBProfile>& profs, const std::vector<double>& weights,
+        std::vector<ImageView<std::complex<float> > > images, double dk);
+    template void SBProfile::drawKMany(
+        const std::vector<SBProfile>& profs, const std::vector<double>& weights,
+        std::vector<ImageView<std::complex<double> > > images, double dk);
+
     template void SBProfile::SBProfileImpl::defaultFillXImage(
         ImageView<double> im,
         double x0, double dx, int izero, double y0, double dy, int jzero) const;
@@ -26,6 +26,8 @@
 #include "math/Bessel.h"
 #include "math/Gamma.h"
 #include "math/Hankel.h"
+#include <fstream>
+#include <exception>
 
 #ifdef DEBUGLOGGING
 #include <ctime>
@@ -114,23 +116,29 @@ namespace galsim {
     //
     //
 
-    SKInfo::SKInfo(double kcrit, const GSParamsPtr& gsparams) :
+    SKInfo::SKInfo(double kcrit, const GSParamsPtr& gsparams, bool use_table) :
         _kcrit(kcrit), _gsparams(gsparams),
         _radial(Table::spline),
         _kvLUT(Table::spline)
     {
+        // If kcrit is in the range of the universal table, then interpolate the values from
+        // there rather than doing the integrals.
+        shared_ptr<TableBuilder> etab, ftab;
+        if (use_table) SKUniversalTable::Get(gsparams)->getTables(kcrit, etab, ftab);
+        dbg<<"use_table = "<<bool(etab)<<std::endl;
+
         // build the radial function
 #ifdef DEBUGLOGGING
         std::clock_t t0 = std::clock();
-        _buildKVLUT();
+        _buildKVLUT(etab.get());
         std::clock_t t1 = std::clock();
-        _buildRadial();
+        _buildRadial(ftab.get());
         std::clock_t t2 = std::clock();
         dbg << "buildKV time = " << (double)(t1-t0)/CLOCKS_PER_SEC << '\n';
         dbg << "buildRad time = " << (double)(t2-t1)/CLOCKS_PER_SEC << '\n';
 #else
-        _buildKVLUT();
-        _buildRadial();
+        _buildKVLUT(etab.get());
+        _buildRadial(ftab.get());
 #endif
     }
 
@@ -170,7 +178,20 @@ namespace galsim {
         return result;
     }
 
-    void SKInfo::_buildKVLUT() {
+    void SKInfo::_kvValue(double k, const Table* etab, double& sf, double& kv) const
+    {
+        if (etab) {
+            // Spline overshoots can make very small values of E slightly negative.
+            double E = std::max((*etab)(k), 1.e-300);
+            sf = -2.*std::log(E);
+            kv = E - _delta;
+        } else {
+            sf = structureFunction(k);
+            kv = fmath::expd(-0.5*sf)-_delta;
+        }
+    }
+
+    void SKInfo::_buildKVLUT(const Table* etab) {
         // Start with 10x the regular Kolmogorov maxk (fairly arbitrarily)
         _maxk = 10*std::pow(-std::log(_gsparams->kvalue_accuracy),3./5.);
 
@@ -197,9 +218,9 @@ namespace galsim {
         double k=0.;
         _kvLUT.addEntry(0, 1.-_delta);
         for (k=dk; k<1.; k+=dk) {
-            double val = structureFunction(k);
+            double val, kv;
+            _kvValue(k, etab, val, kv);
             xdbg<<"sf("<<k<<") "<<val<<std::endl;
-            double kv = fmath::expd(-0.5*val)-_delta;
             dbg<<"kv("<<k<<") "<<kv<<std::endl;
             _kvLUT.addEntry(k, kv);
             if (val > limit) { k += dk; break; }
@@ -208,9 +229,9 @@ namespace galsim {
         double expdlogk = exp(dk);
         int nsmall=0;
         for (; k<_maxk; k*=expdlogk) {
-            double val = structureFunction(k);
+            double val, kv;
+            _kvValue(k, etab, val, kv);
             xdbg<<"sf("<<k<<") "<<val<<std::endl;
-            double kv = fmath::expd(-0.5*val)-_delta;
             dbg<<"kv("<<k<<") "<<kv<<std::endl;
             _kvLUT.addEntry(k, kv);
             if (std::abs(kv) < _gsparams->kvalue_accuracy) {
@@ -283,7 +304,7 @@ namespace galsim {
         return result;
     }
 
-    void SKInfo::_buildRadial() {
+    void SKInfo::_buildRadial(const Table* ftab) {
         //set_verbose(2);
         if (_delta > 1.-_gsparams->folding_threshold) {
             dbg<<"large delta = "<<_delta<<std::endl;
@@ -301,7 +322,7 @@ namespace galsim {
             return;
         }
 
-        double val = xValueRaw(0.0);
+        double val = ftab ? (*ftab)(0.) : xValueRaw(0.0);
         xdbg<<"f(0) = "<<val<<std::endl;
 
         double dr = _gsparams->table_spacing * sqrt(sqrt(_gsparams->xvalue_accuracy / 10.));
@@ -323,7 +344,7 @@ namespace galsim {
         // Continue until accumulate 0.999 of the flux
         int nsmall=0;
         for (; r<1.; r+=dr) {
-            val = xValueRaw(r);
+            val = ftab ? (*ftab)(r) : xValueRaw(r);
             xdbg<<"f("<<r<<") = "<<val<<std::endl;
 
             // The result should be positive, but numerical inaccuracies can mean that some
@@ -347,7 +368,7 @@ namespace galsim {
         double expdlogr = std::exp(dr);
         nsmall=0;
         for (; r<maxR; r *= expdlogr) {
-            val = xValueRaw(r);
+            val = ftab ? (*ftab)(r) : xValueRaw(r);
             xdbg<<"f("<<r<<") = "<<val<<std::endl;
 
             // The result should be positive, but numerical inaccuracies can mean that some
@@ -395,6 +416,233 @@ namespace galsim {
         _sampler->shoot(photons,ud);
     }
 
+    //
+    //
+    //
+    //SKUniversalTable
+    //
+    //
+    //
+
+    // The grid points are at kcrit = 0.2 * 10^((i - sk_table_i02) * sk_table_dlogkcrit)
+    // for i = 0..sk_table_nkcrit-1, so the default kcrit = 0.2 is one of them.
+    const double sk_table_dlogkcrit = 0.025;
+    const int sk_table_i02 = 53;
+    const int sk_table_nkcrit = 122;
+    // The largest errors of the interpolated f(r), relative to f(0), and of E(k).  The table is
+    // only used when xvalue_accuracy and kvalue_accuracy are at least this large.
+    const double sk_table_xaccuracy = 3.e-3;
+    const double sk_table_kaccuracy = 3.e-6;
+    // Increment this when the nodes change, so old table files are not used.
+    const int sk_table_version = 1;
+
+    inline double SKTableKCrit(int i)
+    { return 0.2 * std::pow(10., (i - sk_table_i02) * sk_table_dlogkcrit); }
+
+    LRUCache<GSParamsPtr,SKUniversalTable> SKUniversalTable::cache(sbp::max_SK_table_cache);
+
+    SKUniversalTable::SKUniversalTable(const GSParamsPtr& gsparams) :
+        _gsparams(gsparams), _grid(sk_table_nkcrit)
+    {
+        // The k and r values follow the same pattern as SKInfo::_buildKVLUT and _buildRadial,
+        // but with twice the density, since the values are interpolated again for the final
+        // tables.  k goes all the way to the largest possible maxk, and r to the largest
+        // possible maxR.
+        double dk = 0.5 * _gsparams->table_spacing * sqrt(sqrt(_gsparams->kvalue_accuracy / 10.));
+        double maxk = 10*std::pow(-std::log(_gsparams->kvalue_accuracy),3./5.);
+        double k = 0.;
+        for (; k<1.; k+=dk) _k.push_back(k);
+        for (double expdlogk = exp(dk); k<maxk*expdlogk; k*=expdlogk) _k.push_back(k);
+
+        double dr = 0.5 * _gsparams->table_spacing * sqrt(sqrt(_gsparams->xvalue_accuracy / 10.));
+        const double maxR = 1000.;
+        double r = 0.;
+        for (; r<1.; r+=dr) _r.push_back(r);
+        for (double expdlogr = exp(dr); r<maxR*expdlogr; r*=expdlogr) _r.push_back(r);
+    }
+
+    shared_ptr<SKUniversalTable> SKUniversalTable::Get(const GSParamsPtr& gsparams)
+    {
+        shared_ptr<SKUniversalTable> table;
+#ifdef _OPENMP
+#pragma omp critical (galsim_secondkick_table)
+#endif
+        table = cache.get(gsparams);
+        return table;
+    }
+
+    void SKUniversalTable::Clear()
+    {
+#ifdef _OPENMP
+#pragma omp critical (galsim_secondkick_table)
+#endif
+        cache.clear();
+    }
+
+    shared_ptr<const SKUniversalTable::Node> SKUniversalTable::buildNode(int i) const
+    {
+        double kcrit = SKTableKCrit(i);
+        dbg<<"Build SecondKick table node "<<i<<" for kcrit = "<<kcrit<<std::endl;
+        SKInfo ski(kcrit, _gsparams, false);
+        double delta = ski.getDelta();
+
+        shared_ptr<Node> node(new Node());
+        node->E.resize(_k.size());
+        node->E[0] = 1.;
+        for (size_t j=1; j<_k.size(); ++j)
+            node->E[j] = fmath::expd(-0.5*ski.structureFunction(_k[j]));
+
+        // Stop f once it is negligible or it has (almost) all the flux.
+        double thresh = (1.-delta-0.1*_gsparams->shoot_accuracy);
+        double sum = 0.;
+        int nsmall = 0;
+        for (size_t j=0; j<_r.size(); ++j) {
+            double val = ski.xValueRaw(_r[j]);
+            node->f.push_back(val);
+            if (j > 0) sum += 2.*M_PI * 0.5*(_r[j]+_r[j-1]) * (_r[j]-_r[j-1]) * val;
+            if (val < _gsparams->xvalue_accuracy) ++nsmall;
+            else nsmall = 0;
+            if (nsmall == 10 || sum > thresh) break;
+        }
+        dbg<<"Node has "<<node->f.size()<<" entries up to r = "<<_r[node->f.size()-1]<<std::endl;
+        return node;
+    }
+
+    void SKUniversalTable::buildAll() const
+    {
+        std::vector<int> todo = _grid.missing();
+        dbg<<"Building "<<todo.size()<<" SecondKick table nodes\n";
+
+        // Exceptions can't propagate out of an OpenMP parallel region, so save the first one
+        // and rethrow it after the loop.
+        const int ntodo = todo.size();
+        std::exception_ptr eptr;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int n=0; n<ntodo; ++n) {
+            try {
+                _grid.setIfMissing(todo[n], buildNode(todo[n]));
+            } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical (galsim_secondkick_table)
+#endif
+                {
+                    if (!eptr) eptr = std::current_exception();
+                }
+            }
+        }
+        if (eptr) std::rethrow_exception(eptr);
+    }
+
+    bool SKUniversalTable::getTables(double kcrit, shared_ptr<TableBuilder>& etab,
+                                     shared_ptr<TableBuilder>& ftab) const
+    {
+        if (!(kcrit > 0.)) return false;
+        double t = std::log10(kcrit/0.2) / sk_table_dlogkcrit + sk_table_i02;
+
+        // Use the node directly if kcrit is one of the grid points (e.g. the default 0.2).
+        // The node includes the k and r values of the direct calculation, so this agrees with
+        // it to much better than kvalue_accuracy and xvalue_accuracy.  Otherwise use 4-point
+        // Lagrange interpolation, but only if the GSParams allow for its larger errors.
+        int i0;
+        double w[4];
+        int nn = _grid.getWeights(t, i0, w);
+        if (nn == 0) return false;
+        if (nn > 1 && (_gsparams->xvalue_accuracy < sk_table_xaccuracy ||
+                       _gsparams->kvalue_accuracy < sk_table_kaccuracy)) return false;
+        shared_ptr<const Node> nodes[4];
+        _grid.getNodes(i0, nn, [this](int i) { return buildNode(i); }, nodes);
+
+        etab.reset(new TableBuilder(Table::spline));
+        for (size_t j=0; j<_k.size(); ++j) {
+            double E = 0.;
+            for (int k=0; k<nn; ++k) E += w[k] * nodes[k]->E[j];
+            etab->addEntry(_k[j], E);
+        }
+        etab->finalize();
+
+        // Each node stops once f is negligible, so only go as far as the shortest one.
+        // Extending the others with zeros would make the interpolation ring.
+        size_t nf = nodes[0]->f.size();
+        for (int k=1; k<nn; ++k) nf = std::min(nf, nodes[k]->f.size());
+        ftab.reset(new TableBuilder(Table::spline));
+        for (size_t j=0; j<nf; ++j) {
+            double f = 0.;
+            for (int k=0; k<nn; ++k) f += w[k] * nodes[k]->f[j];
+            ftab->addEntry(_r[j], f);
+        }
+        ftab->finalize();
+        return true;
+    }
+
+    void SKUniversalTable::write(std::ostream& os) const
+    {
+        WriteUniversalTableHeader(os, "SecondKick", sk_table_version, *_gsparams);
+        os << sk_table_nkcrit << " " << sk_table_i02 << " " << sk_table_dlogkcrit << " "
+            << _k.size() << " " << _r.size() << std::endl;
+        os.precision(17);
+        std::vector<shared_ptr<const Node> > nodes = _grid.getAll();
+        for (int i=0; i<sk_table_nkcrit; ++i) {
+            if (!nodes[i]) continue;
+            const Node& node = *nodes[i];
+            os << i << " " << node.f.size() << "\n";
+            for (size_t j=0; j<node.E.size(); ++j) os << node.E[j] << "\n";
+            for (size_t j=0; j<node.f.size(); ++j) os << node.f[j] << "\n";
+        }
+    }
+
+    void SKUniversalTable::read(std::istream& is)
+    {
+        ReadUniversalTableHeader(is, "SecondKick", sk_table_version, *_gsparams);
+        int nkcrit, i02;
+        double dlogkcrit;
+        size_t nk, nr;
+        is >> nkcrit >> i02 >> dlogkcrit >> nk >> nr;
+        if (!is || nkcrit != sk_table_nkcrit || i02 != sk_table_i02 ||
+            dlogkcrit != sk_table_dlogkcrit || nk != _k.size() || nr != _r.size())
+            throw SBError("Invalid SecondKick table file");
+        int i;
+        size_t nf;
+        while (is >> i >> nf) {
+            if (i < 0 || i >= sk_table_nkcrit || nf < 2 || nf > nr)
+                throw SBError("Invalid SecondKick table file");
+            shared_ptr<Node> node(new Node());
+            node->E.resize(nk);
+            node->f.resize(nf);
+            for (size_t j=0; j<nk; ++j) is >> node->E[j];
+            for (size_t j=0; j<nf; ++j) is >> node->f[j];
+            if (!is) throw SBError("Invalid SecondKick table file");
+            _grid.set(i, node);
+        }
+    }
+
+    void WriteSecondKickTable(const std::string& file, const GSParams& gsparams, bool build_all)
+    {
+        shared_ptr<SKUniversalTable> table = SKUniversalTable::Get(GSParamsPtr(gsparams));
+        if (build_all) table->buildAll();
+        std::ofstream fout(file.c_str());
+        if (!fout) throw SBError("Unable to open "+file+" for writing");
+        table->write(fout);
+    }
+
+    void ReadSecondKickTable(const std::string& file, const GSParams& gsparams)
+    {
+        std::ifstream fin(file.c_str());
+        if (!fin) throw SBError("Unable to open "+file);
+        SKUniversalTable::Get(GSParamsPtr(gsparams))->read(fin);
+    }
+
+    void ClearSecondKickTables()
+    {
+        SKUniversalTable::Clear();
+    }
+
+    int GetSecondKickTableNBuilt(const GSParams& gsparams)
+    {
+        return SKUniversalTable::Get(GSParamsPtr(gsparams))->getNBuilt();
+    }
+
     LRUCache<Tuple<double,GSParamsPtr>,SKInfo>
         SBSecondKick::SBSecondKickImpl::cache(sbp::max_SK_cache);
 
@@ -101,6 +101,24 @@ namespace galsim {
         return _flux * _info->kValue(ksq);
     }
 
+    void SBSersic::SBSersicImpl::xValueMany(const double* x, const double* y, double* val,
+                                            int n) const
+    {
+        for (int i=0; i<n; ++i) {
+            double rsq = (x[i]*x[i]+y[i]*y[i])*_inv_r0_sq;
+            val[i] = _xnorm * _info->xValue(rsq);
+        }
+    }
+
+    void SBSersic::SBSersicImpl::kValueRadialMany(const double* ksq, double* val, int n) const
+    {
+        if (n <= 0) return;
+        std::vector<double> ksq1(n);
+        for (int i=0; i<n; ++i) ksq1[i] = ksq[i]*_r0_sq;
+        _info->kValueMany(&ksq1[0], val, n);
+        for (int i=0; i<n; ++i) val[i] *= _flux;
+    }
+
     template <typename T>
     void SBSersic::SBSersicImpl::fillXImage(ImageView<T> im,
                                             double x0, double dx, int izero,
@@ -375,6 +393,36 @@ namespace galsim {
         }
     }
 
+    void SersicInfo::kValueMany(const double* ksq, double* val, int n) const
+    {
+        if (!_ft.finalized()) buildFT();
+
+        // Do the asymptotic regions directly, and collect the rest to interpolate together.
+        std::vector<double> lk;
+        std::vector<int> index;
+        lk.reserve(n);
+        index.reserve(n);
+        for (int i=0; i<n; ++i) {
+            assert(ksq[i] >= 0.);
+            if (ksq[i]>=_ksq_max)
+                val[i] = (_highk_a + _highk_b/sqrt(ksq[i]))/ksq[i];
+            else if (ksq[i]<_ksq_min)
+                val[i] = 1. + ksq[i]*(_kderiv2 + ksq[i]*_kderiv4);
+            else {
+                lk.push_back(0.5*std::log(ksq[i]));
+                index.push_back(i);
+            }
+        }
+        const int nlk = lk.size();
+        if (nlk == 0) return;
+        std::vector<double> ft(nlk);
+        _ft.interpMany(&lk[0], &ft[0], nlk);
+        for (int j=0; j<nlk; ++j) {
+            int i = index[j];
+            val[i] = ft[j]/ksq[i];
+        }
+    }
+
     class SersicRadialFunction: public FluxDensity
     {
     public:
@@ -444,6 +492,18 @@ namespace galsim {
         _maxk = kmin; // Just in case we break on the first iteration.
         SersicRadialFunction I(_invn);
         bool found_maxk = false;
+
+        // For the untruncated profile, do the Hankel transforms in batches of k values, which
+        // lets them share a single tabulation of I(r) in log(r).  The interpolation error there
+        // is ~dlogr^4 max(d^4I/dlogr^4).  Numerically, this choice of dlogr gives errors
+        // in the transform of order 1.e-10 for the default GSParams, well below the
+        // integration_abserr.
+        double dlogr = _gsparams->table_spacing * sqrt(sqrt(_gsparams->integration_abserr)) / 2.;
+        const int n_batch = 32;
+        std::vector<double> k_batch(n_batch);
+        std::vector<double> val_batch(n_batch);
+        int i_batch = n_batch;
+
         for (double logk = std::log(kmin)-0.001; logk < std::log(500.); logk += dlogk) {
             double k = fmath::expd(logk);
             double ksq = k*k;
@@ -454,9 +514,16 @@ namespace galsim {
                                          _gsparams->integration_relerr,
                                          _gsparams->integration_abserr*hankel_norm);
             } else {
-                val = math::hankel_inf(I, k, 0.,
-                                       _gsparams->integration_relerr,
-                                       _gsparams->integration_abserr*hankel_norm);
+                if (i_batch == n_batch) {
+                    double logk_batch = logk;
+                    for (int i=0; i<n_batch; ++i, logk_batch += dlogk)
+                        k_batch[i] = fmath::expd(logk_batch);
+                    math::hankel_inf_many(I, k_batch.data(), val_batch.data(), n_batch, 0., dlogr,
+                                          _gsparams->integration_relerr,
+                                          _gsparams->integration_abserr*hankel_norm);
+                    i_batch = 0;
+                }
+                val = val_batch[i_batch++];
             }
             val /= hankel_norm;
             xdbg<<"logk = "<<logk<<", ft("<<exp(logk)<<") = "<<val<<"   "<<val*ksq<<std::endl;
@@ -778,6 +845,10 @@ namespace galsim {
     {
         dbg<<"Target flux = 1.0\n";
 
+        // Multiple threads may be shooting photons at once, so only let one build the sampler.
+#ifdef _OPENMP
+#pragma omp critical (galsim_sersic_sampler)
+#endif
         if (!_sampler) {
             // Set up the classes for photon shooting
             _radial.reset(new SersicRadialFunction(_invn));
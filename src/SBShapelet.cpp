@@ -21,6 +21,8 @@
 
 #include "SBShapelet.h"
 #include "SBShapeletImpl.h"
+#include "BinomFact.h"
+#include "LRUCache.h"
 
 namespace galsim {
 
@@ -142,14 +144,38 @@ namespace galsim {
     const LVector& SBShapelet::SBShapeletImpl::getBVec() const { return _bvec; }
     LVector& SBShapelet::SBShapeletImpl::getBVec() { return _bvec; }
 
+    // The full basis matrix for an image has (order+1)(order+2)/2 columns for every pixel,
+    // which gets very large for high order shapelets on large images.  So build it in blocks
+    // of this many points, which mostly stay in cache, and apply bvec to each block right away.
+    // The blocks are independent, so they are done in parallel if OpenMP is available.
+    const int shapelet_block_size = 512;
+
     void FillXValue(const LVector& bvec, double sigma,
                     VectorXd& val, const VectorXd& x, const VectorXd& y)
     {
         dbg<<"order = "<<bvec.getOrder()<<", sigma = "<<sigma<<std::endl;
         xdbg<<"FillXValue with bvec = "<<bvec<<std::endl;
-        MatrixXd psi(val.size(),bvec.size());
-        LVector::basis(x,y,psi,bvec.getOrder(),sigma);
-        val = psi * bvec.rVector();
+        const int npts = val.size();
+        const int nblocks = (npts + shapelet_block_size - 1) / shapelet_block_size;
+        // sqrtn extends a static table as needed, so make sure it is big enough before
+        // starting multiple threads.
+        sqrtn(bvec.getOrder()+1);
+#ifdef _OPENMP
+#pragma omp parallel if (nblocks > 1)
+#endif
+        {
+            MatrixXd psi(shapelet_block_size,bvec.size());
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (int ib=0; ib<nblocks; ++ib) {
+                const int ilo = ib * shapelet_block_size;
+                const int n = std::min(shapelet_block_size, npts-ilo);
+                if (psi.rows() != n) psi.resize(n,bvec.size());
+                LVector::basis(x.segment(ilo,n),y.segment(ilo,n),psi,bvec.getOrder(),sigma);
+                val.segment(ilo,n) = psi * bvec.rVector();
+            }
+        }
     }
 
     void FillKValue(const LVector& bvec, double sigma,
@@ -157,9 +183,26 @@ namespace galsim {
     {
         dbg<<"order = "<<bvec.getOrder()<<", sigma = "<<sigma<<std::endl;
         xdbg<<"fillKValue with bvec = "<<bvec<<std::endl;
-        MatrixXcd psi_k(val.size(),bvec.size());
-        LVector::kBasis(kx,ky,psi_k,bvec.getOrder(),sigma);
-        val = psi_k * bvec.rVector();
+        const int npts = val.size();
+        const int nblocks = (npts + shapelet_block_size - 1) / shapelet_block_size;
+        sqrtn(bvec.getOrder()+1);
+#ifdef _OPENMP
+#pragma omp parallel if (nblocks > 1)
+#endif
+        {
+            MatrixXcd psi_k(shapelet_block_size,bvec.size());
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (int ib=0; ib<nblocks; ++ib) {
+                const int ilo = ib * shapelet_block_size;
+                const int n = std::min(shapelet_block_size, npts-ilo);
+                if (psi_k.rows() != n) psi_k.resize(n,bvec.size());
+                LVector::kBasis(kx.segment(ilo,n),ky.segment(ilo,n),psi_k,
+                                bvec.getOrder(),sigma);
+                val.segment(ilo,n) = psi_k * bvec.rVector();
+            }
+        }
     }
 
     template <typename T>
@@ -308,6 +351,66 @@ namespace galsim {
                 *ptr++ = val[k];
     }
 
+    // The QR decomposition of the design matrix for fitting shapelets to an image only depends
+    // on the order and the grid of points, so repeated fits on the same grid (e.g. many PSF
+    // stars in postage stamps of the same size) can reuse it.  It is built with sigma = 1;
+    // the fitted coefficients then just scale as sigma^2.
+    class ShapeletFitDesign
+    {
+    public:
+        // The grid is x = (i + xoff) * scale, y = (j + yoff) * scale
+        // for i = 0..nx-1, j = 0..ny-1, with i varying slowest.
+        ShapeletFitDesign(int order, const Tuple<int,int>& nxy, double xoff, double yoff,
+                          double scale)
+        {
+            const int nx = nxy.first;
+            const int ny = nxy.second;
+            const int npts = nx * ny;
+            const int nb = PQIndex::size(order);
+            MatrixXd psi(npts,nb);
+            const int nblocks = (npts + shapelet_block_size - 1) / shapelet_block_size;
+            sqrtn(order+1);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (nblocks > 1)
+#endif
+            for (int ib=0; ib<nblocks; ++ib) {
+                const int ilo = ib * shapelet_block_size;
+                const int n = std::min(shapelet_block_size, npts-ilo);
+                VectorXd x(n);
+                VectorXd y(n);
+                for (int k=0; k<n; ++k) {
+                    x[k] = ((ilo+k) / ny + xoff) * scale;
+                    y[k] = ((ilo+k) % ny + yoff) * scale;
+                }
+                MatrixXd block(n,nb);
+                LVector::basis(x,y,block,order,1.);
+                psi.middleRows(ilo,n) = block;
+            }
+            _qr.compute(psi);
+        }
+
+        VectorXd solve(const VectorXd& I) const { return _qr.solve(I); }
+
+    private:
+        Eigen::ColPivHouseholderQR<MatrixXd> _qr;
+    };
+
+    // Only keep a few, since they can be large.  Designs with more than this many elements
+    // (1 MB, e.g. a 44 x 44 stamp at order 10) are not kept at all, so the cache holds at
+    // most about 4 MB.
+    const int max_shapelet_fit_cache = 4;
+    const long max_shapelet_fit_cache_size = 1L<<17;
+    static LRUCache<Tuple<int,Tuple<int,int>,double,double,double>,ShapeletFitDesign>
+        shapelet_fit_cache(max_shapelet_fit_cache);
+
+    void ClearShapeletFitCache()
+    {
+#ifdef _OPENMP
+#pragma omp critical (galsim_shapelet_fit)
+#endif
+        shapelet_fit_cache.clear();
+    }
+
     template <typename T>
     void ShapeletFitImage(double sigma, LVector& bvec, const BaseImage<T>& image,
                           double image_scale, const Position<double>& center)
@@ -325,25 +428,30 @@ namespace galsim {
         xdbg<<"nx,ny = "<<nx<<','<<ny<<std::endl;
         const int npts = nx * ny;
         xdbg<<"npts = "<<npts<<std::endl;
-        VectorXd x(npts);
-        VectorXd y(npts);
         VectorXd I(npts);
         int i=0;
         for (int ix = image.getXMin(); ix <= image.getXMax(); ++ix) {
             for (int iy = image.getYMin(); iy <= image.getYMax(); ++iy,++i) {
-                x[i] = (ix - center.x) * scale;
-                y[i] = (iy - center.y) * scale;
                 I[i] = image(ix,iy);
             }
         }
-        xxdbg<<"x = "<<x<<std::endl;
-        xxdbg<<"y = "<<y<<std::endl;
         xxdbg<<"I = "<<I<<std::endl;
 
-        MatrixXd psi(npts,bvec.size());
-        LVector::basis(x,y,psi,bvec.getOrder(),sigma);
         // I = psi * b
-        bvec.rVector() = psi.colPivHouseholderQr().solve(I);
+        const int order = bvec.getOrder();
+        const double xoff = image.getXMin() - center.x;
+        const double yoff = image.getYMin() - center.y;
+        shared_ptr<ShapeletFitDesign> design;
+        if (long(npts) * bvec.size() <= max_shapelet_fit_cache_size) {
+#ifdef _OPENMP
+#pragma omp critical (galsim_shapelet_fit)
+#endif
+            design = shapelet_fit_cache.get(
+                MakeTuple(order, MakeTuple(nx,ny), xoff, yoff, scale));
+        } else {
+            design.reset(new ShapeletFitDesign(order, MakeTuple(nx,ny), xoff, yoff, scale));
+        }
+        bvec.rVector() = design->solve(I) * (sigma*sigma);
         xdbg<<"Done FitImage: bvec = "<<bvec<<std::endl;
     }
 
@@ -687,6 +687,10 @@ namespace galsim {
 
     void SpergelInfo::shoot(PhotonArray& photons, UniformDeviate ud) const
     {
+        // Multiple threads may be shooting photons at once, so only let one build the sampler.
+#ifdef _OPENMP
+#pragma omp critical (galsim_spergel_sampler)
+#endif
         if (!_sampler) {
             // Set up the classes for photon shooting
             double shoot_rmax = calculateFluxRadius(1. - _gsparams->shoot_accuracy);
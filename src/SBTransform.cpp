@@ -503,6 +503,44 @@ namespace galsim {
         return _kValue(_adaptee,fwdT(k),_fluxScaling,k,_cen);
     }
 
+    void SBTransform::SBTransformImpl::xValueMany(const double* x, const double* y, double* val,
+                                                  int n) const
+    {
+        if (n <= 0) return;
+        // Transform all the positions to the adaptee's frame, so it can do them all at once.
+        std::vector<double> xx(n);
+        std::vector<double> yy(n);
+        for (int i=0; i<n; ++i) {
+            Position<double> p = inv(Position<double>(x[i]-_cen.x, y[i]-_cen.y));
+            xx[i] = p.x;
+            yy[i] = p.y;
+        }
+        _adaptee.xValueMany(&xx[0], &yy[0], val, n);
+        for (int i=0; i<n; ++i) val[i] *= _ampScaling;
+    }
+
+    void SBTransform::SBTransformImpl::kValueMany(const double* kx, const double* ky,
+                                                  std::complex<double>* kval, int n) const
+    {
+        if (n <= 0) return;
+        std::vector<double> kxx(n);
+        std::vector<double> kyy(n);
+        for (int i=0; i<n; ++i) {
+            Position<double> k = fwdT(Position<double>(kx[i], ky[i]));
+            kxx[i] = k.x;
+            kyy[i] = k.y;
+        }
+        _adaptee.kValueMany(&kxx[0], &kyy[0], kval, n);
+
+        // Apply the same factors as kValue does.
+        if (!_zeroCen) {
+            for (int i=0; i<n; ++i)
+                kval[i] *= std::polar(_fluxScaling, -kx[i]*_cen.x-ky[i]*_cen.y);
+        } else if (std::abs(_fluxScaling-1.) >= this->gsparams.kvalue_accuracy) {
+            for (int i=0; i<n; ++i) kval[i] *= _fluxScaling;
+        }
+    }
+
     std::complex<double> SBTransform::SBTransformImpl::kValueNoPhase(
         const Position<double>& k) const
     { return _kValueNoPhase(_adaptee,fwdT(k),_fluxScaling,k,_cen); }
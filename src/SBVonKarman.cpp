@@ -26,6 +26,8 @@
 #include "math/Gamma.h"
 #include "math/Hankel.h"
 #include "fmath/fmath.hpp"
+#include <fstream>
+#include <exception>
 
 namespace galsim {
 
@@ -129,12 +131,12 @@ namespace galsim {
                                  const GSParamsPtr& gsparams, double force_stepk) :
         _lam(lam), _L0(L0),
         _L0_invcuberoot(fast_pow(_L0, -1./3)), _L053(fast_pow(L0, 5./3)),
-        _stepk(force_stepk), _maxk(0.0),
+        _stepk(force_stepk), _force_stepk(force_stepk != 0.0), _maxk(0.0),
         _delta(exp(-0.5*magic1*_L053)),
         _deltaScale(1./(1.-_delta)),
         _lam_arcsec(_lam * ARCSEC2RAD / (2.*M_PI)),
         _doDelta(doDelta), _gsparams(gsparams),
-        _radial(Table::spline)
+        _radial(Table::spline), _radial_ready(false)
     {
         // determine maxK
         // want kValue(maxK)/kValue(0.0) = _gsparams->maxk_threshold;
@@ -226,18 +228,265 @@ namespace galsim {
         return math::hankel_inf(I, r, 0., relerr, abserr) / (2.*M_PI);
     }
 
+    // The same as rawXValue for n values of r at once.  The transforms share a single
+    // tabulation of kValue in log(k), which is much faster than doing each one separately.
+    // The interpolation error is ~dlogk^4 max(d^4f/dlogk^4), so as for Sersic, this choice of
+    // dlogk keeps it well below integration_abserr.
+    void VonKarmanInfo::rawXValueMany(const double* r, double* val, int n) const
+    {
+        xdbg<<"rawXValueMany for "<<n<<" values of r starting at "<<r[0]<<std::endl;
+        VKXIntegrand I(*this);
+        double relerr = _gsparams->integration_relerr;
+        double abserr = _gsparams->integration_abserr;
+        double dlogk = _gsparams->table_spacing * sqrt(sqrt(abserr)) / 2.;
+        math::hankel_inf_many(I, r, val, n, 0., dlogk, relerr, abserr);
+        for (int i=0; i<n; ++i) val[i] /= 2.*M_PI;
+    }
+
+    //
+    //
+    //
+    //VonKarmanUniversalTable
+    //
+    //
+    //
+
+    // The grid points are at log10(L0) = vk_table_logL0min + i * vk_table_dlogL0
+    // for i = 0..vk_table_nL0-1.
+    const double vk_table_logL0min = 1.4;
+    const double vk_table_dlogL0 = 0.025;
+    const int vk_table_nL0 = 145;
+    // The largest error of the interpolated profile relative to f(0).  The table is only used
+    // when xvalue_accuracy is at least this large.
+    const double vk_table_accuracy = 3.e-6;
+    // Increment this when the nodes change, so old table files are not used.
+    const int vk_table_version = 1;
+
+    LRUCache<GSParamsPtr,VonKarmanUniversalTable>
+        VonKarmanUniversalTable::cache(sbp::max_vonKarman_table_cache);
+
+    VonKarmanUniversalTable::VonKarmanUniversalTable(const GSParamsPtr& gsparams) :
+        _gsparams(gsparams), _grid(vk_table_nL0) {}
+
+    shared_ptr<VonKarmanUniversalTable> VonKarmanUniversalTable::Get(const GSParamsPtr& gsparams)
+    {
+        shared_ptr<VonKarmanUniversalTable> table;
+#ifdef _OPENMP
+#pragma omp critical (galsim_vonkarman_table)
+#endif
+        table = cache.get(gsparams);
+        return table;
+    }
+
+    void VonKarmanUniversalTable::Clear()
+    {
+#ifdef _OPENMP
+#pragma omp critical (galsim_vonkarman_table)
+#endif
+        cache.clear();
+    }
+
+    shared_ptr<const VonKarmanUniversalTable::Node> VonKarmanUniversalTable::buildNode(int i) const
+    {
+        double L0 = std::pow(10., vk_table_logL0min + i * vk_table_dlogL0);
+        dbg<<"Build VonKarman table node "<<i<<" for L0 = "<<L0<<std::endl;
+        // Use lam such that lam_arcsec = 1.  Then r is really the dimensionless u.
+        VonKarmanInfo vki(2.*M_PI/ARCSEC2RAD, L0, false, _gsparams, 0.);
+
+        // The values we tabulate are g(u) = h(u) (1-delta), which vary more smoothly with L0
+        // than h(u) itself, especially for small L0 where delta is large.
+        double norm = 1. - vki.getDelta();
+
+        shared_ptr<Node> node(new Node());
+        double val = vki.rawXValue(0.);
+        node->u.push_back(0.);
+        node->h.push_back(val * norm);
+
+        // This follows the same steps as VonKarmanInfo::_buildRadialFunc, but with twice the
+        // density of points, since the values are interpolated again for the final table.
+        // It also goes out a bit farther, so neighboring nodes cover the whole range needed for
+        // any L0 between them.  And it starts 10x closer to the center, since the spline
+        // across the first interval is not accurate enough to be interpolated again.
+        double C = 1.4 * pow(L0,-2./3.) + 0.0767417;
+        double r0 = 0.1 * sqrt(_gsparams->xvalue_accuracy / (val * C));
+        double dlogr = 0.5 * _gsparams->table_spacing *
+            sqrt(sqrt(_gsparams->xvalue_accuracy / 10.));
+        double thresh = (1.-0.1*_gsparams->shoot_accuracy) / (2.*M_PI*dlogr);
+        const double maxU = 1.e4;
+        double sum = 0.;
+        const int n_batch = 32;
+        std::vector<double> r_batch(n_batch);
+        std::vector<double> val_batch(n_batch);
+        int i_batch = n_batch;
+        for(double logr=log(r0); logr<log(maxU) && sum < thresh; logr+=dlogr) {
+            double r = exp(logr);
+            if (i_batch == n_batch) {
+                double logr_batch = logr;
+                for (int i=0; i<n_batch; ++i, logr_batch += dlogr)
+                    r_batch[i] = exp(logr_batch);
+                vki.rawXValueMany(r_batch.data(), val_batch.data(), n_batch);
+                i_batch = 0;
+            }
+            val = val_batch[i_batch++];
+            node->u.push_back(r);
+            node->h.push_back(val * norm);
+            sum += val*r*r;
+        }
+
+        // The width of the profile changes a lot with L0, so comparing the nodes at fixed u
+        // is not very accurate.  Rather, store each one in units of its own scale size,
+        // s = g(0)^-1/2, so they all have G(0) = 1 and roughly the same shape.  Then
+        //     g(u) = G(u/s) / s^2
+        double g0 = node->h[0];
+        node->scale = 1./sqrt(g0);
+        for (size_t j=0; j<node->u.size(); ++j) {
+            node->u[j] /= node->scale;
+            node->h[j] /= g0;
+        }
+        node->table.reset(new Table(&node->u[0], &node->h[0], node->u.size(), Table::spline));
+        dbg<<"Node has "<<node->u.size()<<" entries up to u = "<<node->u.back()<<std::endl;
+        return node;
+    }
+
+    int VonKarmanUniversalTable::getNodes(
+        double L0, shared_ptr<const Node>* nodes, double* w) const
+    {
+        if (_gsparams->xvalue_accuracy < vk_table_accuracy) return 0;
+        double t = (std::log10(L0) - vk_table_logL0min) / vk_table_dlogL0;
+        int i0;
+        int nn = _grid.getWeights(t, i0, w);
+        if (nn == 0) return 0;
+        _grid.getNodes(i0, nn, [this](int i) { return buildNode(i); }, nodes);
+        return nn;
+    }
+
+    void VonKarmanUniversalTable::write(std::ostream& os) const
+    {
+        WriteUniversalTableHeader(os, "VonKarman", vk_table_version, *_gsparams);
+        os << vk_table_nL0 << " " << vk_table_logL0min << " " << vk_table_dlogL0 << std::endl;
+        os.precision(17);
+        std::vector<shared_ptr<const Node> > nodes = _grid.getAll();
+        for (int i=0; i<vk_table_nL0; ++i) {
+            if (!nodes[i]) continue;
+            const Node& node = *nodes[i];
+            os << i << " " << node.scale << " " << node.u.size() << "\n";
+            for (size_t j=0; j<node.u.size(); ++j)
+                os << node.u[j] << " " << node.h[j] << "\n";
+        }
+    }
+
+    void VonKarmanUniversalTable::read(std::istream& is)
+    {
+        ReadUniversalTableHeader(is, "VonKarman", vk_table_version, *_gsparams);
+        int nL0;
+        double logL0min, dlogL0;
+        is >> nL0 >> logL0min >> dlogL0;
+        if (!is || nL0 != vk_table_nL0 || logL0min != vk_table_logL0min ||
+            dlogL0 != vk_table_dlogL0)
+            throw SBError("Invalid VonKarman table file");
+        int i;
+        double scale;
+        size_t n;
+        while (is >> i >> scale >> n) {
+            if (i < 0 || i >= vk_table_nL0 || n < 2)
+                throw SBError("Invalid VonKarman table file");
+            shared_ptr<Node> node(new Node());
+            node->scale = scale;
+            node->u.resize(n);
+            node->h.resize(n);
+            for (size_t j=0; j<n; ++j) is >> node->u[j] >> node->h[j];
+            if (!is) throw SBError("Invalid VonKarman table file");
+            node->table.reset(new Table(&node->u[0], &node->h[0], n, Table::spline));
+            _grid.set(i, node);
+        }
+    }
+
+    void WriteVonKarmanTable(const std::string& file, const GSParams& gsparams)
+    {
+        std::ofstream fout(file.c_str());
+        if (!fout) throw SBError("Unable to open "+file+" for writing");
+        VonKarmanUniversalTable::Get(GSParamsPtr(gsparams))->write(fout);
+    }
+
+    void ReadVonKarmanTable(const std::string& file, const GSParams& gsparams)
+    {
+        std::ifstream fin(file.c_str());
+        if (!fin) throw SBError("Unable to open "+file);
+        VonKarmanUniversalTable::Get(GSParamsPtr(gsparams))->read(fin);
+    }
+
+    void ClearVonKarmanTables()
+    {
+        VonKarmanUniversalTable::Clear();
+    }
+
+    int GetVonKarmanTableNBuilt(const GSParams& gsparams)
+    {
+        return VonKarmanUniversalTable::Get(GSParamsPtr(gsparams))->getNBuilt();
+    }
+
+    double VonKarmanInfo::tableXValue(
+        const shared_ptr<const VonKarmanUniversalTable::Node>* nodes, const double* w, int nn,
+        double r) const
+    {
+        // f(r) = h(r/lam_arcsec) / lam_arcsec^2
+        // h(u) = g(u) / (1-delta)
+        // g(u) = G(u/s) / s^2
+        // where the scale size s is interpolated in log(s).
+        double logs = 0.;
+        for (int k=0; k<nn; ++k) logs += w[k] * std::log(nodes[k]->scale);
+        double s = std::exp(logs);
+        double v = r / (_lam_arcsec * s);
+        double G = 0.;
+        for (int k=0; k<nn; ++k) G += w[k] * (*nodes[k]->table)(v);
+        return G * _deltaScale / (_lam_arcsec * _lam_arcsec * s * s);
+    }
+
     double VonKarmanInfo::xValue(double r) const {
-        if (!_radial.finalized()) _buildRadialFunc();
+        checkRadialFunc();
         return r < _radial.argMax() ? _radial(r) : 0.;
     }
 
+    void VonKarmanInfo::checkRadialFunc() const
+    {
+        // xValue may be called from several threads at once (e.g. in RealSpaceConvolveImage),
+        // so only let one of them build the radial function.  The acquire load pairs with the
+        // release store below, so a thread that sees _radial_ready also sees the built tables.
+        if (_radial_ready.load(std::memory_order_acquire)) return;
+        // Exceptions can't leave a critical section, so save it and rethrow afterwards.
+        std::exception_ptr eptr;
+#ifdef _OPENMP
+#pragma omp critical (galsim_vonkarman_radial)
+#endif
+        {
+            if (!_radial_ready.load(std::memory_order_relaxed)) {
+                try {
+                    _buildRadialFunc();
+                    _radial_ready.store(true, std::memory_order_release);
+                } catch (...) {
+                    eptr = std::current_exception();
+                }
+            }
+        }
+        if (eptr) std::rethrow_exception(eptr);
+    }
+
     void VonKarmanInfo::_buildRadialFunc() const {
         dbg<<"Start buildRadialFunc:\n";
         dbg<<"lam = "<<_lam<<std::endl;
         dbg<<"L0 = "<<_L0<<std::endl;
         dbg<<"doDelta = "<<_doDelta<<"  "<<_delta<<"  "<<_deltaScale<<std::endl;
         //set_verbose(2);
-        double val = rawXValue(0.0); // This is the value without the delta function (clearly).
+
+        // If L0 is in the range of the universal table, then interpolate the values from there
+        // rather than doing the Hankel transforms.
+        shared_ptr<const VonKarmanUniversalTable::Node> nodes[4];
+        double w[4];
+        int nn = VonKarmanUniversalTable::Get(_gsparams)->getNodes(_L0, nodes, w);
+        bool use_table = nn > 0;
+        dbg<<"use_table = "<<use_table<<std::endl;
+        double val = use_table ? tableXValue(nodes, w, nn, 0.) : rawXValue(0.0);
+        // This is the value without the delta function (clearly).
         _radial.addEntry(0., val);
         dbg<<"L0^5/3 = "<<_L053<<std::endl;
         dbg<<"f(0) = "<<val<<" arcsec^-2\n";
@@ -277,9 +526,25 @@ namespace galsim {
         dbg<<"thresh = "<<thresh0<<"  "<<thresh2<<std::endl;
         _hlr = 0.;
         const double maxR = 60.0; // hard cut at 1 arcminute.
+        // Without the table, do the Hankel transforms in batches of r values.
+        const int n_batch = 32;
+        std::vector<double> r_batch(n_batch);
+        std::vector<double> val_batch(n_batch);
+        int i_batch = n_batch;
         for(double logr=log(r0); logr<log(maxR) && sum < thresh2; logr+=dlogr) {
             double r = exp(logr);
-            val = rawXValue(r);
+            if (use_table) {
+                val = tableXValue(nodes, w, nn, r);
+            } else {
+                if (i_batch == n_batch) {
+                    double logr_batch = logr;
+                    for (int i=0; i<n_batch; ++i, logr_batch += dlogr)
+                        r_batch[i] = exp(logr_batch);
+                    rawXValueMany(r_batch.data(), val_batch.data(), n_batch);
+                    i_batch = 0;
+                }
+                val = val_batch[i_batch++];
+            }
             dbg<<"f("<<r<<") = "<<val<<std::endl;
             _radial.addEntry(r, val);
 
@@ -338,9 +603,8 @@ namespace galsim {
 
     void VonKarmanInfo::shoot(PhotonArray& photons, UniformDeviate ud) const
     {
-        if (!_sampler)
-            _buildRadialFunc();
-
+        // The sampler is built along with the radial function.
+        checkRadialFunc();
         _sampler->shoot(photons,ud);
     }
 
@@ -393,6 +657,14 @@ namespace galsim {
         return _flux * _info->kValue(sqrt(p.x*p.x+p.y*p.y)/_scale);
     }
 
+    void SBVonKarman::SBVonKarmanImpl::kValueRadialMany(
+        const double* ksq, double* val, int n) const
+    {
+        const double inv_scale = 1./_scale;
+        for (int i=0; i<n; ++i)
+            val[i] = _flux * _info->kValue(sqrt(ksq[i]) * inv_scale);
+    }
+
     double SBVonKarman::SBVonKarmanImpl::xValue(const Position<double>& p) const
         // r in units of _scale
     {
@@ -500,7 +772,7 @@ namespace galsim {
                 double kx = kx0;
                 double kysq = ky0*ky0;
                 for (int i=0;i<m;++i,kx+=dkx)
-                    *ptr++ = _flux * _info->kValue(kx*kx+kysq);
+                    *ptr++ = _flux * _info->kValue(sqrt(kx*kx+kysq));
             }
         }
     }
@@ -530,7 +802,7 @@ namespace galsim {
             double kx = kx0;
             double ky = ky0;
             for (int i=0; i<m; ++i,kx+=dkx,ky+=dkyx)
-                *ptr++ = _flux * _info->kValue(kx*kx+ky*ky);
+                *ptr++ = _flux * _info->kValue(sqrt(kx*kx+ky*ky));
         }
     }
 
@@ -923,25 +923,29 @@ namespace galsim {
     double Silicon::pixelArea(int i, int j, int nx, int ny) const
     {
         double area = 0.0;
-        bool horizontal1, horizontal2;
+        bool horizontal;
+
+        // Get the position of vertex n of pixel (i,j), including the offsets to the
+        // right and top edges.
+        auto vertex = [&](int n) {
+            int pi = getBoundaryIndex(i, j, n, &horizontal, nx, ny);
+            Position<double> p = horizontal ? _horizontalBoundaryPoints[pi] :
+                _verticalBoundaryPoints[pi];
+            if ((n > cornerIndexBottomRight()) && (n < cornerIndexTopRight())) p.x += 1.0;
+            if ((n >= cornerIndexTopRight()) && (n <= cornerIndexTopLeft())) p.y += 1.0;
+            return p;
+        };
 
         // compute sum of triangle areas using cross-product rule (shoelace formula)
+        // Each vertex is looked up once and carried over as p1 for the next edge.
+        Position<double> first = vertex(0);
+        Position<double> p1 = first;
         for (int n = 0; n < _nv; n++) {
-            int pi1 = getBoundaryIndex(i, j, n, &horizontal1, nx, ny);
-            Position<double> p1 = horizontal1 ? _horizontalBoundaryPoints[pi1] :
-                _verticalBoundaryPoints[pi1];
-            if ((n > cornerIndexBottomRight()) && (n < cornerIndexTopRight())) p1.x += 1.0;
-            if ((n >= cornerIndexTopRight()) && (n <= cornerIndexTopLeft())) p1.y += 1.0;
-
-            int n2 = (n + 1) % _nv;
-            int pi2 = getBoundaryIndex(i, j, n2, &horizontal2, nx, ny);
-            Position<double> p2 = horizontal2 ? _horizontalBoundaryPoints[pi2] :
-                _verticalBoundaryPoints[pi2];
-            if ((n2 > cornerIndexBottomRight()) && (n2 < cornerIndexTopRight())) p2.x += 1.0;
-            if ((n2 >= cornerIndexTopRight()) && (n2 <= cornerIndexTopLeft())) p2.y += 1.0;
+            Position<double> p2 = (n + 1 < _nv) ? vertex(n + 1) : first;
 
             area += p1.x * p2.y;
             area -= p2.x * p1.y;
+            p1 = p2;
         }
 
         return std::abs(area) / 2.0;
@@ -985,11 +989,17 @@ namespace galsim {
 #endif
 
             // Fill target with the area in each pixel.
-            const int skip = target.getNSkip();
+            // Each pixel's area only reads the boundary arrays, so the rows can be done
+            // in parallel.
+            const int stride = target.getStride();
             const int step = target.getStep();
-            T* ptr = target.getData();
+            T* data = target.getData();
 
-            for (int j=j1; j<=j2; ++j, ptr+=skip) {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for (int j=j1; j<=j2; ++j) {
+                T* ptr = data + (j - j1) * stride;
                 for (int i=i1; i<=i2; ++i, ptr+=step) {
                     double newArea = pixelArea(i - i1, j - j1, nx, ny);
                     *ptr = newArea;
@@ -51,6 +51,8 @@ namespace galsim {
         size_t size() const { return _n; }
 
     private:
+        int findIndex(double a, int& hint) const;
+
         const double* _vec;
         int _n;
         // A few convenient additional member variables.
@@ -92,46 +94,59 @@ namespace galsim {
             return i;
         } else {
             xdbg<<"Not equal spaced\n";
-            xdbg<<"lastIndex = "<<_lastIndex<<"  "<<_vec[_lastIndex-1]<<" "<<_vec[_lastIndex]<<std::endl;
-            xassert(_lastIndex >= 1);
-            xassert(_lastIndex < _n);
-
-            if ( a < _vec[_lastIndex-1] ) {
-                xdbg<<"Go lower\n";
-                xassert(_lastIndex-2 >= 0);
-                // Check to see if the previous one is it.
-                if (a >= _vec[_lastIndex-2]) {
-                    xdbg<<"Previous works: "<<_vec[_lastIndex-2]<<std::endl;
-                    return --_lastIndex;
-                } else {
-                    // Look for the entry from 0.._lastIndex-1:
-                    const double* p = std::upper_bound(begin(), begin()+_lastIndex-1, a);
-                    xassert(p != begin());
-                    xassert(p != begin()+_lastIndex-1);
-                    _lastIndex = p-begin();
-                    xdbg<<"Success: "<<_lastIndex<<"  "<<_vec[_lastIndex]<<std::endl;
-                    return _lastIndex;
-                }
-            } else if (a > _vec[_lastIndex]) {
-                xassert(_lastIndex+1 < _n);
-                // Check to see if the next one is it.
-                if (a <= _vec[_lastIndex+1]) {
-                    xdbg<<"Next works: "<<_vec[_lastIndex+1]<<std::endl;
-                    return ++_lastIndex;
-                } else {
-                    // Look for the entry from _lastIndex..end
-                    const double* p = std::lower_bound(begin()+_lastIndex+1, end(), a);
-                    xassert(p != begin()+_lastIndex+1);
-                    xassert(p != end());
-                    _lastIndex = p-begin();
-                    xdbg<<"Success: "<<_lastIndex<<"  "<<_vec[_lastIndex]<<std::endl;
-                    return _lastIndex;
-                }
+#ifdef _OPENMP
+            // Tables are shared between threads (e.g. RealSpaceConvolveImage), so don't
+            // update the cached index here.  Just use a local copy as the starting guess.
+            int hint = _lastIndex;
+            return findIndex(a, hint);
+#else
+            return findIndex(a, _lastIndex);
+#endif
+        }
+    }
+
+    // Find the index for a, starting the search from hint, which is updated to the result.
+    int ArgVec::findIndex(double a, int& hint) const
+    {
+        xdbg<<"hint = "<<hint<<"  "<<_vec[hint-1]<<" "<<_vec[hint]<<std::endl;
+        xassert(hint >= 1);
+        xassert(hint < _n);
+
+        if ( a < _vec[hint-1] ) {
+            xdbg<<"Go lower\n";
+            xassert(hint-2 >= 0);
+            // Check to see if the previous one is it.
+            if (a >= _vec[hint-2]) {
+                xdbg<<"Previous works: "<<_vec[hint-2]<<std::endl;
+                return --hint;
             } else {
-                xdbg<<"lastindex is still good.\n";
-                // Then _lastIndex is correct.
-                return _lastIndex;
+                // Look for the entry from 0..hint-1:
+                const double* p = std::upper_bound(begin(), begin()+hint-1, a);
+                xassert(p != begin());
+                xassert(p != begin()+hint-1);
+                hint = p-begin();
+                xdbg<<"Success: "<<hint<<"  "<<_vec[hint]<<std::endl;
+                return hint;
             }
+        } else if (a > _vec[hint]) {
+            xassert(hint+1 < _n);
+            // Check to see if the next one is it.
+            if (a <= _vec[hint+1]) {
+                xdbg<<"Next works: "<<_vec[hint+1]<<std::endl;
+                return ++hint;
+            } else {
+                // Look for the entry from hint..end
+                const double* p = std::lower_bound(begin()+hint+1, end(), a);
+                xassert(p != begin()+hint+1);
+                xassert(p != end());
+                hint = p-begin();
+                xdbg<<"Success: "<<hint<<"  "<<_vec[hint]<<std::endl;
+                return hint;
+            }
+        } else {
+            xdbg<<"hint is still good.\n";
+            // Then hint is correct.
+            return hint;
         }
     }
 
@@ -694,26 +709,22 @@ namespace galsim {
             double dagrid = _args[i] - _args[i-1];
             double da = (a - _args[i-1])/dagrid;
 
+            // Get all the weights at once.  This also handles the case where a is (very nearly)
+            // equal to one of the args, in which case only that one value is used.
+            // Only the taps that fall within the table are calculated.
+            // Most interpolants have few enough taps to keep the weights on the stack.
+            const int nwts = std::min(_gsinterp->nTaps(), _n);
+            double buf[64];
+            std::vector<double> vec;
+            double* wts = buf;
+            if (nwts > 64) { vec.resize(nwts); wts = &vec[0]; }
             int iaMin, iaMax;
-            if (_gsinterp->isExactAtNodes()) {
-                if (std::abs(da) < 10.*std::numeric_limits<double>::epsilon()) {
-                    iaMin = iaMax = i-1;
-                } else if (std::abs(da-1.) < 10.*std::numeric_limits<double>::epsilon()) {
-                    iaMin = iaMax = i;
-                } else {
-                    iaMin = i-1 + int(std::ceil(da-_gsinterp->xrange()));
-                    iaMax = i-1 + int(std::floor(da+_gsinterp->xrange()));
-                }
-            } else {
-                iaMin = i-1 + int(std::ceil(da-_gsinterp->xrange()));
-                iaMax = i-1 + int(std::floor(da+_gsinterp->xrange()));
-            }
-            iaMin = std::max(iaMin, 0);
-            iaMax = std::min(iaMax, _n-1);
+            _gsinterp->getTaps(i-1+da, 0, _n-1, iaMin, iaMax, wts);
+            const double* wptr = wts;
             if (iaMin > iaMax) return 0.0;
             double sum = 0.0;
             for(int ia=iaMin; ia<=iaMax; ia++) {
-                sum += _vals[ia] * _gsinterp->xval(i-1+da-ia);
+                sum += _vals[ia] * *wptr++;
             }
             return sum;
         }
@@ -43,6 +43,95 @@ namespace galsim {
         }
     }
 
+    // Helper functions for InvertAB and InvertABTable.  See the comments in InvertAB for
+    // the details of the Newton iteration.
+    const int AB_BLOCK_SIZE = 256;
+
+    // Make the coefficient matrices for du/dx, du/dy, dv/dx, dv/dy.
+    // dab should have room for 4 (nab-1)x(nab-1) matrices.
+    static void MakeABDerivs(int nab, const double* ab, double* dab)
+    {
+        const double* A = ab;
+        const double* B = ab + nab*nab;
+        const int nd = (nab-1)*(nab-1);
+        double* A_dudx = dab;
+        double* A_dudy = dab + nd;
+        double* B_dvdx = dab + 2*nd;
+        double* B_dvdy = dab + 3*nd;
+        for (int i=1; i<nab; ++i) {
+            for (int j=1; j<nab; ++j) {
+                int k = (i-1)*(nab-1) + (j-1);
+                A_dudx[k] = A[i*nab+(j-1)] * i;
+                A_dudy[k] = A[(i-1)*nab+j] * j;
+                B_dvdx[k] = B[i*nab+(j-1)] * i;
+                B_dvdy[k] = B[(i-1)*nab+j] * j;
+            }
+        }
+#ifdef DEBUGLOGGING
+        xdbg<<"A_dudx = ";
+        for (int k=0; k<nd; ++k) xdbg<<A_dudx[k]<<" ";
+        xdbg<<"\nA_dudy = ";
+        for (int k=0; k<nd; ++k) xdbg<<A_dudy[k]<<" ";
+        xdbg<<"\nB_dvdx = ";
+        for (int k=0; k<nd; ++k) xdbg<<B_dvdx[k]<<" ";
+        xdbg<<"\nB_dvdy = ";
+        for (int k=0; k<nd; ++k) xdbg<<B_dvdy[k]<<" ";
+        xdbg<<std::endl;
+#endif
+    }
+
+    // Take a single Newton step for n <= AB_BLOCK_SIZE points, updating x,y in place.
+    // The size of each step (relative to max(1,|x|) and max(1,|y|)) is returned in step.
+    static void NewtonStepAB(int n, int nab, const double* ab, const double* dab,
+                             const double* u, const double* v, double* x, double* y,
+                             double* step)
+    {
+        using math::Horner2D;
+        const double* A = ab;
+        const double* B = ab + nab*nab;
+        const int nd = (nab-1)*(nab-1);
+
+        double temp[n];
+        double du[n];
+        double dv[n];
+        double dudx[n];
+        double dudy[n];
+        double dvdx[n];
+        double dvdy[n];
+
+        Horner2D(x, y, n, A, nab, nab, du, temp);  // u' = Horner2D(x, y, A)
+        for(int m=0; m<n; ++m) du[m] -= u[m];      // du = u' - u
+        Horner2D(x, y, n, B, nab, nab, dv, temp);  // v' = Horner2D(x, y, B)
+        for(int m=0; m<n; ++m) dv[m] -= v[m];      // dv = v' - v
+        xdbg<<"du,dv = "<<du[0]<<", "<<dv[0]<<std::endl;
+
+        Horner2D(x, y, n, dab, nab-1, nab-1, dudx, temp);       // -> dudx
+        Horner2D(x, y, n, dab+nd, nab-1, nab-1, dudy, temp);    // -> dudy
+        Horner2D(x, y, n, dab+2*nd, nab-1, nab-1, dvdx, temp);  // -> dvdx
+        Horner2D(x, y, n, dab+3*nd, nab-1, nab-1, dvdy, temp);  // -> dvdy
+        xdbg<<"dudx = "<<dudx[0]<<std::endl;
+        xdbg<<"dudy = "<<dudy[0]<<std::endl;
+        xdbg<<"dvdx = "<<dvdx[0]<<std::endl;
+        xdbg<<"dvdy = "<<dvdy[0]<<std::endl;
+
+        // Newton step [dx dy] = -J^-1 [du dv]
+        for(int m=0; m<n; ++m) {
+            double det = dudx[m] * dvdy[m] - dudy[m] * dvdx[m];
+            double dx = -(dvdy[m] * du[m] - dudy[m] * dv[m]) / det;
+            double dy = -(-dvdx[m] * du[m] + dudx[m] * dv[m]) / det;
+            if (m == 0) {
+                xdbg<<"dx,dy = "<<dx<<", "<<dy<<std::endl;
+                xdbg<<"x,y = "<<x[m]<<", "<<y[m]<<std::endl;
+            }
+            x[m] += dx;
+            y[m] += dy;
+            // Note: if |x| or |y| > 1, then the relevant test is a fractional step, not
+            //       the absolute step.  So divide by max(1,|x|) and max(1,|y|).
+            step[m] = std::max(std::abs(dx/std::max(1.,std::abs(x[m]))),
+                               std::abs(dy/std::max(1.,std::abs(y[m]))));
+        }
+    }
+
     void InvertAB(int n, int nab, const double* u, const double* v, const double* ab,
                   double* x, double* y, bool doiter, int nabp, const double* abp)
     {
@@ -126,168 +215,124 @@ namespace galsim {
         dbg<<"n = "<<n<<std::endl;
         dbg<<"nab = "<<nab<<std::endl;
 
-        // Save these for error message or if we use abp.
-        const double* u0 = u;
-        const double* v0 = v;
-        double* x0 = x;
-        double* y0 = y;
-        int n0 = n;
-
-        // Do the iteration in batches of at most 256, so we can allocate on the stack
-        // and we can keep everything in L1 cache.
-        int nblock = std::min(n, 256);
+        // Do the iteration in blocks of at most 256, so we can allocate on the stack
+        // and we can keep everything in L1 cache.  The blocks are independent, so for large
+        // n, they are split across threads.
+        int nblock = std::min(n, AB_BLOCK_SIZE);
+        int nblocks = (n + AB_BLOCK_SIZE - 1) / AB_BLOCK_SIZE;
         xdbg<<"nblock = "<<nblock<<std::endl;
 
-        double temp[nblock];
         if (abp) {
             dbg<<"Using abp\n";
             const double* Ap = abp;
             const double* Bp = abp + nabp*nabp;
-            while (n) {
-                int n1 = std::min(n, 256);
-                xdbg<<"n = "<<n<<"  "<<n1<<std::endl;
-                xdbg<<"u = "<<u[0]<<std::endl;
-                xdbg<<"v = "<<v[0]<<std::endl;
-                xdbg<<"x = "<<x[0]<<std::endl;
-                xdbg<<"y = "<<y[0]<<std::endl;
-                Horner2D(u, v, n1, Ap, nabp, nabp, x, temp);  // x = Horner2D(u, v, Ap)
-                Horner2D(u, v, n1, Bp, nabp, nabp, y, temp);  // y = Horner2D(u, v, Bp)
-                xdbg<<"x => "<<x[0]<<std::endl;
-                xdbg<<"y => "<<y[0]<<std::endl;
-                x += n1;
-                y += n1;
-                u += n1;
-                v += n1;
-                n -= n1;
+#ifdef _OPENMP
+#pragma omp parallel if (nblocks > 1)
+#endif
+            {
+                double temp[nblock];
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+                for (int ib=0; ib<nblocks; ++ib) {
+                    int i0 = ib * AB_BLOCK_SIZE;
+                    int n1 = std::min(n-i0, AB_BLOCK_SIZE);
+                    Horner2D(u+i0, v+i0, n1, Ap, nabp, nabp, x+i0, temp);  // x = Horner2D(u,v,Ap)
+                    Horner2D(u+i0, v+i0, n1, Bp, nabp, nabp, y+i0, temp);  // y = Horner2D(u,v,Bp)
+                }
             }
+            xdbg<<"x => "<<x[0]<<std::endl;
+            xdbg<<"y => "<<y[0]<<std::endl;
             if (!doiter) return;
-            u = u0;  // Reset back to the original values.
-            v = v0;
-            x = x0;
-            y = y0;
-            n = n0;
         }
 
-        const double* A = ab;
-        const double* B = ab + nab*nab;
-        double A_dudx[(nab-1)*(nab-1)];
-        double A_dudy[(nab-1)*(nab-1)];
-        double B_dvdx[(nab-1)*(nab-1)];
-        double B_dvdy[(nab-1)*(nab-1)];
-        for (int i=1; i<nab; ++i) {
-            for (int j=1; j<nab; ++j) {
-                int k = (i-1)*(nab-1) + (j-1);
-                A_dudx[k] = A[i*nab+(j-1)] * i;
-                A_dudy[k] = A[(i-1)*nab+j] * j;
-                B_dvdx[k] = B[i*nab+(j-1)] * i;
-                B_dvdy[k] = B[(i-1)*nab+j] * j;
-            }
-        }
-#ifdef DEBUGLOGGING
-        xdbg<<"A_dudx = ";
-        for (int k=0; k<(nab-1)*(nab-1); ++k) xdbg<<A_dudx[k]<<" ";
-        xdbg<<"\nA_dudy = ";
-        for (int k=0; k<(nab-1)*(nab-1); ++k) xdbg<<A_dudy[k]<<" ";
-        xdbg<<"\nB_dvdx = ";
-        for (int k=0; k<(nab-1)*(nab-1); ++k) xdbg<<B_dvdx[k]<<" ";
-        xdbg<<"\nB_dvdy = ";
-        for (int k=0; k<(nab-1)*(nab-1); ++k) xdbg<<B_dvdy[k]<<" ";
-        xdbg<<std::endl;
-#endif
-
-        // More temporary arrays
-        double du[nblock];
-        double dv[nblock];
-        double dudx[nblock];
-        double dudy[nblock];
-        double dvdx[nblock];
-        double dvdy[nblock];
+        double dab[4*(nab-1)*(nab-1)];
+        MakeABDerivs(nab, ab, dab);
 
         const int MAX_ITER = 10;
         bool not_converged = false;
 
-        while (n) {
-            dbg<<"n = "<<n<<std::endl;
-            int n1 = std::min(n, 256);
-            for (int iter=0; iter<10; ++iter) {
-                Horner2D(x, y, n1, A, nab, nab, du, temp);  // u' = Horner2D(x, y, A)
-                for(int m=0; m<n1; ++m) du[m] -= u[m];      // du = u' - u
-                Horner2D(x, y, n1, B, nab, nab, dv, temp);  // v' = Horner2D(x, y, B)
-                for(int m=0; m<n1; ++m) dv[m] -= v[m];      // dv = v' - v
-                xdbg<<"du,dv = "<<du[0]<<", "<<dv[0]<<std::endl;
-
-                Horner2D(x, y, n1, A_dudx, nab-1, nab-1, dudx, temp);  // -> dudx
-                Horner2D(x, y, n1, A_dudy, nab-1, nab-1, dudy, temp);  // -> dudy
-                Horner2D(x, y, n1, B_dvdx, nab-1, nab-1, dvdx, temp);  // -> dvdx
-                Horner2D(x, y, n1, B_dvdy, nab-1, nab-1, dvdy, temp);  // -> dvdy
-                xdbg<<"dudx = "<<dudx[0]<<std::endl;
-                xdbg<<"dudy = "<<dudy[0]<<std::endl;
-                xdbg<<"dvdx = "<<dvdx[0]<<std::endl;
-                xdbg<<"dvdy = "<<dvdy[0]<<std::endl;
-
-                // Newton step [dx dy] = -J^-1 [du dv]
-                double max_step = 0.;
-                for(int m=0; m<n1; ++m) {
-                    double det = dudx[m] * dvdy[m] - dudy[m] * dvdx[m];
-                    double dx = -(dvdy[m] * du[m] - dudy[m] * dv[m]) / det;
-                    double dy = -(-dvdx[m] * du[m] + dudx[m] * dv[m]) / det;
-                    if (m == 0) {
-                        xdbg<<"dx,dy = "<<dx<<", "<<dy<<std::endl;
-                        xdbg<<"x,y = "<<x[m]<<", "<<y[m]<<std::endl;
-                    }
-                    x[m] += dx;
-                    y[m] += dy;
-                    // Note: if |x| or |y| > 1, then the relevant test is a fractional step, not
-                    //       the absolute step.  So divide by max(1,|x|) and max(1,|y|).
-                    double abs_step = std::max(std::abs(dx/std::max(1.,std::abs(x[m]))),
-                                               std::abs(dy/std::max(1.,std::abs(y[m]))));
-                    if (abs_step > max_step) {
-                        dbg<<"abs_step at m = "<<m<<" = "<<abs_step<<std::endl;
-                        max_step = abs_step;
+#ifdef _OPENMP
+#pragma omp parallel reduction(||:not_converged) if (nblocks > 1)
+#endif
+        {
+            // The points that are still being iterated.  Points are dropped from these
+            // once they have converged, so later iterations only work on the ones that need it.
+            double xa[nblock];
+            double ya[nblock];
+            double ua[nblock];
+            double va[nblock];
+            double step[nblock];
+            int index[nblock];
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (int ib=0; ib<nblocks; ++ib) {
+                int i0 = ib * AB_BLOCK_SIZE;
+                int na = std::min(n-i0, AB_BLOCK_SIZE);
+                dbg<<"block "<<ib<<": n = "<<na<<std::endl;
+                for (int m=0; m<na; ++m) {
+                    xa[m] = x[i0+m];
+                    ya[m] = y[i0+m];
+                    ua[m] = u[i0+m];
+                    va[m] = v[i0+m];
+                    index[m] = i0+m;
+                }
+
+                for (int iter=0; iter<MAX_ITER && na; ++iter) {
+                    NewtonStepAB(na, nab, ab, dab, ua, va, xa, ya, step);
+                    int k = 0;
+                    for(int m=0; m<na; ++m) {
+                        if (step[m] < 1.e-12) {
+                            // Converged.  Write out the answer and drop it from the active set.
+                            x[index[m]] = xa[m];
+                            y[index[m]] = ya[m];
+                        } else {
+                            xa[k] = xa[m];
+                            ya[k] = ya[m];
+                            ua[k] = ua[m];
+                            va[k] = va[m];
+                            index[k] = index[m];
+                            ++k;
+                        }
                     }
+                    dbg<<"iter "<<iter<<": "<<na-k<<" converged, "<<k<<" remaining"<<std::endl;
+                    na = k;
                 }
-                dbg<<"iter "<<iter<<": max step = "<<max_step<<std::endl;
-                if (max_step < 1.e-12) break;
 
-                if (iter == MAX_ITER-1) {
+                if (na) {
+                    // Hit MAX_ITER.  Write out the current values; they'll be checked below.
                     not_converged = true;
+                    for (int m=0; m<na; ++m) {
+                        x[index[m]] = xa[m];
+                        y[index[m]] = ya[m];
+                    }
                 }
             }
-            x += n1;
-            y += n1;
-            u += n1;
-            v += n1;
-            n -= n1;
         }
+
         if (not_converged) {
             // Check which solutions are not close to the right answer.
             // Note: this is different than the max_step test above, but it shouldn't matter
             //       much since dudx, dvdy are near unity, so du,dv are nearly equal to dx,dy.
+            const double* A = ab;
+            const double* B = ab + nab*nab;
             std::vector<int> bad_indices;
-            u = u0;  // Reset back to the original values.
-            v = v0;
-            x = x0;
-            y = y0;
-            n = n0;
-            int m0 = 0;
-            while (n) {
-                dbg<<"n = "<<n<<std::endl;
-                int n1 = std::min(n, 256);
-                Horner2D(x, y, n1, A, nab, nab, du, temp);  // u' = Horner2D(x, y, A)
-                Horner2D(x, y, n1, B, nab, nab, dv, temp);  // v' = Horner2D(x, y, B)
+            double temp[nblock];
+            double du[nblock];
+            double dv[nblock];
+            for (int i0=0; i0<n; i0+=AB_BLOCK_SIZE) {
+                int n1 = std::min(n-i0, AB_BLOCK_SIZE);
+                Horner2D(x+i0, y+i0, n1, A, nab, nab, du, temp);  // u' = Horner2D(x, y, A)
+                Horner2D(x+i0, y+i0, n1, B, nab, nab, dv, temp);  // v' = Horner2D(x, y, B)
                 for(int m=0; m<n1; ++m) {
-                    du[m] -= u[m];
-                    dv[m] -= v[m];
-                    double abs_err = std::max(std::abs(du[m])/std::max(1.,std::abs(u[m])),
-                                              std::abs(dv[m])/std::max(1.,std::abs(v[m])));
-                    if (abs_err > 1.e-12) bad_indices.push_back(m + m0);
+                    du[m] -= u[i0+m];
+                    dv[m] -= v[i0+m];
+                    double abs_err = std::max(std::abs(du[m])/std::max(1.,std::abs(u[i0+m])),
+                                              std::abs(dv[m])/std::max(1.,std::abs(v[i0+m])));
+                    if (abs_err > 1.e-12) bad_indices.push_back(m + i0);
                 }
-                x += n1;
-                y += n1;
-                u += n1;
-                v += n1;
-                n -= n1;
-                m0 += n1;
             }
             if (bad_indices.size() > 0) {
                 std::ostringstream oss;
@@ -300,4 +345,132 @@ namespace galsim {
         }
     }
 
+    int InvertABTable(int n, int nab, const double* u, const double* v, const double* ab,
+                      double* x, double* y, int nabp, const double* abp,
+                      int nu, int nv, double u0, double v0, double du, double dv,
+                      const double* xgrid, const double* ygrid)
+    {
+        // Same as InvertAB, but for points inside the given table of the inverse, start
+        // from a bilinear interpolation of the table and take a single Newton step.
+        // The table is normally fine enough that this step reaches the same accuracy as the
+        // full iteration.  This is checked for every point by computing the residual after
+        // the step, and any that haven't converged continue with the full iteration from
+        // where they are.  Points outside the table are done with the regular InvertAB.
+        // Returns the number of points inside the table that needed the full iteration.
+        using math::Horner2D;
+        const double* A = ab;
+        const double* B = ab + nab*nab;
+        dbg<<"Start InvertABTable\n";
+        dbg<<"n = "<<n<<std::endl;
+        dbg<<"nab = "<<nab<<std::endl;
+        dbg<<"table: "<<nu<<" x "<<nv<<"  "<<u0<<"  "<<v0<<"  "<<du<<"  "<<dv<<std::endl;
+
+        int nblock = std::min(n, AB_BLOCK_SIZE);
+        int nblocks = (n + AB_BLOCK_SIZE - 1) / AB_BLOCK_SIZE;
+
+        double dab[4*(nab-1)*(nab-1)];
+        MakeABDerivs(nab, ab, dab);
+
+        // Flag the points that aren't covered by the table (1) and the ones that didn't
+        // converge with a single Newton step (2).
+        std::vector<char> outside(n, 0);
+        int nout = 0;
+        int nbad = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:nout,nbad) if (nblocks > 1)
+#endif
+        {
+            double xa[nblock];
+            double ya[nblock];
+            double ua[nblock];
+            double va[nblock];
+            double step[nblock];
+            double ru[nblock];
+            double rv[nblock];
+            double temp[nblock];
+            int index[nblock];
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (int ib=0; ib<nblocks; ++ib) {
+                int i0 = ib * AB_BLOCK_SIZE;
+                int n1 = std::min(n-i0, AB_BLOCK_SIZE);
+                int na = 0;
+                for (int m=i0; m<i0+n1; ++m) {
+                    double fu = (u[m] - u0) / du;
+                    double fv = (v[m] - v0) / dv;
+                    // Note: written this way so that nan values count as outside.
+                    if (!(fu >= 0. && fu < nu-1 && fv >= 0. && fv < nv-1)) {
+                        outside[m] = 1;
+                        ++nout;
+                        continue;
+                    }
+                    int i = int(fu);
+                    int j = int(fv);
+                    double pu = fu - i;
+                    double pv = fv - j;
+                    int k = i*nv + j;
+                    xa[na] = (1.-pu) * ((1.-pv) * xgrid[k] + pv * xgrid[k+1])
+                        + pu * ((1.-pv) * xgrid[k+nv] + pv * xgrid[k+nv+1]);
+                    ya[na] = (1.-pu) * ((1.-pv) * ygrid[k] + pv * ygrid[k+1])
+                        + pu * ((1.-pv) * ygrid[k+nv] + pv * ygrid[k+nv+1]);
+                    ua[na] = u[m];
+                    va[na] = v[m];
+                    index[na] = m;
+                    ++na;
+                }
+                if (na == 0) continue;
+                NewtonStepAB(na, nab, ab, dab, ua, va, xa, ya, step);
+                Horner2D(xa, ya, na, A, nab, nab, ru, temp);  // u' = Horner2D(x, y, A)
+                Horner2D(xa, ya, na, B, nab, nab, rv, temp);  // v' = Horner2D(x, y, B)
+                for (int m=0; m<na; ++m) {
+                    x[index[m]] = xa[m];
+                    y[index[m]] = ya[m];
+                    double err = std::max(std::abs(ru[m]-ua[m])/std::max(1.,std::abs(ua[m])),
+                                          std::abs(rv[m]-va[m])/std::max(1.,std::abs(va[m])));
+                    // Note: written this way so that nan values count as not converged.
+                    if (!(err < 1.e-14)) {
+                        outside[index[m]] = 2;
+                        ++nbad;
+                    }
+                }
+            }
+        }
+
+        // Finish the remaining points with the full iteration.  Points outside the table
+        // start from scratch (using abp if given).  Points that didn't converge continue
+        // from the result of the Newton step above.
+        for (int flag=1; flag<=2; ++flag) {
+            int nrem = flag == 1 ? nout : nbad;
+            if (nrem == 0) continue;
+            dbg<<nrem<<(flag == 1 ? " points are outside the table\n" :
+                        " points did not converge after one Newton step\n");
+            std::vector<double> uo(nrem), vo(nrem), xo(nrem), yo(nrem);
+            std::vector<int> index(nrem);
+            for (int m=0, k=0; m<n; ++m) {
+                if (outside[m] == flag) {
+                    uo[k] = u[m];
+                    vo[k] = v[m];
+                    xo[k] = flag == 1 ? u[m] : x[m];
+                    yo[k] = flag == 1 ? v[m] : y[m];
+                    index[k++] = m;
+                }
+            }
+            if (flag == 1) {
+                InvertAB(nrem, nab, uo.data(), vo.data(), ab, xo.data(), yo.data(), true,
+                         nabp, abp);
+            } else {
+                InvertAB(nrem, nab, uo.data(), vo.data(), ab, xo.data(), yo.data(), true,
+                         0, 0);
+            }
+            for (int k=0; k<nrem; ++k) {
+                x[index[k]] = xo[k];
+                y[index[k]] = yo[k];
+            }
+        }
+        return nbad;
+    }
+
 }
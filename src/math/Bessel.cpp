@@ -20,6 +20,7 @@
 #include <cmath>
 #include <stdexcept>
 #include "math/Bessel.h"
+#include "math/ApplyMany.h"
 
 //#define TEST // Uncomment this to turn on testing of this code against boost code.
 #ifdef TEST
@@ -180,4 +181,34 @@ namespace math {
         return knu;
     }
 
+    void cyl_bessel_j_many(double nu, const double* x, double* y, int n)
+    {
+        ApplyMany([nu](double xi) { return cyl_bessel_j(nu, xi); }, x, y, n);
+    }
+
+    void cyl_bessel_y_many(double nu, const double* x, double* y, int n)
+    {
+        ApplyMany([nu](double xi) { return cyl_bessel_y(nu, xi); }, x, y, n);
+    }
+
+    void cyl_bessel_i_many(double nu, const double* x, double* y, int n)
+    {
+        ApplyMany([nu](double xi) { return cyl_bessel_i(nu, xi); }, x, y, n);
+    }
+
+    void cyl_bessel_k_many(double nu, const double* x, double* y, int n)
+    {
+        ApplyMany([nu](double xi) { return cyl_bessel_k(nu, xi); }, x, y, n);
+    }
+
+    void j0_many(const double* x, double* y, int n)
+    {
+        ApplyMany([](double xi) { return ::j0(xi); }, x, y, n);
+    }
+
+    void j1_many(const double* x, double* y, int n)
+    {
+        ApplyMany([](double xi) { return ::j1(xi); }, x, y, n);
+    }
+
 }}
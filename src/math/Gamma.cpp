@@ -19,8 +19,10 @@
 
 #include <cmath>
 #include <limits>
+#include <stdexcept>
 
 #include "math/Gamma.h"
+#include "math/ApplyMany.h"
 #include "Std.h"
 
 //#define TEST // Uncomment this to turn on testing of this code against boost code.
@@ -61,6 +63,8 @@ namespace math {
         // The relevant netlib code is called dgamit(a,x), which actually returns what they
         // call Tricomi's incomplete Gamma function, which is P(a,x) * x^-a
         // So we just take that value and multiply by x^a.
+        if (x < 0)
+            throw std::runtime_error("gamma_p x must be >= 0");
         double gp = dgamit(a,x) * std::pow(x,a);
 #ifdef TEST
         double gp2 = boost::math::gamma_p(a,x);
@@ -75,6 +79,11 @@ namespace math {
         return gp;
     }
 
+    void gamma_p_many(double a, const double* x, double* y, int n)
+    {
+        ApplyMany([a](double xi) { return gamma_p(a, xi); }, x, y, n);
+    }
+
 
     // The below functions are manual conversions from the public domain fortran code here:
     //   http://www.netlib.org/slatec/fnlib/
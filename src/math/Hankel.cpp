@@ -23,6 +23,8 @@
 #include <cmath>
 #include <vector>
 #include <map>
+#include <memory>
+#include <algorithm>
 #include <functional>
 #include "integ/Int.h"
 #include "math/Hankel.h"
@@ -103,12 +105,14 @@ namespace math {
             if (_N > _Nmax) _N = _Nmax;
             _w.resize(_N);
             _x.resize(_N);
+            _logx.resize(_N);
             for (long i=N1; i<_N; ++i) {
                 double xi = math::getBesselRoot(_nu,i+1)/M_PI;
                 double t = _h * xi;
                 _x[i] = M_PI/_h * psi(t);
                 _w[i] = math::cyl_bessel_y(_nu, M_PI*xi) / math::cyl_bessel_j(_nu+1, M_PI*xi);
                 _w[i] *= M_PI * _x[i] * math::cyl_bessel_j(_nu, _x[i]) * dpsi(t);
+                _logx[i] = std::log(_x[i]);
                 xdbg<<i<<"  "<<xi<<"  "<<t<<"  "<<_x[i]<<"  "<<_w[i]<<std::endl;
             }
             dbg<<"Done setWeightsBatch: _N = "<<_N<<std::endl;
@@ -129,21 +133,25 @@ namespace math {
             return t * M_PI/2. * std::cosh(t) / SQR(std::cosh(M_PI/2. * std::sinh(t))) + psi(t)/t;
         }
 
-        double integrate(const std::function<double(double)> f, double k)
+        // The function f is called as f(r, log(r)), which lets a tabulated function avoid
+        // recomputing the log for each point.
+        template <typename F>
+        double integrate(F& f, double k)
         {
             xdbg<<"start integrate for k = "<<k<<std::endl;
             xdbg<<"h, N = "<<_h<<"  "<<_N<<std::endl;
             assert(_N == long(_w.size()));
             assert(_N == long(_x.size()));
+            double logk = std::log(k);
             double ans = 0.;
             long N1 = 0;
             bool done = false;
             do {
                 double step = 0.;
                 for (long i=N1; i<_N; ++i) {
-                    step = _w[i] * f(_x[i]/k);
+                    step = _w[i] * f(_x[i]/k, _logx[i]-logk);
                     ans += step;
-                    xdbg<<i<<"  "<<_w[i]<<"  "<<_x[i]<<"  "<<_x[i]/k<<"  "<<f(_x[i]/k)<<"  "<<step<<"  "<<ans<<std::endl;
+                    xdbg<<i<<"  "<<_w[i]<<"  "<<_x[i]<<"  "<<_x[i]/k<<"  "<<step<<"  "<<ans<<std::endl;
                     if (std::abs(step) < 1.e-15 * std::abs(ans)) {
                         xdbg<<"Break at i = "<<i<<std::endl;
                         xdbg<<"step = "<<step<<", ans = "<<ans<<std::endl;
@@ -174,6 +182,7 @@ namespace math {
         long _N;
         std::vector<double> _w;
         std::vector<double> _x;
+        std::vector<double> _logx;
     };
 
     class AdaptiveHankelIntegrator
@@ -190,8 +199,8 @@ namespace math {
             return _integrators[h].get();
         }
 
-        double integrate(const std::function<double(double)> f, double k,
-                         double relerr, double abserr)
+        template <typename F>
+        double integrate(F& f, double k, double relerr, double abserr)
         {
             dbg<<"start adaptive integrate for k = "<<k<<std::endl;
 
@@ -228,22 +237,113 @@ namespace math {
         std::map<double, std::unique_ptr<HankelIntegrator> > _integrators;
     };
 
+    // Adaptor to call a regular function with the (r, log(r)) signature used by
+    // HankelIntegrator::integrate.
+    class DirectRadialFunction
+    {
+    public:
+        DirectRadialFunction(const std::function<double(double)>& f) : _f(f) {}
+        double operator()(double r, double ) const { return _f(r); }
+    private:
+        const std::function<double(double)>& _f;
+    };
+
+    // A table of f on a uniform grid in u = log(r), which is filled in lazily as the
+    // integrator asks for values of r that are not yet covered.  The Ogata nodes for different
+    // values of k are the same set of x_i, just scaled by 1/k, so in log(r) they are all
+    // the same points shifted by log(k).  Tabulating in log(r) thus lets the transforms at
+    // many k values share the same evaluations of f.
+    // We use 4-point Lagrange interpolation, which has an error of O(du^4 d^4f/du^4).
+    class LogRadialTable
+    {
+    public:
+        LogRadialTable(const std::function<double(double)>& f, double du) :
+            _f(f), _du(du), _inv_du(1./du), _i0(0), _i1(0) {}
+
+        double operator()(double , double logr)
+        {
+            double t = logr * _inv_du;
+            double ti = std::floor(t);
+            double p = t - ti;
+            long i = long(ti);
+            if (i-1 < _i0 || i+3 > _i1) extend(i-1, i+3);
+            const double* y = &_vals[i-1-_i0];
+            double pm1 = p-1.;
+            double pm2 = p-2.;
+            double pp1 = p+1.;
+            return (-p*pm1*pm2*y[0] + 3.*pp1*pm1*pm2*y[1]
+                    - 3.*pp1*p*pm2*y[2] + pp1*p*pm1*y[3]) / 6.;
+        }
+
+        long size() const { return _i1 - _i0; }
+
+    private:
+        // Make sure the table covers indices [i0, i1).
+        void extend(long i0, long i1)
+        {
+            if (_i1 == _i0) { _i0 = _i1 = i0; }
+            long n0 = std::min(i0, _i0);
+            long n1 = std::max(i1, _i1);
+            // Grow by at least a factor of 2 on whichever side is short, so the total cost of
+            // copying stays linear in the final size.
+            long len = _i1 - _i0;
+            if (n0 < _i0) n0 = std::min(n0, _i0 - len);
+            if (n1 > _i1) n1 = std::max(n1, _i1 + len);
+            xdbg<<"Extend LogRadialTable from "<<_i0<<".."<<_i1<<" to "<<n0<<".."<<n1<<std::endl;
+            std::vector<double> vals(n1-n0);
+            for (long i=n0; i<n1; ++i) {
+                vals[i-n0] = (i >= _i0 && i < _i1) ? _vals[i-_i0] : _f(std::exp(i*_du));
+            }
+            _vals.swap(vals);
+            _i0 = n0;
+            _i1 = n1;
+        }
+
+        const std::function<double(double)>& _f;
+        double _du;
+        double _inv_du;
+        long _i0, _i1;
+        std::vector<double> _vals;  // f(exp(i du)) for i in [_i0, _i1)
+    };
+
+    AdaptiveHankelIntegrator* get_adaptive_integrator(double nu)
+    {
+        static std::map<double, std::unique_ptr<AdaptiveHankelIntegrator> > integrators;
+        if (integrators.count(nu) == 0) {
+            integrators[nu] = std::unique_ptr<AdaptiveHankelIntegrator>(
+                new AdaptiveHankelIntegrator(nu));
+        }
+        return integrators[nu].get();
+    }
+
     double hankel_inf(const std::function<double(double)> f, double k, double nu,
                       double relerr, double abserr, int nzeros)
     {
-        static std::map<double, std::unique_ptr<AdaptiveHankelIntegrator> > integrators;
         dbg<<"Start hankel_inf: "<<k<<"  "<<nu<<std::endl;
         if (k == 0.) {
             // If k = 0, can't do the Ogata method, since it integrates f(x/k) J(x).
             return hankel_gkp(f, k, nu, integ::MOCK_INF, relerr, abserr, nzeros);
         } else {
-            if (integrators.count(nu) == 0) {
-                integrators[nu] = std::unique_ptr<AdaptiveHankelIntegrator>(
-                    new AdaptiveHankelIntegrator(nu));
+            DirectRadialFunction F(f);
+            return get_adaptive_integrator(nu)->integrate(F, k, relerr, abserr);
+        }
+    }
+
+    void hankel_inf_many(const std::function<double(double)> f, const double* k, double* result,
+                         int n, double nu, double dlogr, double relerr, double abserr,
+                         int nzeros)
+    {
+        dbg<<"Start hankel_inf_many: "<<n<<"  "<<nu<<"  "<<dlogr<<std::endl;
+        AdaptiveHankelIntegrator* H = get_adaptive_integrator(nu);
+        LogRadialTable table(f, dlogr);
+        for (int i=0; i<n; ++i) {
+            if (k[i] == 0.) {
+                result[i] = hankel_gkp(f, k[i], nu, integ::MOCK_INF, relerr, abserr, nzeros);
+            } else {
+                result[i] = H->integrate(table, k[i], relerr, abserr);
             }
-            AdaptiveHankelIntegrator* H = integrators[nu].get();
-            return H->integrate(f, k, relerr, abserr);
         }
+        dbg<<"Done hankel_inf_many: used "<<table.size()<<" evaluations of f"<<std::endl;
     }
 
     double hankel_trunc(const std::function<double(double)> f, double k, double nu, double rmax,
@@ -17,6 +17,7 @@
  *    and/or other materials provided with the distribution.
  */
 
+#include <algorithm>
 #include "fmath/fmath.hpp"  // For SSE
 
 #include "math/Horner.h"
@@ -25,6 +26,10 @@
 namespace galsim {
 namespace math {
 
+    // Only use multiple threads when there are at least this many blocks to do.
+    // Smaller arrays aren't worth the overhead of starting the threads.
+    const int PARALLEL_MIN_BLOCKS = 64;
+
     void HornerStep(const double* x, int n, const double c, double* r)
     {
 #ifdef __SSE2__
@@ -76,6 +81,18 @@ namespace math {
 
         // Better for caching to do this in blocks of 64 rather than all at once.
         const int BLOCK_SIZE = 64;
+#ifdef _OPENMP
+        // For large arrays, split the blocks across threads.
+        if (nx >= PARALLEL_MIN_BLOCKS * BLOCK_SIZE) {
+            int nblocks = (nx + BLOCK_SIZE - 1) / BLOCK_SIZE;
+#pragma omp parallel for schedule(static)
+            for (int ib=0; ib<nblocks; ++ib) {
+                int i0 = ib * BLOCK_SIZE;
+                HornerBlock(x+i0, std::min(BLOCK_SIZE, nx-i0), coef, c, result+i0);
+            }
+            return;
+        }
+#endif
         for(; nx >= BLOCK_SIZE; nx-=BLOCK_SIZE, x+=BLOCK_SIZE, result+=BLOCK_SIZE) {
             HornerBlock(x, BLOCK_SIZE, coef, c, result);
         }
@@ -133,6 +150,20 @@ namespace math {
 
         // Better for caching to do this in blocks of 64 rather than all at once.
         const int BLOCK_SIZE = 64;
+#ifdef _OPENMP
+        // For large arrays, split the blocks across threads.  Each block only uses the
+        // corresponding section of temp, so the threads don't interfere with each other.
+        if (nx >= PARALLEL_MIN_BLOCKS * BLOCK_SIZE) {
+            int nblocks = (nx + BLOCK_SIZE - 1) / BLOCK_SIZE;
+#pragma omp parallel for schedule(static)
+            for (int ib=0; ib<nblocks; ++ib) {
+                int i0 = ib * BLOCK_SIZE;
+                HornerBlock2(x+i0, y+i0, std::min(BLOCK_SIZE, nx-i0), coef, c, ncy,
+                             result+i0, temp+i0);
+            }
+            return;
+        }
+#endif
         for(; nx >= BLOCK_SIZE; nx-=BLOCK_SIZE, x+=BLOCK_SIZE, y+=BLOCK_SIZE, result+=BLOCK_SIZE) {
             HornerBlock2(x, y, BLOCK_SIZE, coef, c, ncy, result, temp);
         }
@@ -501,6 +501,50 @@ def test_ci():
         vals1, vals2, rtol=1.e-10, err_msg="bessel.ci disagrees with reference values")
 
 
+@timer
+def test_arrays():
+    """Test the bessel functions with numpy array arguments"""
+    x = np.linspace(0.01, 50., 2000).reshape(40,50)
+    np.testing.assert_allclose(galsim.bessel.j0(x), scipy.special.j0(x), rtol=1.e-10, atol=1.e-14)
+    np.testing.assert_allclose(galsim.bessel.j1(x), scipy.special.j1(x), rtol=1.e-10, atol=1.e-14)
+    for v in [0, 1, 2.3, -1.7]:
+        np.testing.assert_allclose(galsim.bessel.jv(v,x), scipy.special.jv(v,x),
+                                   rtol=1.e-10, atol=1.e-14)
+        np.testing.assert_allclose(galsim.bessel.yv(v,x), scipy.special.yv(v,x),
+                                   rtol=1.e-10, atol=1.e-14)
+        np.testing.assert_allclose(galsim.bessel.iv(v,x[:,:10]), scipy.special.iv(v,x[:,:10]),
+                                   rtol=1.e-10)
+        np.testing.assert_allclose(galsim.bessel.kv(v,x), scipy.special.kv(v,x), rtol=1.e-10)
+    np.testing.assert_allclose(galsim.bessel.gammainc(2.7,x), scipy.special.gammainc(2.7,x),
+                               rtol=1.e-10)
+
+    # Arrays of both v and x broadcast the same way scipy does.
+    v = np.array([0, 1, 2.3, 1, 0])
+    xx = x[:,:5]
+    np.testing.assert_allclose(galsim.bessel.jv(v,xx), scipy.special.jv(v,xx),
+                               rtol=1.e-10, atol=1.e-14)
+    np.testing.assert_allclose(galsim.bessel.kv(v,xx), scipy.special.kv(v,xx), rtol=1.e-10)
+    np.testing.assert_allclose(galsim.bessel.gammainc(v+1,xx), scipy.special.gammainc(v+1,xx),
+                               rtol=1.e-10)
+
+    # Scalars still return scalars.
+    assert np.ndim(galsim.bessel.jv(1.3, 2.)) == 0
+    assert np.ndim(galsim.bessel.j0(2.)) == 0
+
+    # Invalid values raise an exception, just like the scalar versions.
+    with assert_raises(RuntimeError):
+        galsim.bessel.kv(1.1, np.array([1., 2., -1.]))
+
+    # Also for arrays large enough to be split across threads.
+    xbad = np.linspace(0.01, 50., 2000)
+    xbad[1500] = -1.
+    with assert_raises(RuntimeError):
+        galsim.bessel.kv(1.1, xbad)
+    with assert_raises(RuntimeError):
+        galsim.bessel.gammainc(2.7, xbad)
+    with assert_raises(RuntimeError):
+        galsim.bessel.gammainc(2.7, -1.)
+
 
 if __name__ == "__main__":
     testfns = [v for k, v in vars().items() if k[:5] == 'test_' and callable(v)]
@@ -361,6 +361,72 @@ def test_exampleimage():
         # which is expected
 
 
+def _apply_cd_reference(image, cd, gain_ratio):
+    """The original pixel-by-pixel implementation of ApplyCDModel, vectorized over pixels.
+
+    The terms are accumulated onto each pixel in the same order as the original C++ loops.
+    """
+    f0 = image.array.astype(np.float64)
+    ny, nx = f0.shape
+    dmax = cd.n
+    # Mean of each pixel with its neighbor across each border, or 0 at the edge of the image.
+    fT = np.zeros_like(f0)
+    fB = np.zeros_like(f0)
+    fR = np.zeros_like(f0)
+    fL = np.zeros_like(f0)
+    fT[:-1,:] = (f0[:-1,:] + f0[1:,:]) / 2.
+    fB[1:,:] = (f0[1:,:] + f0[:-1,:]) / 2.
+    fR[:,:-1] = (f0[:,:-1] + f0[:,1:]) / 2.
+    fL[:,1:] = (f0[:,1:] + f0[:,:-1]) / 2.
+
+    f = f0.copy()
+    for iy in range(-dmax, dmax+1):
+        for ix in range(-dmax, dmax+1):
+            # q[y,x] = input(x+ix, y+iy) * gain_ratio, or 0 if that pixel doesn't exist.
+            q = np.zeros_like(f0)
+            if abs(iy) < ny and abs(ix) < nx:
+                q[max(0,-iy):min(ny,ny-iy), max(0,-ix):min(nx,nx-ix)] = (
+                    f0[max(0,iy):min(ny,ny+iy), max(0,ix):min(nx,nx+ix)] * gain_ratio)
+            # Each border only applies if the pixel mirrored across it exists.
+            # (The max(y1,...) and max(x1,...) keep these from becoming negative indices.)
+            y1 = max(0,iy-1); y2 = max(y1,min(ny,ny-1+iy))
+            f[y1:y2,:] += q[y1:y2,:] * fT[y1:y2,:] * cd.a_t.array[iy+dmax,ix+dmax]
+            y1 = max(0,iy+1); y2 = max(y1,min(ny,ny+1+iy))
+            f[y1:y2,:] += q[y1:y2,:] * fB[y1:y2,:] * cd.a_b.array[iy+dmax,ix+dmax]
+            x1 = max(0,ix+1); x2 = max(x1,min(nx,nx+1+ix))
+            f[:,x1:x2] += q[:,x1:x2] * fL[:,x1:x2] * cd.a_l.array[iy+dmax,ix+dmax]
+            x1 = max(0,ix-1); x2 = max(x1,min(nx,nx-1+ix))
+            f[:,x1:x2] += q[:,x1:x2] * fR[:,x1:x2] * cd.a_r.array[iy+dmax,ix+dmax]
+    return f.astype(image.dtype)
+
+
+@timer
+def test_apply_reference():
+    """Test applyForward against the original pixel-by-pixel implementation.
+    """
+    # ApplyCDModel works on tiles of 256 pixels along each row.  Use non-square images whose
+    # sizes are not multiples of that, with bounds that don't start at 1.
+    rng = np.random.default_rng(rseed)
+    for nx, ny, dmax, dtype in [ (300, 77, 3, np.float64),
+                                 (77, 300, 2, np.float64),
+                                 (513, 41, 4, np.float32),
+                                 (5, 3, 3, np.float64) ]:
+        print(nx, ny, dmax, dtype)
+        image = galsim.Image(1.e4 * rng.uniform(size=(ny, nx)) + 1.e3, dtype=dtype,
+                             xmin=3, ymin=-1)
+        n = 2*dmax+1
+        a_l, a_r, a_b, a_t = [1.e-7 * (rng.uniform(size=(n,n)) - 0.3) for i in range(4)]
+        cd = galsim.cdmodel.BaseCDModel(a_l, a_r, a_b, a_t)
+        for gain_ratio in [1., 1.3]:
+            out = cd.applyForward(image, gain_ratio=gain_ratio)
+            expected = _apply_cd_reference(image, cd, gain_ratio)
+            assert out.bounds == image.bounds
+            # Make sure the coefficients are large enough for this to be a meaningful test.
+            assert np.max(np.abs(out.array - image.array) / image.array) > 1.e-3
+            np.testing.assert_allclose(out.array, expected,
+                                       rtol=1.e-12 if dtype == np.float64 else 1.e-6)
+
+
 if __name__ == "__main__":
     testfns = [v for k, v in vars().items() if k[:5] == 'test_' and callable(v)]
     for testfn in testfns:
@@ -474,6 +474,43 @@ def test_realspace_shearconvolve():
             img.array, saved_img.array, 5,
             err_msg="Using GSObject Convolve([pixel,psf]) disagrees with expected result")
 
+@timer
+def test_realspace_threads():
+    """Test that real-space convolution gives the same image for any number of threads.
+    """
+    orig_nthreads = galsim.get_omp_threads()
+    box = galsim.Box(0.4, 0.3)
+    # Kolmogorov and VonKarman look up their radial profiles in tables that are not equally
+    # spaced, and VonKarman only builds its table the first time it is needed.  Use a lam
+    # that no other test uses, so the VonKarman tables are built inside the parallel loop.
+    # The last one only overlaps part of the image, and not the first pixel.
+    objs = [ galsim.Convolve(galsim.Kolmogorov(fwhm=0.7), box, real_space=True),
+             galsim.Convolve(galsim.VonKarman(lam=567.8, r0=0.2), box.shift(0.9, 0.7),
+                             real_space=True),
+             galsim.Convolve(galsim.TopHat(0.5).shift(1.1, 0.8), box, real_space=True) ]
+    for obj in objs:
+        images = []
+        for nthreads in [4, 1]:
+            galsim.set_omp_threads(nthreads)
+            images.append(obj.drawImage(nx=24, ny=24, scale=0.15, method='no_pixel'))
+        galsim.set_omp_threads(orig_nthreads)
+        np.testing.assert_array_equal(images[0].array, images[1].array,
+                                      err_msg="Real-space convolution depends on nthreads")
+
+    # The first pixel of the last one is outside the support.
+    assert images[0].array[0,0] == 0.
+    assert images[0].array.max() > 0.
+
+    # Also check the ones with a smooth profile against the FFT result.
+    for obj in objs[:2]:
+        im = obj.drawImage(nx=24, ny=24, scale=0.15, method='no_pixel')
+        fft_obj = galsim.Convolve(obj.obj_list, real_space=False)
+        fft_im = fft_obj.drawImage(nx=24, ny=24, scale=0.15, method='no_pixel')
+        np.testing.assert_allclose(im.array, fft_im.array, rtol=0,
+                                   atol=2.e-3 * fft_im.array.max(),
+                                   err_msg="Real-space convolution disagrees with FFT")
+
+
 @timer
 def test_deconvolve():
     """Test that deconvolution works as expected
@@ -1001,6 +1038,35 @@ def test_gsparams():
     assert conv6.obj_list[1].gsparams == gsp2
     assert conv6.obj_list[1].orig_obj.gsparams == galsim.GSParams()
 
+@timer
+def test_convolve_strips():
+    """Test that the C++ SBConvolve drawing in k space one strip of rows at a time matches
+    drawing the components separately.
+    """
+    # cf. test_add_strips in test_sum.py.  Convolution draws its k image in python, but
+    # SBConvolve is used when a convolution is part of a larger profile in C++, so call its
+    # drawK function directly.  It draws the k images of its components onto strips of rows.
+    # Check it against drawing each component onto its own full k image and multiplying them.
+    # With 500 columns of complex128, the strips are 32 rows, so 211 rows leaves a shorter
+    # strip at the end.
+    components = [ galsim.Gaussian(sigma=1.7).shear(g1=0.2, g2=-0.1),
+                   galsim.Exponential(half_light_radius=2.3).shear(g1=-0.3, g2=0.2),
+                   galsim.Sersic(n=2.5, half_light_radius=1.1).shear(e1=0.1).shift(3.,-2.) ]
+    conv = galsim.Convolve(components)
+    bounds = galsim.BoundsI(-250, 249, -105, 105)
+
+    jac = np.array([[0.9, 0.3], [-0.2, 1.1]])
+    for _jac in [0, jac.__array_interface__['data'][0]]:
+        kimage = galsim.ImageCD(bounds, scale=0.05)
+        conv._sbp.drawK(kimage._image, kimage.scale, _jac)
+        expected = galsim.ImageCD(bounds, scale=0.05, init_value=1.)
+        for c in components:
+            im1 = galsim.ImageCD(bounds, scale=0.05)
+            c._sbp.drawK(im1._image, im1.scale, _jac)
+            expected *= im1
+        np.testing.assert_allclose(kimage.array, expected.array, rtol=1.e-10,
+                                   atol=1.e-12 * np.max(np.abs(expected.array)))
+
 
 if __name__ == "__main__":
     testfns = [v for k, v in vars().items() if k[:5] == 'test_' and callable(v)]
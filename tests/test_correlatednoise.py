@@ -1352,6 +1352,55 @@ def test_gsparams():
     assert ccn1.withGSParams(ccn.gsparams) == ccn
 
 
+@timer
+def test_covariance_matrix():
+    """Test calculateCovarianceMatrix and calculateCovarianceLags against a direct calculation.
+    """
+    # Use an asymmetric correlation function and a non-square image, so any mixup of the
+    # x and y directions would show up.
+    cf = galsim.Gaussian(sigma=1.3).shear(g1=0.2, g2=0.3).shift(0.1, 0.2)
+    dx = 0.7
+    bounds = galsim.BoundsI(3, 6, -1, 1)
+    idim = bounds.xmax - bounds.xmin + 1
+    jdim = bounds.ymax - bounds.ymin + 1
+    covdim = idim * jdim
+
+    # The direct calculation: evaluate the correlation function for every element of the upper
+    # triangle, the way calculateCovarianceMatrix used to.
+    cov_direct = np.zeros((covdim, covdim))
+    for i in range(1, covdim+1):
+        for j in range(i, covdim+1):
+            k = (j-1) // jdim - (i-1) // idim
+            ell = (j-1) % jdim - (i-1) % idim
+            cov_direct[j-1, i-1] = cf.xValue(k*dx, ell*dx)
+
+    cov = galsim.ImageD(covdim, covdim)
+    galsim._galsim.calculateCovarianceMatrix(cov._image, cf._sbp, bounds._b, dx)
+    np.testing.assert_allclose(cov.array, cov_direct, rtol=1.e-12, atol=1.e-15)
+    # Only the upper triangle is set.
+    assert np.all(cov.array[np.triu_indices(covdim, 1)] == 0.)
+
+    # The lags image has the correlation function at each pixel separation (k, l).
+    lags = galsim.ImageD(galsim.BoundsI(1-jdim, idim-1, 1-idim, jdim-1))
+    galsim._galsim.calculateCovarianceLags(lags._image, cf._sbp, bounds._b, dx)
+    for k in range(1-jdim, idim):
+        for ell in range(1-idim, jdim):
+            np.testing.assert_allclose(lags(k, ell), cf.xValue(k*dx, ell*dx), rtol=1.e-12)
+    for i in range(1, covdim+1):
+        for j in range(i, covdim+1):
+            k = (j-1) // jdim - (i-1) // idim
+            ell = (j-1) % jdim - (i-1) % idim
+            assert cov(i, j) == lags(k, ell)
+
+    # The images must have the right bounds.
+    with assert_raises(RuntimeError):
+        galsim._galsim.calculateCovarianceMatrix(
+            galsim.ImageD(covdim-1, covdim-1)._image, cf._sbp, bounds._b, dx)
+    with assert_raises(RuntimeError):
+        galsim._galsim.calculateCovarianceLags(
+            galsim.ImageD(2*idim-1, 2*jdim-1)._image, cf._sbp, bounds._b, dx)
+
+
 if __name__ == "__main__":
     testfns = [v for k, v in vars().items() if k[:5] == 'test_' and callable(v)]
     for testfn in testfns:
@@ -1689,6 +1689,174 @@ def test_direct_scale():
     assert_raises(TypeError, obj.drawPhot, im2, sensor=5)
     assert_raises(ValueError, obj.makePhot, n_photons=-20)
 
+@timer
+def test_value_many():
+    """Test that SBProfile xValueMany and kValueMany match xValue and kValue point by point.
+    """
+    # Include r=0, tiny r, and points far out in the wings.
+    x = np.array([0., 0., 1.e-8, 0.03, -0.3, 0.7, 1.2, -2.5, 4., 10., 25., 100.])
+    y = np.array([0., 1.e-5, 0., 0.05, 0.2, -0.9, 1.1, 0.3, -3., 7., -25., 3.])
+    # Include k=0 and very large k, well past maxk.
+    kx = np.array([0., 0., 1.e-6, 0.2, -1.3, 2.1, 5., -8., 20., 200., 1.e3, 3.e4])
+    ky = np.array([0., 1.e-4, 0., 0.1, 0.7, -1.9, 3., 12., -20., -50., 2.e3, -1.e4])
+    N = len(x)
+    ptr = lambda a: a.__array_interface__['data'][0]
+
+    im = galsim.Gaussian(sigma=1.1).shear(g1=0.2, g2=-0.1).drawImage(nx=32, ny=32, scale=0.2)
+    # The 8 profiles with their own kernels, and the two wrappers that forward to them.
+    objs = [
+        galsim.Gaussian(sigma=1.3, flux=2.),
+        galsim.Exponential(scale_radius=0.7, flux=2.),
+        galsim.Moffat(beta=2.5, scale_radius=0.8, flux=2.),
+        galsim.Moffat(beta=3.1, scale_radius=0.8, trunc=5., flux=2.),
+        galsim.Sersic(n=2.3, scale_radius=0.5, flux=2.),
+        galsim.Sersic(n=1.7, scale_radius=0.5, trunc=4., flux=2.),
+        galsim.Kolmogorov(lam_over_r0=0.5, flux=2.),
+        galsim.Airy(lam_over_diam=0.5, flux=2.),
+        galsim.Airy(lam_over_diam=0.5, obscuration=0.3, flux=2.),
+        galsim.VonKarman(lam=700., r0=0.1, L0=20., flux=2.),
+        galsim.VonKarman(lam=700., r0=0.1, L0=20., flux=2., do_delta=True),
+        galsim.InterpolatedImage(im, x_interpolant='quintic'),
+        galsim.Sersic(n=2.3, scale_radius=0.5).shear(g1=0.1, g2=0.2).shift(0.1, -0.2) * 1.3,
+        galsim.Gaussian(sigma=1.3, flux=2.) + galsim.Moffat(beta=2.5, scale_radius=0.8),
+    ]
+    for obj in objs:
+        print(obj)
+        sbp = obj._sbp
+        if not isinstance(obj, galsim.InterpolatedImage):
+            # (InterpolatedImage uses the default xValueMany, which just calls xValue.)
+            val = np.empty(N)
+            sbp.xValueMany(ptr(x), ptr(y), ptr(val), N)
+            val1 = [sbp.xValue(galsim.PositionD(xx,yy)._p) for xx,yy in zip(x,y)]
+            np.testing.assert_allclose(val, val1, rtol=1.e-14, atol=0)
+
+        kval = np.empty(N, dtype=complex)
+        sbp.kValueMany(ptr(kx), ptr(ky), ptr(kval), N)
+        kval1 = [sbp.kValue(galsim.PositionD(kkx,kky)._p) for kkx,kky in zip(kx,ky)]
+        np.testing.assert_allclose(kval, kval1, rtol=1.e-14, atol=0)
+
+
+@timer
+def test_value_array():
+    """Test that GSObject xValueArray and kValueArray match xValue and kValue point by point.
+    """
+    rng = np.random.RandomState(1234)
+    # Use 2d arrays to check that the shape is preserved.  Include the origin.
+    x = rng.uniform(-3., 3., size=(5,7))
+    y = rng.uniform(-3., 3., size=(5,7))
+    x[0,0] = y[0,0] = 0.
+    kx = rng.uniform(-10., 10., size=(5,7))
+    ky = rng.uniform(-10., 10., size=(5,7))
+    kx[0,0] = ky[0,0] = 0.
+
+    im = galsim.Gaussian(sigma=1.1).shear(g1=0.2, g2=-0.1).drawImage(nx=32, ny=32, scale=0.2)
+    objs = [
+        galsim.Gaussian(sigma=1.3, flux=2.),
+        galsim.Sersic(n=2.3, scale_radius=0.5, trunc=4., flux=2.),
+        galsim.VonKarman(lam=700., r0=0.1, L0=20., flux=2.),
+        galsim.InterpolatedImage(im, x_interpolant='quintic'),
+        galsim.Sersic(n=2.3, scale_radius=0.5).shear(g1=0.1, g2=0.2).shift(0.1, -0.2) * 1.3,
+        galsim.Gaussian(sigma=1.3, flux=2.) + galsim.Moffat(beta=2.5, scale_radius=0.8),
+    ]
+    for obj in objs:
+        print(obj)
+        val = obj.xValueArray(x, y)
+        assert val.shape == x.shape
+        assert val.dtype == np.float64
+        val1 = [[obj.xValue(xx,yy) for xx,yy in zip(xrow,yrow)] for xrow,yrow in zip(x,y)]
+        np.testing.assert_allclose(val, val1, rtol=1.e-12, atol=0)
+
+        kval = obj.kValueArray(kx, ky)
+        assert kval.shape == kx.shape
+        assert kval.dtype == np.complex128
+        kval1 = [[obj.kValue(kkx,kky) for kkx,kky in zip(kxrow,kyrow)]
+                 for kxrow,kyrow in zip(kx,ky)]
+        np.testing.assert_allclose(kval, kval1, rtol=1.e-12, atol=1.e-15)
+
+    # Lists, integers, non-contiguous arrays and scalars are all fine.
+    obj = objs[0]
+    np.testing.assert_allclose(obj.xValueArray([0, 1, 2], [1, 0, 2]),
+                               [obj.xValue(0,1), obj.xValue(1,0), obj.xValue(2,2)], rtol=1.e-12)
+    np.testing.assert_allclose(obj.xValueArray(x[:,::2], y[:,::2]),
+                               obj.xValueArray(x, y)[:,::2], rtol=1.e-12)
+    np.testing.assert_allclose(obj.kValueArray(kx.T, ky.T), obj.kValueArray(kx, ky).T,
+                               rtol=1.e-12)
+    np.testing.assert_allclose(obj.xValueArray(0.3, 0.2), obj.xValue(0.3, 0.2), rtol=1.e-12)
+    assert obj.xValueArray(np.array([]), np.array([])).shape == (0,)
+
+    assert_raises(galsim.GalSimIncompatibleValuesError, obj.xValueArray, x, y[:3])
+    assert_raises(galsim.GalSimIncompatibleValuesError, obj.kValueArray, kx, ky.T)
+    assert_raises(galsim.GalSimValueError, obj.xValueArray, x + 1j, y)
+    assert_raises(galsim.GalSimValueError, obj.kValueArray, kx, ky.astype(complex))
+    assert_raises(galsim.GalSimValueError, obj.xValueArray, ['a', 'b'], [1, 2])
+    conv = galsim.Convolve(objs[0], objs[1])
+    assert_raises(galsim.GalSimError, conv.xValueArray, x, y)
+    np.testing.assert_allclose(conv.kValueArray(kx, ky), objs[0].kValueArray(kx, ky) *
+                               objs[1].kValueArray(kx, ky), rtol=1.e-12, atol=1.e-15)
+
+
+@timer
+def test_drawKMany():
+    """Test that SBProfile.drawKMany matches drawing each profile with drawKImage.
+    """
+    # A typical chromatic use case is a PSF at a list of wavelengths.
+    objs = [galsim.Kolmogorov(lam_over_r0=lr) for lr in [0.3, 0.5, 0.8]]
+    objs += [galsim.Airy(lam_over_diam=lr, obscuration=0.2) for lr in [0.3, 0.5]]
+    objs += [galsim.VonKarman(lam=lam, r0=0.1, L0=20.) for lam in [500, 700, 900]]
+    objs += [galsim.Moffat(beta=2.5, scale_radius=0.7), galsim.Gaussian(sigma=0.7, flux=1.5)]
+    weights = [0.5 + 0.1*i for i in range(len(objs))]
+    sbps = [obj._sbp for obj in objs]
+    # drawKImage for Gaussian uses a separable calculation without the small and large k
+    # approximations that kValue uses, so they only agree to about kvalue_accuracy.
+    atol = [1.e-12] * (len(objs)-1) + [galsim.GSParams().kvalue_accuracy * 1.5]
+
+    for dtype in [np.complex128, np.complex64]:
+        rtol = 1.e-10 if dtype == np.complex128 else 1.e-6
+        bounds = galsim.BoundsI(-20,20,-20,20)
+        dk = 0.37
+        images = [galsim.Image(bounds=bounds, dtype=dtype, scale=dk) for obj in objs]
+        galsim._galsim.SBProfile.drawKMany(sbps, weights, [im._image for im in images], dk)
+
+        total = galsim.Image(bounds=bounds, dtype=dtype, scale=dk)
+        for obj, w, im, a in zip(objs, weights, images, atol):
+            im1 = obj.drawKImage(image=galsim.Image(bounds=bounds, dtype=dtype, scale=dk))
+            np.testing.assert_allclose(im.array, w * im1.array, rtol=rtol, atol=a)
+            total += w * im1
+
+        # With a single image, it gets the weighted sum.
+        sum_image = galsim.Image(bounds=bounds, dtype=dtype, scale=dk)
+        galsim._galsim.SBProfile.drawKMany(sbps, weights, [sum_image._image], dk)
+        np.testing.assert_allclose(sum_image.array, total.array, rtol=rtol,
+                                   atol=np.sum(atol))
+
+    # The sum is accumulated in a fixed order, so repeated calls with multiple threads give
+    # exactly the same result.
+    orig_nthreads = galsim.get_omp_threads()
+    galsim.set_omp_threads(4)
+    many_objs = [galsim.Kolmogorov(lam_over_r0=0.3 + 0.01*i) for i in range(50)]
+    many_sbps = [obj._sbp for obj in many_objs]
+    many_weights = [1. + 0.1*i for i in range(len(many_objs))]
+    images = []
+    for i in range(3):
+        images.append(galsim.Image(bounds=bounds, dtype=np.complex128, scale=dk))
+        galsim._galsim.SBProfile.drawKMany(many_sbps, many_weights, [images[-1]._image], dk)
+    galsim.set_omp_threads(orig_nthreads)
+    np.testing.assert_array_equal(images[1].array, images[0].array)
+    np.testing.assert_array_equal(images[2].array, images[0].array)
+
+    # Errors
+    im = galsim.Image(bounds=bounds, dtype=np.complex128, scale=dk)
+    im2 = galsim.Image(bounds=galsim.BoundsI(-10,10,-10,10), dtype=np.complex128, scale=dk)
+    with assert_raises(RuntimeError):
+        galsim._galsim.SBProfile.drawKMany(sbps, weights[:2], [im._image], dk)
+    with assert_raises(RuntimeError):
+        galsim._galsim.SBProfile.drawKMany(sbps, weights, [im._image, im._image], dk)
+    with assert_raises(RuntimeError):
+        galsim._galsim.SBProfile.drawKMany(sbps[:2], weights[:2], [im._image, im2._image], dk)
+    with assert_raises(RuntimeError):
+        sheared = galsim.Kolmogorov(lam_over_r0=0.5).shear(g1=0.2, g2=0.1)
+        galsim._galsim.SBProfile.drawKMany([sheared._sbp], [1.], [im._image], dk)
+
 if __name__ == "__main__":
     testfns = [v for k, v in vars().items() if k[:5] == 'test_' and callable(v)]
     for testfn in testfns:
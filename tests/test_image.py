@@ -85,6 +85,52 @@ else:
 datadir = os.path.join(".", "Image_comparison_images")
 
 
+@timer
+def test_scratch_pool():
+    """Test the C++ scratch memory pool used for temporary images and photon arrays.
+    """
+    # Photon shooting through a C++ SBConvolve uses temporary PhotonArrays from the pool.
+    gal = galsim.Convolve(galsim.Gaussian(sigma=1.3), galsim.Moffat(beta=2.5, fwhm=0.9))
+    def shoot():
+        photons = galsim.PhotonArray(10000)
+        gal._sbp.shoot(photons._pa, galsim.BaseDeviate(1234)._rng)
+        return photons
+
+    galsim._galsim.ClearScratchPool()
+    galsim._galsim.ResetScratchCounters()
+    assert galsim._galsim.GetScratchBytesPooled() == 0
+
+    p1 = shoot()
+    n_alloc1 = galsim._galsim.GetScratchBytesAllocated()
+    n_req1 = galsim._galsim.GetScratchBytesRequested()
+    print('first shoot: ', n_req1, n_alloc1)
+    assert n_req1 >= 3 * 10000 * 8
+    assert n_alloc1 >= n_req1
+
+    # The second one reuses the block freed by the first one.  The reused memory holds
+    # the old photons, but the result should be the same as with fresh memory.
+    p2 = shoot()
+    n_alloc2 = galsim._galsim.GetScratchBytesAllocated() - n_alloc1
+    n_req2 = galsim._galsim.GetScratchBytesRequested() - n_req1
+    print('second shoot: ', n_req2, n_alloc2)
+    assert n_req2 == n_req1
+    assert n_alloc2 == 0
+    np.testing.assert_array_equal(p2.x, p1.x)
+    np.testing.assert_array_equal(p2.y, p1.y)
+    np.testing.assert_array_equal(p2.flux, p1.flux)
+
+    # The free lists of all threads together are capped at 16 MB.
+    pooled = galsim._galsim.GetScratchBytesPooled()
+    assert 0 < pooled <= 16 * 2**20
+
+    # ClearScratchPool releases the free lists of all threads.
+    galsim._galsim.ClearScratchPool()
+    assert galsim._galsim.GetScratchBytesPooled() == 0
+    p3 = shoot()
+    np.testing.assert_array_equal(p3.x, p1.x)
+    np.testing.assert_array_equal(p3.flux, p1.flux)
+
+
 @timer
 def test_Image_basic():
     """Test that all supported types perform basic Image operations correctly
@@ -3381,6 +3427,66 @@ def test_wrap():
     assert_raises(ValueError, im3.wrap, b3, hermitian='invalid')
 
 
+@timer
+def test_wrap_large():
+    """Test image.wrap() on images that are large enough to split the work over threads.
+    """
+    # wrapImage only uses multiple threads for images with at least 65536 pixels, so all of
+    # the images here are larger than that (including the implicitly Hermitian halves).
+    # The results should be identical to the serial calculation, so compare different numbers
+    # of threads exactly, and compare to a direct numpy calculation of the expected sums.
+    orig_nthreads = galsim.get_omp_threads()
+
+    def check_wrap(im, b, hermitian, im_test):
+        results = []
+        for nthreads in [4, 1]:
+            galsim.set_omp_threads(nthreads)
+            results.append(im.copy().wrap(b, hermitian=hermitian))
+        galsim.set_omp_threads(orig_nthreads)
+        assert results[0].bounds == b
+        np.testing.assert_array_equal(results[0].array, results[1].array,
+                                      err_msg="image.wrap(%s) depends on nthreads"%b)
+        np.testing.assert_allclose(results[0].array, im_test.array, rtol=0,
+                                   atol=1.e-12 * np.max(np.abs(im_test.array)))
+
+    def expected_wrap(arr, xmin, ymin, b):
+        # Add each pixel onto the pixel in b that it wraps to.
+        ny, nx = arr.shape
+        ii = (np.arange(xmin, xmin+nx) - b.xmin) % (b.xmax-b.xmin+1)
+        jj = (np.arange(ymin, ymin+ny) - b.ymin) % (b.ymax-b.ymin+1)
+        im_test = galsim.Image(b, dtype=arr.dtype, init_value=0)
+        np.add.at(im_test.array, (jj[:,np.newaxis], ii[np.newaxis,:]), arr)
+        return im_test
+
+    # A real image where the wrapped bounds are not a simple fraction of the original.
+    rng = np.random.default_rng(1234)
+    arr = rng.normal(size=(251, 300))
+    b = galsim.BoundsI(17, 60, 33, 71)
+    check_wrap(galsim.Image(arr, xmin=1, ymin=1), b, False, expected_wrap(arr, 1, 1, b))
+
+    # A Hermitian complex image, stored explicitly and as the two implicitly Hermitian halves.
+    M = 200
+    N = 180
+    K = 37
+    L = 23
+    i = np.arange(-M, M+1)[np.newaxis,:]
+    j = np.arange(-N, N+1)[:,np.newaxis]
+    arr = np.exp((i/(2.3*M))**2 + 1j*(2.8*i-1.3*j)) + ((2 + 3j*j)/(1.9*N))**3
+    np.testing.assert_allclose(arr, np.conj(arr[::-1,::-1]), rtol=1.e-14)
+    b = galsim.BoundsI(-K+1, K, -L+1, L)
+    b2 = galsim.BoundsI(-K+1, K, 0, L)
+    b3 = galsim.BoundsI(0, K, -L+1, L)
+    im = galsim.Image(arr, xmin=-M, ymin=-N)
+    im2 = galsim.Image(arr[N:,:].copy(), xmin=-M, ymin=0)
+    im3 = galsim.Image(arr[:,M:].copy(), xmin=0, ymin=-N)
+    assert im2.array.size >= 65536
+    assert im3.array.size >= 65536
+    im_test = expected_wrap(arr, -M, -N, b)
+    check_wrap(im, b, False, im_test)
+    check_wrap(im2, b2, 'y', im_test[b2])
+    check_wrap(im3, b3, 'x', im_test[b3])
+
+
 @timer
 def test_FITS_bad_type():
     """Test that reading FITS files with an invalid data type succeeds by converting the
@@ -320,6 +320,34 @@ def test_hankel():
         galsim.integ.hankel(f1, k=0.3, nu=-0.5)
 
 
+@timer
+def test_hankel_many():
+    """Test galsim.integ.hankel with a shared table in log(r) for many k values.
+    """
+    f1 = lambda r: np.exp(-r**2/2)
+    k = np.array([0, 1.e-8, 1.e-3, 0.1, 0.234, 1, 2.3, 5.7, 11.3])
+    for nu in [0, 1]:
+        # This uses hankel_inf for each k
+        expected_val = galsim.integ.hankel(f1, k, nu=nu)
+        # This uses hankel_inf_many with a single table.  The interpolation error is
+        # ~dlogr^4 max(f''''), which is a few x 1.e-9 here.
+        result = galsim.integ.hankel(f1, k, nu=nu, dlogr=0.01)
+        print(nu, result, expected_val)
+        np.testing.assert_allclose(result, expected_val, rtol=1.e-6, atol=1.e-8)
+        for kk, val in zip(k, result):
+            np.testing.assert_allclose(galsim.integ.hankel(f1, kk, nu=nu), val,
+                                       rtol=1.e-6, atol=1.e-8)
+
+    # The Hankel transform of exp(-r^2/2) is exp(-k^2/2).
+    result = galsim.integ.hankel(f1, k, dlogr=0.01)
+    np.testing.assert_allclose(result, np.exp(-k**2/2), rtol=1.e-6, atol=1.e-8)
+
+    with assert_raises(galsim.GalSimIncompatibleValuesError):
+        galsim.integ.hankel(f1, k, rmax=3., dlogr=0.01)
+    with assert_raises(galsim.GalSimValueError):
+        galsim.integ.hankel(f1, k, dlogr=0.)
+
+
 def test_gq_annulus():
     """Test the galsim.integ.gq_annulus function
     """
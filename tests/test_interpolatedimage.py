@@ -19,7 +19,6 @@
 import numpy as np
 import os
 import sys
-import platform
 
 import galsim
 from galsim_test_helpers import *
@@ -384,6 +383,64 @@ def test_interpolant():
     with assert_raises(galsim.GalSimValueError):
         q.kval(x2d)
 
+@timer
+def test_interpolant_taps():
+    """Test that the batched tap weights and 2d interpolation match xval point by point.
+    """
+    rng = np.random.default_rng(1234)
+    ptr = lambda a: a.__array_interface__['data'][0]
+    interps = [galsim.Delta(), galsim.Nearest(), galsim.SincInterpolant(), galsim.Linear(),
+               galsim.Cubic(), galsim.Quintic(), galsim.Lanczos(3),
+               galsim.Lanczos(5, conserve_dc=False), galsim.Lanczos(7)]
+
+    # Fractional offsets, including both ends of the range [0,1).
+    fs = np.concatenate([[0., 1.e-14, 1.e-8, 0.25, 0.5, 1.-1.e-8, 1.-1.e-14],
+                         rng.uniform(0., 1., 10)])
+
+    # A small grid, so the taps of the larger interpolants extend past the edges.
+    # The rows are padded to test the stride.
+    nx = 7
+    ny = 5
+    stride = nx + 3
+    data = rng.normal(size=(ny, stride))
+    # Points in the interior, at integers, on and just past the edges, and fully outside.
+    xy = [(2.3, 1.7), (3., 2.), (0., 0.), (nx-1., ny-1.), (-0.4, 2.2), (nx-0.6, 1.1),
+          (3.7, -0.9), (1.2, ny-0.2), (-0.999, -0.999), (-7.3, 2.), (3.1, ny+6.2)]
+    xy += list(zip(rng.uniform(-2., nx+1., 20), rng.uniform(-2., ny+1., 20)))
+
+    for interp in interps:
+        print(interp)
+        ii = interp._i
+        ntaps = ii.nTaps()
+        kmin = 1 - ntaps//2
+        # Lanczos tabulates its tap weights, which are accurate to 1.e-4 * xvalue_accuracy.
+        # The others calculate them directly.
+        if isinstance(interp, galsim.Lanczos):
+            atol = 1.e-4 * interp.gsparams.xvalue_accuracy
+        else:
+            atol = 1.e-15
+
+        for f in fs:
+            wts = np.empty(ntaps)
+            ii.xvalTaps(f, 0, ntaps-1, ptr(wts))
+            np.testing.assert_allclose(wts, interp.xval(np.arange(ntaps) + kmin - f),
+                                       rtol=0, atol=atol)
+            # Calculating a sub-range of the taps gives the same values for those taps.
+            if ntaps > 2:
+                wts2 = np.empty(ntaps-2)
+                ii.xvalTaps(f, 1, ntaps-2, ptr(wts2))
+                np.testing.assert_array_equal(wts2, wts[1:-1])
+
+        for x, y in xy:
+            val = ii.interpolate2d(ptr(data), nx, ny, stride, x, y)
+            xwt = interp.xval(x - np.arange(nx))
+            ywt = interp.xval(y - np.arange(ny))
+            val1 = ywt.dot(data[:, :nx]).dot(xwt)
+            np.testing.assert_allclose(val, val1, rtol=1.e-14,
+                                       atol=10 * atol * np.max(np.abs(data)),
+                                       err_msg="interpolate2d mismatch at %s, %s"%(x,y))
+
+
 @timer
 def test_unit_integrals():
     # Test Interpolant.unit_integrals
@@ -1770,25 +1827,32 @@ def test_depixelize():
     np.testing.assert_allclose(im5.array, im1.array, atol=1.e-7)
     t7 = time.time()
 
-    # Second time with the same size image is much faster, since uses a cache.
+    # Second time with the same size image uses the cached factorizations.
+    # The factorizations are only nx x nx and ny x ny, so this is no longer a big time savings,
+    # but the results should be identical.
     nopix_image2 = im1.depixelize(x_interpolant=interp)
     t8 = time.time()
-    if platform.python_implementation() != 'PyPy':
-        # PyPy timings can be fairly arbitrary at times.
-        assert t8-t7 < (t3-t2)/5
+    np.testing.assert_array_equal(nopix_image2.array, nopix_image.array)
 
-    # Even if the image is different.
+    # Same with a different image.
     nopix_image3 = im4.depixelize(x_interpolant=interp)
     t9 = time.time()
-    if platform.python_implementation() != 'PyPy':
-        assert t9-t8 < (t3-t2)/5
 
-    # But not if you clear the cache.
+    # And after clearing the cache.
     galsim.Image.clear_depixelize_cache()
     nopix_image4 = im4.depixelize(x_interpolant=interp)
     t10 = time.time()
-    if platform.python_implementation() != 'PyPy':
-        assert t10-t9 > (t3-t2)/5
+    np.testing.assert_array_equal(nopix_image4.array, nopix_image3.array)
+
+    # Other image sizes and interpolants are cached separately.
+    # Results shouldn't depend on what else is in the cache.
+    im8 = true_prof.drawImage(nx=ny, ny=nx, scale=scale, dtype=float)
+    nopix_image5 = im8.depixelize(x_interpolant=galsim.Lanczos(5))
+    nopix_image6 = im1.depixelize(x_interpolant=interp)
+    np.testing.assert_array_equal(nopix_image6.array, nopix_image.array)
+    galsim.Image.clear_depixelize_cache()
+    nopix_image7 = im8.depixelize(x_interpolant=galsim.Lanczos(5))
+    np.testing.assert_array_equal(nopix_image7.array, nopix_image5.array)
 
     print('times:')
     print('make ii_with_pixel: ',t1-t0)
@@ -1874,6 +1938,119 @@ def test_drawreal_seg_fault():
 
 
 
+@timer
+def test_drawreal_tiles():
+    """Test that the tiled drawing of an axis-aligned InterpolatedImage matches xValue.
+    """
+    # drawImage for an axis-aligned InterpolatedImage does the interpolation in tiles of
+    # 256 x 64 output pixels.  Compare it to evaluating each pixel separately with xValue,
+    # using output images whose sizes are not multiples of the tile size.
+    orig_nthreads = galsim.get_omp_threads()
+    rng = np.random.default_rng(1234)
+    scale = 0.3
+    im = galsim.Image(rng.normal(size=(180, 420)) + 1., scale=scale)
+
+    # (nx, ny, output scale, offset).  The last two only partially overlap the profile,
+    # so only some of the tiles have anything in them.
+    draws = [ (300, 150, scale, (0., 0.)),
+              (333, 201, scale / 1.7, (0.3, -0.2)),
+              (157, 71, scale * 2.3, (0., 0.)),
+              (517, 130, scale, (350., 0.)),
+              (270, 97, scale, (-100., 60.)) ]
+    for interp in ['linear', 'quintic', 'lanczos5']:
+        ii = galsim.InterpolatedImage(im, x_interpolant=interp)
+        for nx, ny, s, offset in draws:
+            print(interp, nx, ny, s, offset)
+            images = []
+            for nthreads in [4, 1]:
+                galsim.set_omp_threads(nthreads)
+                images.append(ii.drawImage(nx=nx, ny=ny, scale=s, offset=offset,
+                                           method='no_pixel', dtype=float))
+            galsim.set_omp_threads(orig_nthreads)
+            np.testing.assert_array_equal(images[0].array, images[1].array,
+                                          err_msg="Tiled drawImage depends on nthreads")
+
+            image = images[0]
+            x, y = np.meshgrid(np.arange(image.bounds.xmin, image.bounds.xmax+1),
+                               np.arange(image.bounds.ymin, image.bounds.ymax+1))
+            x = (x - image.true_center.x - offset[0]) * s
+            y = (y - image.true_center.y - offset[1]) * s
+            expected = ii.xValueArray(x, y) * s**2
+            assert np.any(expected != 0)
+            # drawImage steps through the positions incrementally, so allow for some
+            # accumulated rounding error in the positions.
+            np.testing.assert_allclose(image.array, expected, rtol=0,
+                                       atol=1.e-10 * np.max(np.abs(expected)))
+
+    # If the profile is entirely off the image, it should be all zeros.
+    image = ii.drawImage(nx=300, ny=150, scale=scale, offset=(1000., 0.), method='no_pixel')
+    np.testing.assert_array_equal(image.array, 0.)
+
+
+@timer
+def test_shared_cache():
+    """Test the cache of k-space data shared by InterpolatedImages made from identical images.
+    """
+    rng = np.random.default_rng(5678)
+    im = galsim.Image(rng.normal(size=(40, 50)) + 1., scale=0.2)
+    kpos = galsim.PositionD(0.7, -0.4)
+
+    galsim._galsim.ClearInterpolatedImageCache()
+    assert galsim._galsim.GetInterpolatedImageCacheSize() == 0
+    assert galsim._galsim.GetInterpolatedImageCacheBytes() == 0
+
+    ii1 = galsim.InterpolatedImage(im)
+    kval1 = ii1.kValue(kpos)
+    assert galsim._galsim.GetInterpolatedImageCacheSize() == 1
+    nbytes1 = galsim._galsim.GetInterpolatedImageCacheBytes()
+    # At least the k image should be included.
+    assert nbytes1 > 16 * im.array.size
+
+    # A different image with identical content uses the same entry.
+    ii2 = galsim.InterpolatedImage(im.copy())
+    assert ii2.kValue(kpos) == kval1
+    assert galsim._galsim.GetInterpolatedImageCacheSize() == 1
+    assert galsim._galsim.GetInterpolatedImageCacheBytes() == nbytes1
+
+    # Changing a single pixel makes a new one.
+    im3 = im.copy()
+    im3[20,30] += 1.e-3
+    ii3 = galsim.InterpolatedImage(im3)
+    kval3 = ii3.kValue(kpos)
+    assert kval3 != kval1
+    assert galsim._galsim.GetInterpolatedImageCacheSize() == 2
+    assert galsim._galsim.GetInterpolatedImageCacheBytes() > nbytes1
+    # Make sure this didn't use anything from the first one.
+    galsim._galsim.ClearInterpolatedImageCache()
+    ii3b = galsim.InterpolatedImage(im3)
+    assert ii3b.kValue(kpos) == kval3
+    assert galsim._galsim.GetInterpolatedImageCacheSize() == 1
+
+    # With a smaller maximum size, the least recently used entries get removed.
+    orig_max = galsim._galsim.SetInterpolatedImageCacheMaxBytes(nbytes1)
+    assert galsim._galsim.GetInterpolatedImageCacheSize() == 1
+    for i in range(5):
+        im4 = im.copy()
+        im4[10+i,10] += 1.
+        ii4 = galsim.InterpolatedImage(im4)
+        ii4.kValue(kpos)
+        assert galsim._galsim.GetInterpolatedImageCacheSize() == 1
+        assert galsim._galsim.GetInterpolatedImageCacheBytes() <= nbytes1
+    assert galsim._galsim.SetInterpolatedImageCacheMaxBytes(orig_max) == nbytes1
+
+    # Now the first image is a miss again, but the existing profiles still work.
+    assert ii1.kValue(kpos) == kval1
+    assert ii3.kValue(kpos) == kval3
+    ii5 = galsim.InterpolatedImage(im)
+    assert ii5.kValue(kpos) == kval1
+    assert galsim._galsim.GetInterpolatedImageCacheSize() == 2
+
+    galsim._galsim.ClearInterpolatedImageCache()
+    assert galsim._galsim.GetInterpolatedImageCacheSize() == 0
+    assert galsim._galsim.GetInterpolatedImageCacheBytes() == 0
+    assert ii1.kValue(kpos) == kval1
+
+
 if __name__ == "__main__":
     setup()
     testfns = [v for k, v in vars().items() if k[:5] == 'test_' and callable(v)]
@@ -1652,6 +1652,62 @@ def test_setFromImage_crash():
     assert len(w[0]) < 100  # I find it to be different in only 39 photons on my machine.
 
 
+@timer
+def test_shoot_chunks_error():
+    """Check that an exception raised while shooting a chunk propagates back to Python.
+    """
+    # SBDeconvolve cannot shoot photons.  Its shoot method raises an SBError, which must be
+    # passed back out of the (possibly multi-threaded) chunk loop rather than aborting.
+    gal = galsim.Gaussian(sigma=1.3)
+    deconv = galsim.Deconvolve(gal)
+    rng = galsim.BaseDeviate(1234)
+    for n_photons, chunk_size in [(100, 1000), (10000, 100)]:
+        photons = galsim.PhotonArray(n_photons)
+        assert_raises(RuntimeError, deconv._sbp.shootChunks, photons._pa, rng._rng, chunk_size)
+
+    # A shootable profile still works, and matches the total flux.
+    photons = galsim.PhotonArray(10000)
+    gal._sbp.shootChunks(photons._pa, rng._rng, 100)
+    np.testing.assert_allclose(photons.flux.sum(), gal.flux, rtol=1.e-12)
+
+
+@timer
+def test_shoot_chunks_threads():
+    """Check that shootChunks gives the same photons for any number of threads.
+    """
+    im = galsim.Gaussian(sigma=1.1).shear(g1=0.2, g2=0.1).drawImage(nx=32, ny=32, scale=0.3)
+    n_photons = 20000
+    orig_nthreads = galsim.get_omp_threads()
+
+    for chunk_size in [20000, 1000, 777]:
+        results = []
+        for nthreads in [1, 2, 4]:
+            galsim.set_omp_threads(nthreads)
+            # Make new profiles each time, so their photon-shooting data (e.g. the interpolant's
+            # sampler) are built inside shootChunks rather than already being there.
+            ii = galsim.InterpolatedImage(im, x_interpolant=galsim.Quintic())
+            objs = [ii, galsim.Convolve(ii, galsim.Moffat(beta=2.5, fwhm=0.7)),
+                    galsim.Sersic(n=2.1, half_light_radius=0.9)]
+            photons = []
+            for obj in objs:
+                p = galsim.PhotonArray(n_photons)
+                obj._sbp.shootChunks(p._pa, galsim.BaseDeviate(1234)._rng, chunk_size)
+                photons.append(p)
+            results.append(photons)
+        galsim.set_omp_threads(orig_nthreads)
+
+        for photons in results[1:]:
+            for p1, p2 in zip(results[0], photons):
+                np.testing.assert_array_equal(p2.x, p1.x)
+                np.testing.assert_array_equal(p2.y, p1.y)
+                np.testing.assert_array_equal(p2.flux, p1.flux)
+
+        # Different chunk sizes give different realizations (each chunk has its own seed),
+        # but they all have the right total flux.
+        for obj, p in zip(objs, results[0]):
+            np.testing.assert_allclose(p.flux.sum(), obj.flux, rtol=1.e-2)
+
+
 if __name__ == '__main__':
     testfns = [v for k, v in vars().items() if k[:5] == 'test_' and callable(v)]
     if no_astroplan:
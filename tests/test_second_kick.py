@@ -17,6 +17,7 @@
 #
 
 import numpy as np
+import os
 import galsim
 import time
 
@@ -300,6 +301,83 @@ def test_sk_ne():
     check_all_diff(objs)
 
 
+@timer
+def test_sk_table():
+    """Test the universal SecondKick table.
+    """
+    gsp = galsim.GSParams()
+    gsp_loose = galsim.GSParams(xvalue_accuracy=5.e-3)
+    kcrit_grid = lambda j: 0.2 * 10**(0.025*j)
+    rr = np.linspace(0, 0.1, 21)
+    kk = np.linspace(0, 50, 21)
+
+    def values(kcrit, gsparams):
+        sk = galsim.SecondKick(lam=500, r0=0.2, diam=4, kcrit=kcrit, gsparams=gsparams)._sbs
+        x = np.array([sk.xValue(galsim.PositionD(r,0)._p) for r in rr])
+        k = np.array([sk.kValue(galsim.PositionD(k,0)._p).real for k in kk])
+        return x, k, sk.stepK(), sk.maxK()
+
+    # At the grid points, the node is used directly, which matches the direct calculation to
+    # much better than the default accuracy.  With the default GSParams, a kcrit that is just
+    # off a grid point is not interpolated, so it is computed directly.
+    for j in [-40, 0, 20]:
+        x_table, k_table, stepk_table, maxk_table = values(kcrit_grid(j), gsp)
+        x_direct, k_direct, stepk_direct, maxk_direct = values(kcrit_grid(j) * (1.+1.e-9), gsp)
+        print('kcrit = ',kcrit_grid(j))
+        print('x_table = ',x_table)
+        print('x_direct = ',x_direct)
+        np.testing.assert_allclose(x_table, x_direct, rtol=0, atol=1.e-7*x_direct[0])
+        np.testing.assert_allclose(k_table, k_direct, rtol=0, atol=1.e-5)
+        np.testing.assert_allclose(stepk_table, stepk_direct, rtol=1.e-10)
+        np.testing.assert_allclose(maxk_table, maxk_direct, rtol=1.e-10)
+
+    # Between the grid points, the profile is interpolated from the 4 nearest nodes if the
+    # GSParams allow for the larger errors.  The interpolation is linear in the node values,
+    # so the result is the same combination of the profiles at those grid points.
+    def check_interp(kcrit):
+        t = np.log10(kcrit/0.2)/0.025 + 53
+        i0 = int(t) - 1
+        s = t - i0
+        w = [-(s-1)*(s-2)*(s-3)/6, s*(s-2)*(s-3)/2, -s*(s-1)*(s-3)/2, s*(s-1)*(s-2)/6]
+        x_table, k_table, _, _ = values(kcrit, gsp_loose)
+        nodes = [values(kcrit_grid(i0+k-53), gsp_loose) for k in range(4)]
+        x_interp = sum(w[k] * nodes[k][0] for k in range(4))
+        k_interp = sum(w[k] * nodes[k][1] for k in range(4))
+        print('kcrit = ',kcrit)
+        print('x_table = ',x_table)
+        print('x_interp = ',x_interp)
+        np.testing.assert_allclose(x_table, x_interp, rtol=0, atol=1.e-12*x_table[0])
+        np.testing.assert_allclose(k_table, k_interp, rtol=0, atol=1.e-5)
+        return set(range(i0, i0+4))
+
+    galsim.SecondKick.clear_table()
+    built = set()
+    for kcrit in [0.1234, 0.0317, 2.71]:
+        built |= check_interp(kcrit)
+        # Only the nodes that weren't needed before are built.
+        assert galsim._galsim.GetSecondKickTableNBuilt(gsp_loose._gsp) == len(built)
+
+    # With the default GSParams, the interpolation isn't accurate enough, so the profile is
+    # computed directly without building any nodes.
+    values(0.1234, gsp)
+    assert galsim._galsim.GetSecondKickTableNBuilt(gsp._gsp) == 0
+
+    # Write the table nodes that were built, and read them back in.  Then the nodes that are
+    # read in are used, rather than building them again.
+    file_name = os.path.join('output', 'sk_table.dat')
+    galsim.SecondKick.write_table(file_name, gsp_loose)
+    galsim.SecondKick.clear_table()
+    galsim.SecondKick.read_table(file_name, gsp_loose)
+    check_interp(0.1235)
+    assert galsim._galsim.GetSecondKickTableNBuilt(gsp_loose._gsp) == 0
+
+    # A table built with different GSParams is rejected.
+    with assert_raises(galsim.GalSimError):
+        galsim.SecondKick.read_table(file_name, gsp)
+    with assert_raises(galsim.GalSimError):
+        galsim.SecondKick.read_table(os.path.join('output', 'nonexistent_sk_table.dat'))
+
+
 if __name__ == '__main__':
     from argparse import ArgumentParser
     parser = ArgumentParser()
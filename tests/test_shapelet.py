@@ -254,6 +254,37 @@ def test_shapelet_fit():
         galsim.Shapelet.fit(sigma, 10, im2)
 
 
+@timer
+def test_shapelet_fit_cache():
+    """Test that fits using the cached design matrix match the ones built from scratch.
+    """
+    psf = galsim.Moffat(beta=3.4, half_light_radius=1.2, flux=20).shear(g1=0.11,g2=0.07)
+    scale = 0.2
+    sigma = 1.2
+    # 40 x 40 at order 10 is small enough to be cached.  64 x 64 is not.
+    for n in [40, 64]:
+        im = psf.drawImage(nx=n, ny=n, scale=scale)
+        galsim.Shapelet.clear_fit_cache()
+        shapelet1 = galsim.Shapelet.fit(sigma, 10, im)
+        # This one uses the cached design (for n=40).
+        shapelet2 = galsim.Shapelet.fit(sigma, 10, im)
+        np.testing.assert_array_equal(shapelet2.bvec, shapelet1.bvec)
+
+        # A different sigma needs a different design, since the grid is in units of sigma.
+        shapelet3 = galsim.Shapelet.fit(1.3*sigma, 10, im)
+        galsim.Shapelet.clear_fit_cache()
+        shapelet4 = galsim.Shapelet.fit(1.3*sigma, 10, im)
+        np.testing.assert_array_equal(shapelet4.bvec, shapelet3.bvec)
+        assert not np.array_equal(shapelet3.bvec, shapelet1.bvec)
+
+        # The cached design for one image works for another with the same geometry.
+        im2 = (psf.shift(0.1,0.2)).drawImage(nx=n, ny=n, scale=scale)
+        shapelet5 = galsim.Shapelet.fit(1.3*sigma, 10, im2)
+        galsim.Shapelet.clear_fit_cache()
+        shapelet6 = galsim.Shapelet.fit(1.3*sigma, 10, im2)
+        np.testing.assert_array_equal(shapelet6.bvec, shapelet5.bvec)
+
+
 @timer
 def test_shapelet_adjustments():
     """Test that adjusting the Shapelet profile in various ways does the right thing
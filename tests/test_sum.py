@@ -348,6 +348,50 @@ def test_gsparams():
     assert sum6.obj_list[1].gsparams == galsim.GSParams()
 
 
+@timer
+def test_add_strips():
+    """Test that the C++ SBAdd drawing one strip of rows at a time matches drawing the
+    components separately.
+    """
+    # Sum draws its components in python, but SBAdd is used when a sum is part of a larger
+    # profile in C++ (e.g. a real-space convolution), so call its draw functions directly.
+    # SBAdd draws its components onto strips of rows.  Check it against drawing each component
+    # onto its own full image and adding them.  The images here have 500 columns, so the strips
+    # are 65 rows for real float64 images and 32 rows for complex128 images.  Use 211 rows,
+    # which is not a multiple of either, so the last strip is shorter than the rest.
+    # None of the components are axisymmetric, so the strips are used even for centered images.
+    # Each strip starts its rows from a freshly computed position, rather than stepping there
+    # from the first row, so the results differ at the level of accumulated rounding errors.
+    components = [ galsim.Gaussian(sigma=1.7).shear(g1=0.2, g2=-0.1),
+                   galsim.Exponential(half_light_radius=2.3).shear(g1=-0.3, g2=0.2),
+                   galsim.Sersic(n=2.5, half_light_radius=1.1).shear(e1=0.1).shift(3.,-2.) ]
+    total = galsim.Add(components)
+    bounds = galsim.BoundsI(-250, 249, -105, 105)
+
+    # Axis-aligned, with and without an offset, and with a general jacobian.
+    jac = np.array([[0.9, 0.3], [-0.2, 1.1]])
+    for _jac in [0, jac.__array_interface__['data'][0]]:
+        for dx, dy in [(0., 0.), (0.3, -0.7)]:
+            image = galsim.ImageD(bounds, scale=0.1)
+            total._sbp.draw(image._image, image.scale, _jac, dx, dy, 1.)
+            expected = galsim.ImageD(bounds, scale=0.1)
+            for c in components:
+                im1 = galsim.ImageD(bounds, scale=0.1)
+                c._sbp.draw(im1._image, im1.scale, _jac, dx, dy, 1.)
+                expected += im1
+            np.testing.assert_allclose(image.array, expected.array, rtol=1.e-10,
+                                       atol=1.e-12 * np.max(np.abs(expected.array)))
+
+        kimage = galsim.ImageCD(bounds, scale=0.05)
+        total._sbp.drawK(kimage._image, kimage.scale, _jac)
+        expected = galsim.ImageCD(bounds, scale=0.05)
+        for c in components:
+            im1 = galsim.ImageCD(bounds, scale=0.05)
+            c._sbp.drawK(im1._image, im1.scale, _jac)
+            expected += im1
+        np.testing.assert_allclose(kimage.array, expected.array, rtol=1.e-10,
+                                   atol=1.e-12 * np.max(np.abs(expected.array)))
+
 
 if __name__ == "__main__":
     testfns = [v for k, v in vars().items() if k[:5] == 'test_' and callable(v)]
@@ -120,6 +120,28 @@ def test_vk_scale():
     np.testing.assert_almost_equal(img1.array, img2.array)
 
 
+@timer
+def test_vk_drawK():
+    """Test that drawKImage matches kValue.
+
+    This is a regression test for SBVonKarman::fillKImage, which used to pass k^2 to the
+    radial kValue function rather than k.
+    """
+    kwargs = {'lam':700, 'r0':0.1, 'L0':20.0, 'flux':2.2}
+    dk = 0.37
+    for vk in [galsim.VonKarman(**kwargs),
+               galsim.VonKarman(scale_unit='arcmin', **kwargs),
+               galsim.VonKarman(**kwargs).shear(g1=0.2, g2=-0.15)]:
+        print(vk)
+        # Centered on k=0, which fills the image by quadrants.
+        # Also an image not including k=0, which uses the regular loop.
+        for bounds in [galsim.BoundsI(-20,20,-20,20), galsim.BoundsI(5,30,3,20)]:
+            im = vk.drawKImage(image=galsim.ImageCD(bounds, scale=dk), recenter=False)
+            kval = np.array([[vk.kValue(i*dk, j*dk) for i in range(bounds.xmin, bounds.xmax+1)]
+                             for j in range(bounds.ymin, bounds.ymax+1)])
+            np.testing.assert_allclose(im.array, kval, rtol=1.e-10, atol=1.e-12)
+
+
 @timer
 def test_vk_shoot():
     """Test VonKarman with photon shooting.  Particularly the flux of the final image.
@@ -252,6 +274,82 @@ def test_vk_gsp():
     galsim.VonKarman(lam=700, r0=0.1, L0=24.3, gsparams=gsp2)
 
 
+@timer
+def test_vk_table():
+    """Test that profiles interpolated from the universal VonKarman table match direct ones.
+    """
+    # The table is used for 25 <= L0/r0 <= 1.e5 when xvalue_accuracy >= 3.e-6.  With a tighter
+    # xvalue_accuracy, the profile is always computed directly.
+    gsp = galsim.GSParams()
+    gsp_direct = galsim.GSParams(xvalue_accuracy=1.e-6)
+    r0 = 0.2
+    for L0 in [5.3, 6., 12.3, 47., 512., 9876., 19000.]:
+        vk_table = galsim.VonKarman(lam=500, r0=r0, L0=L0, gsparams=gsp)._sbvk
+        vk_direct = galsim.VonKarman(lam=500, r0=r0, L0=L0, gsparams=gsp_direct)._sbvk
+        hlr = vk_direct.getHalfLightRadius()
+        # The half-light radius is one of the points in the radial profile, whose spacing in
+        # log(r) depends on xvalue_accuracy, so this is only approximate.
+        np.testing.assert_allclose(vk_table.getHalfLightRadius(), hlr, rtol=0.02)
+        x_table = [vk_table.xValue(galsim.PositionD(r,0)._p)
+                   for r in hlr * np.array([0, 0.003, 0.013, 0.05, 0.3, 1, 2.5])]
+        x_direct = [vk_direct.xValue(galsim.PositionD(r,0)._p)
+                    for r in hlr * np.array([0, 0.003, 0.013, 0.05, 0.3, 1, 2.5])]
+        print('L0/r0 = ',L0/r0,' x_table = ',x_table,' x_direct = ',x_direct)
+        # The table is accurate to 3.e-6 of the central value.
+        np.testing.assert_allclose(x_table, x_direct, rtol=0, atol=3.e-6*x_direct[0])
+        # kValue is analytic, so it doesn't use the table.
+        for k in [0, 0.1, 1, 10, 100]:
+            k_table = vk_table.kValue(galsim.PositionD(k,0)._p)
+            k_direct = vk_direct.kValue(galsim.PositionD(k,0)._p)
+            np.testing.assert_allclose(k_table, k_direct, rtol=1.e-12, atol=1.e-15)
+    assert galsim._galsim.GetVonKarmanTableNBuilt(gsp_direct._gsp) == 0
+
+    # The result doesn't depend on which other profiles were made first.  Start from an empty
+    # table, make a profile that needs 4 new nodes, and compare it with one made after the
+    # nodes were already built for another profile.  (The profiles themselves are cached, so
+    # use force_stepk to make a new one whose radial profile is built again.)
+    galsim.VonKarman.clear_table()
+    L0 = 101.3
+    vk1 = galsim.VonKarman(lam=600, r0=r0, L0=L0, gsparams=gsp)
+    hlr1 = vk1.half_light_radius
+    assert galsim._galsim.GetVonKarmanTableNBuilt(gsp._gsp) == 4
+    rr = hlr1 * np.array([0, 0.05, 0.3, 1, 2.5])
+    x1 = [vk1.xValue(r,0) for r in rr]
+    galsim.VonKarman.clear_table()
+    galsim.VonKarman(lam=500, r0=r0, L0=L0*1.001, gsparams=gsp).half_light_radius
+    assert galsim._galsim.GetVonKarmanTableNBuilt(gsp._gsp) == 4
+    vk2 = galsim.VonKarman(lam=600, r0=r0, L0=L0, force_stepk=vk1.stepk, gsparams=gsp)
+    assert vk2.half_light_radius == hlr1
+    np.testing.assert_array_equal([vk2.xValue(r,0) for r in rr], x1)
+    assert galsim._galsim.GetVonKarmanTableNBuilt(gsp._gsp) == 4
+
+    # Write the table nodes that were built, and read them back in.  Then the nodes that are
+    # read in are used, rather than building them again.
+    file_name = os.path.join('output', 'vk_table.dat')
+    galsim.VonKarman.write_table(file_name, gsp)
+    galsim.VonKarman.clear_table()
+    galsim.VonKarman.read_table(file_name, gsp)
+    vk3 = galsim.VonKarman(lam=600, r0=r0, L0=L0, force_stepk=0.9*vk1.stepk, gsparams=gsp)
+    assert vk3.half_light_radius == hlr1
+    np.testing.assert_allclose([vk3.xValue(r,0) for r in rr], x1, rtol=1.e-14)
+    assert galsim._galsim.GetVonKarmanTableNBuilt(gsp._gsp) == 0
+
+    # A table built with different GSParams is rejected.
+    with assert_raises(galsim.GalSimError):
+        galsim.VonKarman.read_table(file_name, gsp_direct)
+    # So is a table file from a different version.
+    with open(file_name) as fin:
+        lines = fin.readlines()
+    lines[1] = '# version 0\n'
+    bad_file_name = os.path.join('output', 'vk_table_bad.dat')
+    with open(bad_file_name, 'w') as fout:
+        fout.writelines(lines)
+    with assert_raises(galsim.GalSimError):
+        galsim.VonKarman.read_table(bad_file_name, gsp)
+    with assert_raises(galsim.GalSimError):
+        galsim.VonKarman.read_table(os.path.join('output', 'nonexistent_vk_table.dat'))
+
+
 def vk_benchmark():
     import time
     t0 = time.time()
@@ -2489,6 +2489,68 @@ def test_inverseab_convergence():
         bad = eval(str(e)[str(e).rfind('['):])
         print('as a python list: ',bad)
 
+@timer
+def test_inverse_table():
+    """Test GSFitsWCS.withInverseTable
+    """
+    dir = 'fits_files'
+    rng = np.random.default_rng(1234)
+    bounds = galsim.BoundsI(1, 500, 1, 500)
+    for tag in ['SIP', 'TPV', 'ZTF']:
+        file_name, ref_list = references[tag]
+        wcs = galsim.GSFitsWCS(file_name, dir=dir)
+        # Random points, so in general not at the cell centers where the table is checked.
+        x = rng.uniform(bounds.xmin, bounds.xmax, 5000)
+        y = rng.uniform(bounds.ymin, bounds.ymax, 5000)
+        # Include a few points outside the bounds.
+        x = np.append(x, [-100., 700., 250.])
+        y = np.append(y, [250., 600., -150.])
+        ra, dec = wcs.xyToradec(x, y, units='radians')
+        x1, y1 = wcs.radecToxy(ra, dec, units='radians')
+
+        wcs2 = wcs.withInverseTable(bounds)
+        assert wcs2 is not wcs
+        assert wcs2._ab_table is not None or wcs2._pv_table is not None
+        # The original is unchanged.
+        assert wcs._ab_table is None and wcs._pv_table is None
+        assert wcs2 == wcs
+        x2, y2 = wcs2.radecToxy(ra, dec, units='radians')
+        # The distortions are applied relative to crpix, so that is the relevant scale for
+        # the relative accuracy.
+        dx1 = x1 - wcs.crpix[0]
+        dy1 = y1 - wcs.crpix[1]
+        dx2 = x2 - wcs.crpix[0]
+        dy2 = y2 - wcs.crpix[1]
+        print(tag, 'max diff = ', np.max(np.abs(x2-x1)), np.max(np.abs(y2-y1)))
+        np.testing.assert_allclose(dx2, dx1, rtol=0, atol=1.e-13 * np.max(np.abs(dx1)))
+        np.testing.assert_allclose(dy2, dy1, rtol=0, atol=1.e-13 * np.max(np.abs(dy1)))
+
+        # Scalars work too.
+        x3, y3 = wcs2.radecToxy(ra[0], dec[0], units='radians')
+        assert np.isclose(x3, x1[0], rtol=0, atol=1.e-13 * np.max(np.abs(dx1)))
+        assert np.isclose(y3, y1[0], rtol=0, atol=1.e-13 * np.max(np.abs(dy1)))
+
+    # Points for which the single Newton step does not converge continue with the full
+    # iteration.  Check this with a table that is far too coarse to be accurate.
+    wcs = galsim.GSFitsWCS(references['SIP'][0], dir=dir)
+    u = rng.uniform(-200., 200., 1000)
+    v = rng.uniform(-200., 200., 1000)
+    x1, y1 = wcs._invert_ab(u, v, wcs.ab, abp=wcs.abp)
+    gu, gv = np.meshgrid(np.linspace(-250., 250., 3), np.linspace(-250., 250., 3), indexing='ij')
+    xgrid = np.ascontiguousarray(gu.ravel())
+    ygrid = np.ascontiguousarray(gv.ravel())
+    table = (3, 3, -250., -250., 250., 250., xgrid, ygrid)
+    x2, y2 = wcs._invert_ab(u, v, wcs.ab, abp=wcs.abp, table=table)
+    np.testing.assert_allclose(x2, x1, rtol=0, atol=1.e-13 * np.max(np.abs(x1)))
+    np.testing.assert_allclose(y2, y1, rtol=0, atol=1.e-13 * np.max(np.abs(y1)))
+
+    # Without any distortions, there is nothing to tabulate.
+    wcs = galsim.GSFitsWCS(references['TAN'][0], dir=dir)
+    wcs2 = wcs.withInverseTable(bounds)
+    assert wcs2 == wcs
+    assert wcs2._ab_table is None and wcs2._pv_table is None
+
+
 @timer
 def test_tanwcs():
     """Test the TanWCS function, which returns a GSFitsWCS instance.